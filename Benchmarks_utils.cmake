@@ -129,8 +129,9 @@ macro(print_build_config)
 
 endmacro()
 
-# GLOBALIZER_BENCHMARKS_define_problem(<name> [<USE_CONF> <CUDA> <LINK_LIBS> <libs list> <INCLUDE_DIRS> <dirs list>
+# GLOBALIZER_BENCHMARKS_define_problem(<name> [<USE_CONF> <CUDA> <DYNAMIC> <LINK_LIBS> <libs list> <INCLUDE_DIRS> <dirs list>
 #                         <COMPILE_OPTIONS> <options list>])
+# DYNAMIC keeps the problem a shared library when GLOBALIZER_BENCHMARKS_STATIC_PROBLEMS is ON
 macro(GLOBALIZER_BENCHMARKS_define_problem _name)
 
   set(BUILD_PROBLEM "${_name}_build")
@@ -139,7 +140,7 @@ macro(GLOBALIZER_BENCHMARKS_define_problem _name)
   if(${BUILD_PROBLEM} OR BUILD_ALL_TASK)
   
 	#parse arguments
-	set(options USE_CONF CUDA)
+	set(options USE_CONF CUDA DYNAMIC)
 	set(multiValueArgs INCLUDE_DIRS LINK_LIBS COMPILE_OPTIONS)
 	cmake_parse_arguments(GLOBALIZER_BENCHMARKS_define_problem "${options}" "" "${multiValueArgs}" ${ARGN})
 	
@@ -158,13 +159,25 @@ macro(GLOBALIZER_BENCHMARKS_define_problem _name)
 	file(GLOB SRC_FILES ${CMAKE_CURRENT_SOURCE_DIR}/*.cpp ${CMAKE_CURRENT_SOURCE_DIR}/*.h
 	${CMAKE_CURRENT_SOURCE_DIR}/*.hpp)
 	
+	#in static mode problems are linked into the application and registered by name
+	if(${GLOBALIZER_BENCHMARKS_STATIC_PROBLEMS} AND NOT ${GLOBALIZER_BENCHMARKS_define_problem_DYNAMIC})
+		set(PROBLEM_LIBRARY_TYPE STATIC)
+	else()
+		set(PROBLEM_LIBRARY_TYPE SHARED)
+	endif()
+	
 	if(${GLOBALIZER_BENCHMARKS_define_problem_CUDA})
 		include_directories(${CMAKE_SOURCE_DIR}/cuda_interop)
 		include_directories(${CUDA_INCLUDE_DIRS})
 		file(GLOB CUDA_SRC_FILES ${CMAKE_CURRENT_SOURCE_DIR}/*.cu)
-		cuda_add_library(${PROJECT_NAME_STR} SHARED ${SRC_FILES} ${CUDA_SRC_FILES})
+		cuda_add_library(${PROJECT_NAME_STR} ${PROBLEM_LIBRARY_TYPE} ${SRC_FILES} ${CUDA_SRC_FILES})
 	else()
-		add_library(${PROJECT_NAME_STR} SHARED ${SRC_FILES})
+		add_library(${PROJECT_NAME_STR} ${PROBLEM_LIBRARY_TYPE} ${SRC_FILES})
+	endif()
+	
+	if(PROBLEM_LIBRARY_TYPE STREQUAL "STATIC")
+		target_compile_definitions(${PROJECT_NAME_STR} PRIVATE GLOBALIZER_BENCHMARKS_STATIC_PROBLEM=${PROJECT_NAME_STR})
+		set_property(GLOBAL APPEND PROPERTY GLOBALIZER_BENCHMARKS_STATIC_PROBLEM_TARGETS ${PROJECT_NAME_STR})
 	endif()
 	
 	set_target_properties(${PROJECT_NAME_STR} PROPERTIES
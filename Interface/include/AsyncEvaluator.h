@@ -0,0 +1,226 @@
+﻿/////////////////////////////////////////////////////////////////////////////
+//                                                                         //
+//             LOBACHEVSKY STATE UNIVERSITY OF NIZHNY NOVGOROD             //
+//                                                                         //
+//                       Copyright (c) 2025 by UNN.                        //
+//                          All Rights Reserved.                           //
+//                                                                         //
+//  File:      AsyncEvaluator.h                                            //
+//                                                                         //
+//  Purpose:   Header file for asynchronous evaluator class                //
+//                                                                         //
+//                                                                         //
+//  Author(s): Lebedev I.G.                                                //
+//                                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+\file AsyncEvaluator.h
+
+\authors Лебедев И.Г.
+\date 2025
+\copyright ННГУ им. Н.И. Лобачевского
+
+\brief Объявление классов #TCompletionQueue и #TAsyncEvaluator
+
+*/
+
+#ifndef __ASYNC_EVALUATOR_H__
+#define __ASYNC_EVALUATOR_H__
+
+#include "IGlobalOptimizationProblem.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// Результат асинхронного вычисления
+struct TAsyncResult
+{
+  /// Номер заявки, выданный #TAsyncEvaluator::Submit
+  long long ticket;
+  /** Код ошибки (#TAsyncEvaluator::OK_ или #TAsyncEvaluator::ERROR_)
+
+  Невычислимость отдельных значений не считается ошибкой и отражается в #statuses
+  */
+  int status;
+  /// Номер вычисленной функции, -1 -- вычислены все функции
+  int fNumber;
+  /// Значения функции fNumber (одно значение) или всех функций задачи
+  std::vector<double> values;
+  /// Статусы значений (#IGlobalOptimizationProblem::FUNCTIONAL_OK и др.), по одному на элемент values
+  std::vector<int> statuses;
+  /// Время ожидания в очереди от подачи заявки до начала вычисления, в секундах
+  double queueTime;
+  /// Время вычисления, в секундах
+  double evaluationTime;
+
+  TAsyncResult() : ticket(-1), status(-2), fNumber(-1), queueTime(0.0), evaluationTime(0.0)
+  {}
+};
+
+/**
+Ограниченная неблокирующая очередь завершенных вычислений
+
+Кольцевой буфер с порядковыми номерами ячеек (схема Д. Вьюкова): несколько потоков
+могут одновременно добавлять и извлекать элементы без блокировок.
+*/
+class TCompletionQueue
+{
+protected:
+  /// Ячейка буфера
+  struct TCell
+  {
+    std::atomic<size_t> sequence;
+    TAsyncResult* data;
+  };
+
+  /// Буфер, размер -- степень двойки
+  std::vector<TCell> mBuffer;
+  /// Маска номера ячейки
+  size_t mMask;
+  /// Позиция записи
+  alignas(64) std::atomic<size_t> mEnqueuePosition;
+  /// Позиция чтения
+  alignas(64) std::atomic<size_t> mDequeuePosition;
+
+public:
+  /// Конструктор, емкость округляется вверх до степени двойки
+  TCompletionQueue(size_t capacity);
+
+  /// Добавляет элемент, возвращает false, если очередь заполнена
+  bool Push(TAsyncResult* result);
+  /// Извлекает элемент, возвращает false, если очередь пуста
+  bool Pop(TAsyncResult*& result);
+  /// Емкость очереди
+  size_t GetCapacity() const;
+};
+
+/**
+Класс, вычисляющий функции задачи асинхронно
+
+Точка подается методом #Submit, который сразу возвращает номер заявки. Вычисления выполняет
+пул рабочих потоков, вызывающий блокирующие методы задачи; завершенные результаты попадают
+в #TCompletionQueue и забираются методами #Poll или #WaitAny в порядке завершения.
+Тем самым решатель может выбирать новые точки испытаний, пока медленные вычисления
+(например, задачи на python) еще выполняются.
+
+Повторно входимые задачи (см. #TProblemCapabilities) вычисляются всеми рабочими потоками.
+Для остальных задач каждый дополнительный поток получает собственную копию задачи
+(#IGlobalOptimizationProblem::Clone); если задача не поддерживает копирование, поток один.
+*/
+class TAsyncEvaluator
+{
+protected:
+  /// Заявка на вычисление
+  struct TTask
+  {
+    long long ticket;
+    std::vector<double> y;
+    std::vector<std::string> u;
+    int fNumber;
+    std::chrono::steady_clock::time_point submitTime;
+  };
+
+  /// Задача
+  IGlobalOptimizationProblem* mProblem;
+  /// Копии задачи для рабочих потоков, если задача не допускает параллельных вызовов
+  std::vector<std::unique_ptr<IGlobalOptimizationProblem>> mClones;
+  /// Рабочие потоки
+  std::vector<std::thread> mWorkers;
+  /// Заявки, ожидающие вычисления
+  std::deque<TTask> mTasks;
+  /// Мьютекс очереди заявок
+  std::mutex mTasksMutex;
+  /// Сигнал рабочим потокам о новой заявке или завершении
+  std::condition_variable mTasksCondition;
+  /// Признак завершения работы
+  bool mIsStopped;
+
+  /// Завершенные вычисления
+  TCompletionQueue mCompleted;
+  /// Мьютекс, используемый только для ожидания в #WaitAny
+  std::mutex mWaitMutex;
+  /// Сигнал о завершении вычисления
+  std::condition_variable mWaitCondition;
+
+  /// Наибольшее число одновременно поданных заявок
+  int mCapacity;
+  /// Число поданных, но еще не забранных заявок
+  std::atomic<int> mInFlight;
+  /// Номер следующей заявки
+  std::atomic<long long> mNextTicket;
+
+  /// Цикл рабочего потока, вычисляющего задачу problem
+  void WorkerLoop(IGlobalOptimizationProblem* problem);
+  /// Вычисляет заявку
+  void Evaluate(IGlobalOptimizationProblem* problem, TTask& task, TAsyncResult& result);
+  /** Забирает завершенное вычисление, если оно есть
+
+  isLast принимает значение true, если забрана последняя поданная заявка
+  */
+  bool PopCompleted(TAsyncResult& result, bool& isLast);
+
+public:
+
+  /// Код ошибки, возвращаемый при успешном выполнении операции
+  static const int OK_ = 0;
+  /// Код, возвращаемый, если завершенных вычислений пока нет
+  static const int NOT_READY_ = -1;
+  /// Код ошибки, возвращаемый при неудачном вычислении или неверных параметрах
+  static const int ERROR_ = -2;
+
+  /** Конструктор
+  \param[in] problem инициализированная задача
+  \param[in] numberOfThreads число рабочих потоков, 0 -- по числу ядер
+  \param[in] capacity наибольшее число одновременно поданных заявок
+  */
+  TAsyncEvaluator(IGlobalOptimizationProblem* problem, int numberOfThreads = 0, int capacity = 1024);
+  /// Деструктор дожидается текущих вычислений, невыполненные заявки отбрасываются
+  ~TAsyncEvaluator();
+
+  TAsyncEvaluator(const TAsyncEvaluator&) = delete;
+  TAsyncEvaluator& operator=(const TAsyncEvaluator&) = delete;
+
+  /** Подает точку на вычисление
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u значения дискретных параметров
+  \param[in] uCount число дискретных параметров
+  \param[in] fNumber номер функции, -1 -- вычислить все функции задачи
+  \return номер заявки или -1, если число поданных заявок достигло емкости
+  */
+  long long Submit(const double* y, int yCount, const std::string* u, int uCount, int fNumber);
+
+  /** Забирает любое завершенное вычисление, не блокируя вызывающий поток
+  \param[out] result результат вычисления
+  \return #OK_ или #NOT_READY_
+  */
+  int Poll(TAsyncResult& result);
+
+  /** Ожидает завершения любого из поданных вычислений
+
+  Метод можно вызывать из нескольких потоков: если другой поток забрал последний результат,
+  ожидание завершается с #ERROR_
+  \param[out] result результат вычисления
+  \param[in] timeout наибольшее время ожидания в секундах, отрицательное значение -- без ограничения
+  \return #OK_, #NOT_READY_ по истечении времени или #ERROR_, если поданных заявок нет
+  */
+  int WaitAny(TAsyncResult& result, double timeout = -1.0);
+
+  /// Число поданных, но еще не забранных заявок
+  int GetNumberOfInFlight() const;
+  /// Число рабочих потоков
+  int GetNumberOfThreads() const;
+};
+
+#endif
+// - end of file ----------------------------------------------------------------------------------
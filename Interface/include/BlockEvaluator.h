@@ -0,0 +1,123 @@
+﻿/////////////////////////////////////////////////////////////////////////////
+//                                                                         //
+//             LOBACHEVSKY STATE UNIVERSITY OF NIZHNY NOVGOROD             //
+//                                                                         //
+//                       Copyright (c) 2025 by UNN.                        //
+//                          All Rights Reserved.                           //
+//                                                                         //
+//  File:      BlockEvaluator.h                                            //
+//                                                                         //
+//  Purpose:   Header file for block evaluator class                       //
+//                                                                         //
+//                                                                         //
+//  Author(s): Lebedev I.G.                                                //
+//                                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+\file BlockEvaluator.h
+
+\authors Лебедев И.Г.
+\date 2025
+\copyright ННГУ им. Н.И. Лобачевского
+
+\brief Объявление класса #TBlockEvaluator
+
+*/
+
+#ifndef __BLOCK_EVALUATOR_H__
+#define __BLOCK_EVALUATOR_H__
+
+#include "IGlobalOptimizationProblem.h"
+
+#include <vector>
+
+/**
+Класс, вычисляющий функции задачи с учетом их структуры по переменным
+
+По #IGlobalOptimizationProblem::GetFunctionalStructure строится, какие функции и какие их слагаемые
+зависят от каждой переменной. При изменении части переменных (#Update) функции, от них
+не зависящие, не вычисляются, у разделимых функций пересчитываются только затронутые слагаемые
+(#IGlobalOptimizationProblem::CalculateFunctionalElements), неразделимые вычисляются целиком.
+Значение разделимой функции -- сумма всех ее слагаемых в порядке номеров, поэтому оно не зависит
+от истории изменений.
+
+Используется решателями по блокам переменных на задачах большой размерности.
+Задачи с дискретными переменными не поддерживаются.
+*/
+class TBlockEvaluator
+{
+protected:
+  /// Задача
+  IGlobalOptimizationProblem* mProblem;
+  /// Число непрерывных переменных
+  int mNumberOfVariables;
+  /// Структура каждой функции
+  std::vector<TFunctionalStructure> mStructures;
+  /// Для каждой переменной -- номера функций, зависящих от нее
+  std::vector<std::vector<int>> mVariableFunctionals;
+  /// Для каждой функции и переменной -- номера слагаемых, зависящих от переменной
+  std::vector<std::vector<std::vector<int>>> mVariableBlocks;
+
+  /// Текущая точка
+  std::vector<double> mPoint;
+  /// Слагаемые разделимых функций в текущей точке
+  std::vector<std::vector<double>> mElements;
+  /// Значения функций в текущей точке
+  std::vector<double> mValues;
+  /// Задана ли точка
+  bool mIsPointSet;
+  /// Число слагаемых и неразделимых функций, вычисленных последней операцией
+  int mNumberOfEvaluations;
+
+  /// Номера затронутых функций и слагаемых (рабочие массивы)
+  std::vector<int> mFunctionals;
+  std::vector<int> mBlocks;
+  std::vector<double> mBlockValues;
+
+  /// Проверяет структуру функции и при ошибке заменяет ее неразделимой функцией от всех переменных
+  void CheckStructure(TFunctionalStructure& structure) const;
+  /// Вычисляет значение разделимой функции fNumber как сумму ее слагаемых
+  void SumElements(int fNumber);
+  /// Вычисляет все слагаемые функции fNumber, при ошибке считает функцию неразделимой
+  int EvaluateFunctional(int fNumber);
+
+public:
+
+  /// Код ошибки, возвращаемый при успешном выполнении операции
+  static const int OK_ = 0;
+  /// Код ошибки, возвращаемый при неудачном вычислении или неверных параметрах
+  static const int ERROR_ = -2;
+
+  /** Конструктор
+  \param[in] problem инициализированная задача
+  */
+  TBlockEvaluator(IGlobalOptimizationProblem* problem);
+
+  /** Задает текущую точку и вычисляет в ней все функции
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \return #OK_ или #ERROR_
+  */
+  int SetPoint(const double* y, int yCount);
+
+  /** Изменяет несколько переменных текущей точки и пересчитывает затронутые функции
+  \param[in] variables номера изменяемых переменных
+  \param[in] values новые значения переменных
+  \param[in] count число изменяемых переменных
+  \return #OK_ или #ERROR_, если точка не задана или номер переменной неверен
+  */
+  int Update(const int* variables, const double* values, int count);
+
+  /// Текущая точка
+  const std::vector<double>& GetPoint() const;
+  /// Значения всех функций в текущей точке
+  const std::vector<double>& GetValues() const;
+  /// Структура функции fNumber, используемая вычислителем
+  const TFunctionalStructure& GetStructure(int fNumber) const;
+  /// Число слагаемых и неразделимых функций, вычисленных последним вызовом #SetPoint или #Update
+  int GetNumberOfEvaluations() const;
+};
+
+#endif
+// - end of file ----------------------------------------------------------------------------------
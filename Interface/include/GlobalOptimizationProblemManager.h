@@ -29,7 +29,15 @@
 #define __GLOBAL_OPTIMIZATION_PROBLEM_MANAGER_H__
 
 #include "IGlobalOptimizationProblem.h"
+#include "ProblemKernelTable.h"
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #ifdef WIN32
   #include <direct.h>
@@ -40,32 +48,140 @@
 #endif
 
 /**
-Класс, реализующий загрузку и выгрузку подключамеых библиотек с задачами
+Загруженная библиотека с задачей и найденные в ней функции
 
-В классе #ProblemManager реализованы основные функции, для загрузки\выгрузки библиотек с задачами
+Библиотека выгружается, когда удаляется последний указатель на нее; задачи, созданные
+#GlobalOptimizationProblemManager::CreateProblem, хранят такой указатель, поэтому библиотека
+не выгружается, пока существует хотя бы одна ее задача.
 */
-class GlobalOptimizationProblemManager
+class TProblemLibrary
 {
 protected:
-
-  ///Указатель на дескриптор загруженной библиотеки
+  ///Дескриптор библиотеки
   #ifdef WIN32
-    HINSTANCE mLibHandle;
+    HINSTANCE mHandle;
   #else
-    void *mLibHandle;
+    void *mHandle;
   #endif
-  ///Указатель на созданный объект, описывающий задачу
-  IGlobalOptimizationProblem* mProblem;
+  ///Путь к библиотеке
+  std::string mPath;
+  ///Путь к загруженной копии библиотеки или пустая строка, если загружен сам файл mPath
+  std::string mCopyPath;
+  ///Время изменения файла библиотеки при загрузке, 0 -- задача скомпонована статически
+  long long mModificationTime;
   ///Указатель на функцию-фабрику задач
   createProblem* mCreate;
   ///Указатель на функцию-деструктор задач
   destroyProblem* mDestroy;
+  ///Указатель на необязательную функцию, заполняющую таблицу вычислительных функций
+  getProblemKernelTable* mGetKernelTable;
+
+  TProblemLibrary();
+
+public:
+  /** Метод загружает библиотеку и ищет в ней функции create, destroy и getKernelTable
+
+  Если задача с таким именем или путем скомпонована статически (#TStaticProblemRegistry),
+  библиотека не загружается, а используются функции этой задачи
+  \param[in] libPath путь к библиотеке
+  \param[in] isCopy загрузить копию файла под уникальным именем, чтобы новая версия библиотеки
+  загрузилась рядом со старой, а не вернулся дескриптор уже загруженной
+  \return Указатель на библиотеку или пустой указатель при ошибке, сообщение об ошибке печатается
+  */
+  static std::shared_ptr<TProblemLibrary> Load(const std::string& libPath, bool isCopy = false);
+  ///Деструктор выгружает библиотеку и удаляет ее копию
+  ~TProblemLibrary();
+
+  TProblemLibrary(const TProblemLibrary&) = delete;
+  TProblemLibrary& operator=(const TProblemLibrary&) = delete;
+
+  ///Путь к библиотеке
+  const std::string& GetPath() const;
+  ///Путь к загруженной копии библиотеки или пустая строка
+  const std::string& GetCopyPath() const;
+  ///Время изменения файла библиотеки при загрузке
+  long long GetModificationTime() const;
+  ///Изменился ли файл библиотеки после загрузки (например, библиотека пересобрана)
+  bool IsModified() const;
+  ///Функция-фабрика задач
+  createProblem* GetCreate() const;
+  ///Функция-деструктор задач
+  destroyProblem* GetDestroy() const;
+  ///Функция, заполняющая таблицу вычислительных функций, или NULL
+  getProblemKernelTable* GetKernelTableFunction() const;
+};
+
+/// Задача, созданная функцией create библиотеки; удаляется функцией destroy той же библиотеки
+typedef std::shared_ptr<IGlobalOptimizationProblem> TProblemPtr;
+
+/// Функция, задающая параметры созданной задачи и вызывающая Initialize, возвращает код ошибки задачи
+typedef std::function<int(IGlobalOptimizationProblem*)> TProblemSetup;
+
+/// Время этапов предварительной загрузки одной библиотеки (#GlobalOptimizationProblemManager::Preload)
+struct TPreloadTiming
+{
+  /// Путь к библиотеке
+  std::string libPath;
+  /// Время загрузки библиотеки в секундах
+  double loadTime;
+  /// Время создания задачи функцией create в секундах
+  double createTime;
+  /// Время настройки и инициализации задачи в секундах
+  double initializeTime;
+  /// Инициализируется ли задача в фоновом потоке (задачи со встроенным интерпретатором)
+  bool isBackground;
+  /// Состояние: OK_, ERROR_ или NOT_READY_, пока задача инициализируется в фоне
+  int status;
+
+  TPreloadTiming() : loadTime(0.0), createTime(0.0), initializeTime(0.0), isBackground(false), status(0)
+  {}
+};
+
+/**
+Класс, реализующий загрузку и выгрузку подключамеых библиотек с задачами
 
-  /// Метод, освобождающий загруженную библиотеку. Будет вызван в деструкторе
+В классе #ProblemManager реализованы основные функции, для загрузки\выгрузки библиотек с задачами.
+Загруженные библиотеки кэшируются по пути, поэтому из одной библиотеки можно создать
+любое число задач (#CreateProblem), загрузив ее один раз.
+*/
+class GlobalOptimizationProblemManager
+{
+protected:
+
+  ///Библиотека текущей задачи
+  std::shared_ptr<TProblemLibrary> mLibrary;
+  ///Текущая задача, загруженная #LoadProblemLibrary
+  TProblemPtr mProblem;
+  ///Таблица вычислительных функций задачи
+  TProblemKernelTable mKernelTable;
+  ///Экспортирует ли библиотека таблицу вычислительных функций
+  bool mHasKernelTable;
+  ///Общие данные, передаваемые каждой загружаемой задаче
+  std::map<std::string, TSharedDataPtr> mSharedData;
+  ///Загруженные библиотеки по путям
+  std::map<std::string, std::shared_ptr<TProblemLibrary>> mLibraries;
+  ///Мьютекс кэша библиотек и общих данных
+  mutable std::mutex mLibrariesMutex;
+  ///Задачи, созданные предварительной загрузкой, по путям
+  std::map<std::string, TProblemPtr> mPreloaded;
+  ///Время этапов предварительной загрузки в порядке путей
+  std::vector<TPreloadTiming> mPreloadTimings;
+  ///Мьютекс результатов предварительной загрузки
+  mutable std::mutex mPreloadMutex;
+  ///Условие завершения фоновой инициализации
+  mutable std::condition_variable mPreloadCondition;
+  ///Потоки фоновой инициализации, добавляются под мьютексом mPreloadMutex
+  std::vector<std::thread> mBackgroundThreads;
+  ///Мьютекс, упорядочивающий фоновую инициализацию: запуск интерпретатора не допускает параллельных вызовов
+  std::mutex mBackgroundMutex;
+
+  /// Метод, освобождающий текущую задачу. Будет вызван в деструкторе
   int FreeProblemLibrary();
 
-  ///Служебный метод, освобождающий #mLibHandle
-  void FreeLibHandler();
+  /// Метод возвращает библиотеку из кэша, загружая ее при первом обращении
+  std::shared_ptr<TProblemLibrary> GetLibrary(const std::string& libPath);
+  /// Метод создает задачу из уже загруженной библиотеки library, см. #CreateProblem
+  TProblemPtr CreateProblem(const std::shared_ptr<TProblemLibrary>& library);
 
 public:
 
@@ -79,6 +195,15 @@ public:
   при ошибке во время выполнении операций
   */
   static const int ERROR_ = -2;
+  /// Код, возвращаемый, пока задача предварительной загрузки инициализируется в фоне
+  static const int NOT_READY_ = 1;
+
+  /// Режим вычислений: задача вызывается в вызывающем потоке
+  static const int EXECUTION_INLINE = 0;
+  /// Режим вычислений: вызовы задачи распределяются между потоками текущего процесса
+  static const int EXECUTION_THREADED = 1;
+  /// Режим вычислений: для параллельных вычислений задача загружается в отдельные процессы
+  static const int EXECUTION_OUT_OF_PROCESS = 2;
 
   ///Конструктор
   GlobalOptimizationProblemManager();
@@ -87,17 +212,157 @@ public:
 
   /** Метод, загружающий библиотеку, находящуюся по указанному пути
 
-  Метод загружает библиотеку, пытается импортировать из неё функции,
-  создающие и уничтожающие задачу, а затем создаёт задачу
+  Метод загружает библиотеку (или берет ее из кэша), пытается импортировать из неё функции,
+  создающие и уничтожающие задачу, а затем создаёт текущую задачу, заменяя предыдущую.
+  Если библиотека экспортирует getKernelTable, запрашивается таблица вычислительных функций
 
   \param[in] libPath Путь к загружаемой библиотеке
   \return Код ошибки
   */
   int LoadProblemLibrary(const std::string& libPath);
 
+  /** Метод создает новую задачу из библиотеки
+
+  Библиотека загружается при первом обращении и остается в кэше менеджера. Задаче передаются
+  общие данные (#SetSharedData); задача удаляется функцией destroy своей библиотеки, когда
+  удаляется последний указатель на нее, в том числе после удаления менеджера.
+  Метод можно вызывать из нескольких потоков
+  \param[in] libPath Путь к библиотеке
+  \return Указатель на задачу или пустой указатель при ошибке
+  */
+  TProblemPtr CreateProblem(const std::string& libPath);
+
+  /** Метод выгружает из кэша библиотеки, задач из которых больше нет
+
+  Библиотеки текущей задачи и существующих задач остаются загруженными
+  \return Число выгруженных библиотек
+  */
+  int ReleaseUnusedLibraries();
+
+  /** Метод проверяет, изменился ли файл библиотеки из кэша после ее загрузки
+
+  \param[in] libPath путь к библиотеке
+  \return true, если библиотека загружена и ее файл изменился
+  */
+  bool IsLibraryModified(const std::string& libPath) const;
+
+  /** Метод загружает новую версию библиотеки рядом со старой
+
+  Новая версия заменяет старую в кэше, и задачи, создаваемые после вызова, создаются из нее.
+  Старая версия остается загруженной, пока существуют ее задачи. Статически скомпонованные
+  задачи не перезагружаются
+  \param[in] libPath путь к библиотеке
+  \return Код ошибки
+  */
+  int ReloadLibrary(const std::string& libPath);
+
+  /// Метод возвращает библиотеку из кэша без загрузки или пустой указатель
+  std::shared_ptr<const TProblemLibrary> FindLibrary(const std::string& libPath) const;
+
+  /** Метод предварительно загружает библиотеки и инициализирует по одной задаче из каждой
+
+  Библиотеки загружаются, а задачи создаются и инициализируются параллельно в numberOfThreads
+  потоках. Задачи со встроенным интерпретатором (#TProblemCapabilities::isInterpreterBacked)
+  инициализируются в фоновом потоке по одной, и метод не ждет их: остальные задачи доступны
+  сразу после возврата. Задачи берутся методом #GetPreloadedProblem, время этапов -- #GetPreloadTimings
+  \param[in] libPaths пути к библиотекам
+  \param[in] setup функция настройки задачи, вызывается из разных потоков; пустая -- только Initialize
+  \param[in] numberOfThreads число потоков, 0 -- по числу ядер
+  \return #OK_ или #ERROR_, если какую-то задачу не удалось загрузить или инициализировать
+  */
+  int Preload(const std::vector<std::string>& libPaths, const TProblemSetup& setup = TProblemSetup(),
+    int numberOfThreads = 0);
+
+  /** Метод возвращает задачу, созданную #Preload
+
+  \param[in] libPath путь к библиотеке, переданный в #Preload
+  \param[in] wait ждать ли окончания фоновой инициализации задачи
+  \return Задача или пустой указатель, если ее нет, она не инициализировалась или еще не готова
+  */
+  TProblemPtr GetPreloadedProblem(const std::string& libPath, bool wait = true) const;
+
+  /** Метод ждет окончания фоновой инициализации всех задач #Preload
+
+  \return #OK_ или #ERROR_, если какую-то задачу не удалось загрузить или инициализировать
+  */
+  int WaitPreload() const;
+
+  /// Метод возвращает время этапов предварительной загрузки; фоновые задачи могут быть не готовы
+  std::vector<TPreloadTiming> GetPreloadTimings() const;
+
   /** Метод возвращает указатель #mProblem
   */
   IGlobalOptimizationProblem* GetProblem() const;
+
+  /** Метод передает общие данные загруженной задаче и запоминает их для задач, загружаемых позже
+
+  Данные не копируются: задача и ее копии (#IGlobalOptimizationProblem::Clone) хранят
+  указатель на один буфер. Пустой указатель удаляет запомненные данные
+  \param[in] name имя данных, известное задаче
+  \param[in] data данные
+  \return Код ошибки (#ERROR_, если загруженная задача не приняла данные)
+  */
+  int SetSharedData(const std::string& name, const TSharedDataPtr& data);
+
+  /** Метод возвращает вычислительные свойства загруженной задачи
+
+  \param[out] capabilities свойства задачи
+  \return Код ошибки (#ERROR_, если задача не загружена)
+  */
+  int GetProblemCapabilities(TProblemCapabilities& capabilities) const;
+
+  /** Метод возвращает рекомендуемый режим вычислений для загруженной задачи
+
+  \return #EXECUTION_INLINE, #EXECUTION_THREADED, #EXECUTION_OUT_OF_PROCESS или #ERROR_
+  */
+  int GetRecommendedExecutionMode() const;
+
+  /** Метод выбирает режим вычислений по свойствам задачи
+
+  Повторно входимые задачи вычисляются в потоках, если вычисление функции не слишком дешево.
+  Задачи, сериализующие вызовы внутри себя, можно ускорить только отдельными процессами
+  \param[in] capabilities свойства задачи
+  \return #EXECUTION_INLINE, #EXECUTION_THREADED или #EXECUTION_OUT_OF_PROCESS
+  */
+  static int SelectExecutionMode(const TProblemCapabilities& capabilities);
+
+  /** Метод возвращает таблицу вычислительных функций загруженной задачи
+
+  \return Указатель на таблицу или NULL, если библиотека ее не экспортирует
+  */
+  const TProblemKernelTable* GetKernelTable() const;
+
+  /** Метод вычисляет функцию задачи в точке
+
+  Используется таблица вычислительных функций, если она есть, иначе виртуальный метод задачи.
+  Задача не должна иметь дискретных параметров
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] fNumber номер функции
+  \param[out] value значение функции
+  \return Код ошибки
+  */
+  int CalculateFunction(const double* y, int yCount, int fNumber, double& value);
+
+  /** Метод вычисляет функцию задачи в нескольких точках за один вызов
+
+  \param[in] y массив координат точек, координаты точки i начинаются с y[i * stride]
+  \param[in] numPoints количество точек
+  \param[in] stride расстояние между началами соседних точек, 0 -- плотная упаковка
+  \param[in] fNumber номер функции
+  \param[out] values массив из numPoints элементов для значений функции
+  \return Код ошибки
+  */
+  int CalculateFunctionalsBatch(const double* y, int numPoints, int stride, int fNumber, double* values);
+
+  /** Метод вычисляет все функции задачи в точке
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[out] values массив из GetNumberOfFunctions() элементов для значений функций
+  \return Код ошибки
+  */
+  int CalculateAllFunctionals(const double* y, int yCount, double* values);
 };
 
 int InitGlobalOptimizationProblem(GlobalOptimizationProblemManager& problemManager, IGlobalOptimizationProblem*& problem, std::string libPath);
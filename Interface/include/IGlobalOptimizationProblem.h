@@ -30,13 +30,117 @@
 #define __I_GLOBAL_OPTIMIZATION_PROBLEM_H__
 
 #include <vector>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
 #include <string>
 #include <stdexcept>
 #include <variant>
 
+#include "SharedData.h"
+
+/** Версия интерфейса #IGlobalOptimizationProblem
+
+Увеличивается, когда между выпусками меняется набор виртуальных методов интерфейса. Места методов
+в таблице виртуальных функций назначает компилятор (MSVC, например, размещает перегрузки метода рядом),
+поэтому новый метод может сдвинуть места прежних, а вызов нового метода у задачи из старой библиотеки
+выходит за ее таблицу. Библиотеки задач, собранные с другой версией интерфейса, несовместимы
+с программой и должны быть пересобраны
+*/
+#define GLOBAL_OPTIMIZATION_PROBLEM_INTERFACE_VERSION 2
+
 /// Варианты типов параметров задачи
 using IOptVariantType = std::variant<int, double, std::string>;
 
+/** Функция, получающая промежуточные значения долгого вычисления
+
+Задача вызывает ее в контрольных точках вычисления (блок кросс-валидации, эпоха обучения)
+с номером шага и текущим значением функции. Если функция возвращает true, задача прекращает
+вычисление и возвращает промежуточное значение со статусом
+#IGlobalOptimizationProblem::FUNCTIONAL_PRUNED
+*/
+using TPruningCallback = std::function<bool(int step, double value)>;
+
+/**
+Вычислительные свойства задачи, по которым планировщик вычислений выбирает,
+вызывать ли задачу в текущем потоке, из нескольких потоков или в отдельных процессах.
+
+Значения по умолчанию соответствуют наиболее осторожным предположениям.
+*/
+struct TProblemCapabilities
+{
+  /// Методы вычисления можно вызывать только из одного потока
+  static const int THREAD_UNSAFE = 0;
+  /// Методы вычисления можно вызывать из разных потоков, но внутри они выполняются последовательно
+  static const int THREAD_SERIALIZED = 1;
+  /// Методы вычисления можно параллельно вызывать из разных потоков
+  static const int THREAD_REENTRANT = 2;
+
+  /// Уровень потокобезопасности (#THREAD_UNSAFE, #THREAD_SERIALIZED или #THREAD_REENTRANT)
+  int threadSafety;
+  /// Реализован ли собственный CalculateFunctionalsBatch, а не реализация по умолчанию
+  bool hasNativeBatch;
+  /// Пересчитывает ли UpdateIncrementalState значения за время, не зависящее от размерности
+  bool hasIncrementalEvaluation;
+  /// Возвращают ли повторные вычисления в той же точке те же значения
+  bool isDeterministic;
+  /// Вычисляется ли задача встроенным интерпретатором (python)
+  bool isInterpreterBacked;
+  /// Ожидаемое время вычисления одной функции в секундах, отрицательное значение -- неизвестно
+  double functionCost;
+  /// Предпочтительное число точек в одном вызове CalculateFunctionalsBatch
+  int preferredBatchSize;
+
+  TProblemCapabilities() : threadSafety(THREAD_UNSAFE), hasNativeBatch(false), hasIncrementalEvaluation(false),
+    isDeterministic(true), isInterpreterBacked(false), functionCost(-1.0), preferredBatchSize(1)
+  {}
+};
+
+/**
+Состояние точки для инкрементного вычисления функций задачи
+
+Создается методом #IGlobalOptimizationProblem::InitializeIncrementalState и хранится вызывающей
+стороной, по одному на точку. Поля point и values можно читать; data принадлежит задаче,
+создавшей состояние, и вызывающей стороной не изменяется.
+*/
+struct TIncrementalState
+{
+  /// Текущая точка
+  std::vector<double> point;
+  /// Значения всех функций задачи в текущей точке
+  std::vector<double> values;
+  /// Промежуточные данные задачи (например, суммы по координатам)
+  std::vector<double> data;
+  /// Число изменений координат после последнего полного пересчета
+  int numberOfUpdates;
+
+  TIncrementalState() : numberOfUpdates(0)
+  {}
+};
+
+/**
+Структура зависимости функции задачи от непрерывных переменных
+
+Аддитивно разделимая функция представляется в виде f(x) = constant + sum_k g_k(x[blocks[k]]),
+где слагаемое g_k зависит только от переменных блока blocks[k]. Решатели по блокам переменных
+и методы декомпозиции по этой структуре пересчитывают только слагаемые, затронутые изменением.
+*/
+struct TFunctionalStructure
+{
+  /// Номера переменных, от которых зависит функция, по возрастанию
+  std::vector<int> variables;
+  /// Разделима ли функция аддитивно на слагаемые #blocks
+  bool isSeparable;
+  /// Номера переменных каждого слагаемого (только для разделимых функций)
+  std::vector<std::vector<int>> blocks;
+  /// Постоянное слагаемое (только для разделимых функций)
+  double constant;
+
+  TFunctionalStructure() : isSeparable(false), constant(0.0)
+  {}
+};
+
 /**
 Базовый класс-интерфейс, от которого наследуются классы, описывающие задачи оптимизации.
 
@@ -60,6 +164,15 @@ public:
   /// Код ошибки, возвращаемый, если попытались получить значения для недискретного параметра
   static const int ERROR_DISCRETE_VALUE = -201;
 
+  /// Статус значения функции: значение вычислено
+  static const int FUNCTIONAL_OK = 0;
+  /// Статус значения функции: точка вне области, где функция вычислима
+  static const int FUNCTIONAL_NOT_COMPUTABLE = 1;
+  /// Статус значения функции: при вычислении произошла ошибка
+  static const int FUNCTIONAL_ERROR = 2;
+  /// Статус значения функции: вычисление прервано по запросу #TPruningCallback, значение промежуточное
+  static const int FUNCTIONAL_PRUNED = 3;
+
   /** Метод, вычисляющий функции задачи
 
   \param[in] y непрерывные координаты точки, в которой необходимо вычислить значение
@@ -70,6 +183,19 @@ public:
   */
   virtual double CalculateFunctionals(const std::vector<double>& y, std::vector<std::string>& u, int fNumber);
 
+  /** Метод, вычисляющий функции задачи, без создания временных векторов
+
+  Реализация по умолчанию копирует координаты в векторы и вызывает
+  #CalculateFunctionals(const std::vector<double>&, std::vector<std::string>&, int)
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки, может быть nullptr при uCount == 0
+  \param[in] uCount число дискретных координат
+  \param[in] fNumber Номер вычисляемой функции
+  \return Значение функции с указанным номером
+  */
+  virtual double CalculateFunctionals(const double* y, int yCount, const std::string* u, int uCount, int fNumber);
+
   /** Метод задаёт размерность задачи
 
   Данный метод должен вызываться перед #Initialize. Размерность должна быть в
@@ -158,6 +284,200 @@ public:
   virtual void CalculateFunctionals(std::vector<std::vector<double>>& y, std::vector<std::vector<std::string>>& u, 
     int fNumber, int& numPoints, std::vector<double>& values);
 
+  /** Метод, вычисляющий функцию задачи сразу в нескольких точках
+
+  Точки передаются единым блоком памяти по строкам: непрерывные координаты точки
+  с номером i начинаются с y[i * stride]. Дискретные параметры не передаются, метод
+  предназначен для задач без дискретных переменных. Реализация по умолчанию
+  последовательно вызывает #CalculateFunctionals для каждой точки.
+  \param[in] y массив непрерывных координат точек
+  \param[in] numPoints количество точек
+  \param[in] stride расстояние (в числах double) между началами соседних точек,
+  0 означает плотную упаковку с шагом #GetNumberOfContinuousVariable()
+  \param[in] fNumber Номер вычисляемой функции
+  \param[out] values массив из numPoints элементов, в который будут записаны значения функции
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int CalculateFunctionalsBatch(const double* y, int numPoints, int stride, int fNumber, double* values);
+
+  /** Метод, вычисляющий функцию задачи сразу в нескольких точках в одинарной точности
+
+  Предназначен для грубого просмотра области (построение ландшафта, отсев точек), где точность
+  double не нужна. Задачи, реализующие метод, документируют оценку отклонения от #CalculateFunctionalsBatch.
+  Реализация по умолчанию преобразует точки в double, вызывает #CalculateFunctionalsBatch
+  и округляет результат, поэтому не дает выигрыша в скорости.
+  \param[in] y массив непрерывных координат точек
+  \param[in] numPoints количество точек
+  \param[in] stride расстояние (в числах float) между началами соседних точек,
+  0 означает плотную упаковку с шагом #GetNumberOfContinuousVariable()
+  \param[in] fNumber Номер вычисляемой функции
+  \param[out] values массив из numPoints элементов для значений функции
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int CalculateFunctionalsBatchFloat(const float* y, int numPoints, int stride, int fNumber, float* values);
+
+  /** Метод, вычисляющий функцию задачи с возвратом статуса вместо исключения
+
+  Невычислимость функции в точке -- штатная ситуация, о которой сообщается статусом
+  #FUNCTIONAL_NOT_COMPUTABLE без исключений и значений-заглушек. Реализация по умолчанию
+  вызывает #CalculateFunctionals, исключение переводит в #FUNCTIONAL_ERROR,
+  а бесконечное значение, NaN или максимальное значение double -- в #FUNCTIONAL_NOT_COMPUTABLE.
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки, может быть nullptr при uCount == 0
+  \param[in] uCount число дискретных координат
+  \param[in] fNumber Номер вычисляемой функции
+  \param[out] value значение функции, при статусе, отличном от #FUNCTIONAL_OK, не определено
+  \return Статус значения (#FUNCTIONAL_OK, #FUNCTIONAL_NOT_COMPUTABLE или #FUNCTIONAL_ERROR)
+  */
+  virtual int TryCalculateFunctionals(const double* y, int yCount, const std::string* u, int uCount, int fNumber,
+    double& value);
+
+  /** Метод, вычисляющий все функции задачи со статусом для каждой функции
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки, может быть nullptr при uCount == 0
+  \param[in] uCount число дискретных координат
+  \param[out] values массив из #GetNumberOfFunctions() элементов для значений функций
+  \param[out] statuses массив из #GetNumberOfFunctions() элементов для статусов значений
+  \return Код ошибки (#PROBLEM_OK, если статусы заполнены, или #PROBLEM_ERROR)
+  */
+  virtual int TryCalculateAllFunctionals(const double* y, int yCount, const std::string* u, int uCount,
+    double* values, int* statuses);
+
+  /** Метод, вычисляющий функцию задачи в нескольких точках со статусом для каждой точки
+
+  Точки передаются так же, как в #CalculateFunctionalsBatch. Точка, в которой функция
+  не вычислима или вычисляется с ошибкой, не прерывает пакет: ее статус записывается
+  в statuses, остальные точки вычисляются. Реализация по умолчанию для задач с собственным
+  пакетным вычислением (#TProblemCapabilities::hasNativeBatch) вызывает #CalculateFunctionalsBatch
+  и проверяет значения, а если пакет прерван исключением, как и для остальных задач,
+  вычисляет точки по одной через #TryCalculateFunctionals.
+  \param[in] y массив непрерывных координат точек
+  \param[in] numPoints количество точек
+  \param[in] stride расстояние (в числах double) между началами соседних точек,
+  0 означает плотную упаковку с шагом #GetNumberOfContinuousVariable()
+  \param[in] fNumber Номер вычисляемой функции
+  \param[out] values массив из numPoints элементов для значений функции
+  \param[out] statuses массив из numPoints элементов для статусов значений
+  \return Код ошибки (#PROBLEM_OK, если статусы заполнены, или #PROBLEM_ERROR при неверных параметрах)
+  */
+  virtual int TryCalculateFunctionalsBatch(const double* y, int numPoints, int stride, int fNumber,
+    double* values, int* statuses);
+
+  /** Метод возвращает уровни точности вычисления функций задачи
+
+  Уровни нумеруются от самого дешевого; последний уровень -- полное вычисление, совпадающее
+  с #CalculateFunctionals. Для дорогих задач (обучение моделей) младшие уровни соответствуют
+  обучению на части выборки или меньшему числу блоков кросс-валидации или эпох и дают
+  приближенное значение, пригодное для отсева точек. Реализация по умолчанию
+  возвращает единственный уровень полного вычисления.
+  \param[out] costs стоимость вычисления на каждом уровне относительно полного вычисления
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_UNDEFINED, если уровни задачей не описаны)
+  */
+  virtual int GetFidelityLevels(std::vector<double>& costs) const;
+
+  /** Метод, вычисляющий функцию задачи с заданным уровнем точности
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки, может быть nullptr при uCount == 0
+  \param[in] uCount число дискретных координат
+  \param[in] fNumber Номер вычисляемой функции
+  \param[in] fidelity уровень точности (см. #GetFidelityLevels), -1 -- полное вычисление
+  \param[out] value значение функции
+  \return Статус значения (#FUNCTIONAL_OK, #FUNCTIONAL_NOT_COMPUTABLE или #FUNCTIONAL_ERROR,
+  в том числе при неверном уровне точности)
+  */
+  virtual int TryCalculateFunctionalsAtFidelity(const double* y, int yCount, const std::string* u, int uCount,
+    int fNumber, int fidelity, double& value);
+
+  /** Метод задает функцию, решающую по промежуточным значениям, прервать ли вычисление
+
+  Функция вызывается из потока, вычисляющего задачу, во время вызовов Try* методов; прерванное
+  вычисление возвращает статус #FUNCTIONAL_PRUNED. Методы без статусов вычисляют функции полностью.
+  Копии задачи (#Clone) получают ту же функцию, поэтому она может вызываться из нескольких потоков.
+  Реализация по умолчанию прерывание не поддерживает.
+  \param[in] callback функция прерывания, пустая функция отключает прерывание
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_UNDEFINED, если задача не сообщает промежуточных значений)
+  */
+  virtual int SetPruningCallback(const TPruningCallback& callback);
+
+  /** Метод, начинающий инкрементное вычисление функций задачи в точке y
+
+  Вычисляет все функции задачи и сохраняет в state данные, по которым #UpdateIncrementalState
+  пересчитывает значения при изменении одной координаты. Метод предназначен для задач
+  без дискретных переменных. Реализация по умолчанию вызывает #CalculateAllFunctionals.
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[out] state состояние точки
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int InitializeIncrementalState(const double* y, int yCount, TIncrementalState& state);
+
+  /** Метод, изменяющий одну координату точки и пересчитывающий значения всех функций
+
+  Задачи, функции которых -- суммы по координатам, пересчитывают значения за время,
+  не зависящее от размерности (#TProblemCapabilities::hasIncrementalEvaluation); чтобы
+  ошибки округления не накапливались, суммы периодически пересчитываются заново.
+  Реализация по умолчанию вычисляет все функции в новой точке полностью.
+  \param[in,out] state состояние точки, созданное #InitializeIncrementalState этой задачи
+  \param[in] coordinate номер изменяемой координаты
+  \param[in] value новое значение координаты
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int UpdateIncrementalState(TIncrementalState& state, int coordinate, double value);
+
+  /** Метод, вычисляющий значение и градиент функции задачи за один проход
+
+  Градиент вычисляется по непрерывным координатам. В точках, где функция не
+  дифференцируема (например, |x| в нуле), возвращается один из субградиентов.
+  Реализация по умолчанию сообщает, что градиент не поддерживается.
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] fNumber Номер вычисляемой функции
+  \param[out] value значение функции
+  \param[out] gradient массив из #GetNumberOfContinuousVariable() элементов для градиента
+  \return Код ошибки (#PROBLEM_OK, #PROBLEM_UNDEFINED, если градиент не поддерживается,
+  или #PROBLEM_ERROR)
+  */
+  virtual int CalculateFunctionalGradient(const double* y, int yCount, int fNumber, double& value, double* gradient);
+
+  /** Метод, вычисляющий значения и градиенты функции задачи сразу в нескольких точках
+
+  Точки передаются так же, как в #CalculateFunctionalsBatch. Градиенты записываются плотно:
+  градиент точки i начинается с gradients[i * #GetNumberOfContinuousVariable()].
+  Реализация по умолчанию последовательно вызывает #CalculateFunctionalGradient.
+  \param[in] y массив непрерывных координат точек
+  \param[in] numPoints количество точек
+  \param[in] stride расстояние между началами соседних точек, 0 -- плотная упаковка
+  \param[in] fNumber Номер вычисляемой функции
+  \param[out] values массив из numPoints элементов для значений функции
+  \param[out] gradients массив из numPoints * #GetNumberOfContinuousVariable() элементов для градиентов
+  \return Код ошибки (#PROBLEM_OK, #PROBLEM_UNDEFINED или #PROBLEM_ERROR)
+  */
+  virtual int CalculateFunctionalGradientBatch(const double* y, int numPoints, int stride, int fNumber,
+    double* values, double* gradients);
+
+  /** Метод, вычисляющий гарантированную оценку значений функции на параллелепипеде
+
+  Для любой точки y из параллелепипеда lower <= y <= upper значение функции с номером
+  fNumber лежит в отрезке [fLower, fUpper] с учетом ошибок округления. Оценка позволяет
+  отбрасывать подобласти без вычисления функции в точках. Реализация по умолчанию
+  сообщает, что оценка не поддерживается.
+  \param[in] lower нижние границы параллелепипеда по непрерывным координатам
+  \param[in] upper верхние границы параллелепипеда по непрерывным координатам
+  \param[in] yCount число непрерывных координат
+  \param[in] fNumber Номер функции
+  \param[out] fLower нижняя оценка значений функции
+  \param[out] fUpper верхняя оценка значений функции
+  \return Код ошибки (#PROBLEM_OK, #PROBLEM_UNDEFINED, если оценка не поддерживается,
+  или #PROBLEM_ERROR)
+  */
+  virtual int CalculateFunctionalBounds(const double* lower, const double* upper, int yCount, int fNumber,
+    double& fLower, double& fUpper);
+
   /** Метод, вычисляющий все функции задачи
 
   \param[in] y непрерывные координаты точки, в которой необходимо вычислить значение
@@ -166,6 +486,126 @@ public:
   */
   virtual std::vector<double> CalculateAllFunctionals(const std::vector<double>& y, std::vector<std::string>& u);
 
+  /** Метод, вычисляющий все функции задачи в буфер вызывающей стороны
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки, может быть nullptr при uCount == 0
+  \param[in] uCount число дискретных координат
+  \param[out] values массив из #GetNumberOfFunctions() элементов для значений функций
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int CalculateAllFunctionals(const double* y, int yCount, const std::string* u, int uCount, double* values);
+
+  /** Метод, последовательно вычисляющий функции задачи с номерами 0..lastIndex
+
+  Вычисления прекращаются на первом нарушенном ограничении (значение больше нуля),
+  как это делает индексный метод. Значения функций с номерами больше возвращаемого
+  не вычисляются и не изменяются.
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки, может быть nullptr при uCount == 0
+  \param[in] uCount число дискретных координат
+  \param[in] lastIndex номер последней функции, которую нужно вычислить
+  \param[out] values массив не менее чем из lastIndex + 1 элементов для значений функций
+  \return Номер последней вычисленной функции (индекс точки) или #PROBLEM_ERROR
+  */
+  virtual int CalculateFunctionalsUpTo(const double* y, int yCount, const std::string* u, int uCount,
+    int lastIndex, double* values);
+
+  /** Метод возвращает вычислительные свойства задачи
+
+  Можно вызывать после #Initialize. Реализация по умолчанию возвращает осторожные значения
+  \param[out] capabilities свойства задачи
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_UNDEFINED, если свойства задачей не описаны)
+  */
+  virtual int GetCapabilities(TProblemCapabilities& capabilities) const;
+
+  /** Метод возвращает известную верхнюю оценку константы Липшица функции в области #GetBounds
+
+  Константа задается в евклидовой норме по непрерывным координатам:
+  |f(x) - f(y)| <= L * ||x - y||. Можно вызывать после #Initialize.
+  Для задач без известной оценки используется #TLipschitzEstimator.
+  \param[in] fNumber Номер функции
+  \param[out] constant оценка константы Липшица
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_UNDEFINED, если оценка неизвестна)
+  */
+  virtual int GetLipschitzConstant(int fNumber, double& constant) const;
+
+  /** Метод возвращает структуру зависимости функции от непрерывных переменных
+
+  Можно вызывать после #Initialize. Реализация по умолчанию описывает функцию
+  как неразделимую и зависящую от всех переменных
+  \param[in] fNumber Номер функции
+  \param[out] structure структура функции
+  \return Код ошибки (#PROBLEM_OK, #PROBLEM_UNDEFINED, если структура задачей не описана,
+  или #PROBLEM_ERROR при неверном номере функции)
+  */
+  virtual int GetFunctionalStructure(int fNumber, TFunctionalStructure& structure) const;
+
+  /** Метод, вычисляющий отдельные слагаемые аддитивно разделимой функции
+
+  Номера слагаемых соответствуют #TFunctionalStructure::blocks. Значение функции равно
+  сумме #TFunctionalStructure::constant и всех ее слагаемых.
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] fNumber Номер функции
+  \param[in] blocks номера вычисляемых слагаемых
+  \param[in] count число вычисляемых слагаемых
+  \param[out] elements массив из count элементов для значений слагаемых
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR, если функция неразделима)
+  */
+  virtual int CalculateFunctionalElements(const double* y, int yCount, int fNumber, const int* blocks, int count,
+    double* elements);
+
+  /** Метод создает независимую копию задачи
+
+  Копия инициализирована, имеет те же параметры и не разделяет с исходной задачей изменяемого состояния,
+  поэтому задачи, не допускающие параллельных вызовов, можно вычислять в нескольких потоках,
+  выделив каждому потоку свою копию. Копия удаляется оператором delete.
+  \return Указатель на копию или nullptr, если задача не поддерживает копирование
+  */
+  virtual IGlobalOptimizationProblem* Clone() const;
+
+  /** Метод возвращает число задач в семействе, которое описывает объект
+
+  Параметризованные семейства (например, функции X2, различающиеся номером) хранят общие данные
+  один раз, а номер задачи выбирается методом #SelectInstance. Задачи без семейства возвращают 1.
+  Можно вызывать после #Initialize
+  \return Число задач семейства
+  */
+  virtual int GetNumberOfInstances() const;
+
+  /** Метод делает текущей задачу семейства с номером index
+
+  Выбор не выделяет память и не повторяет инициализацию, поэтому один объект может
+  последовательно вычислять все задачи семейства. Размерность и границы области поиска не меняются
+  \param[in] index номер задачи от 0 до #GetNumberOfInstances() - 1
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR при неверном номере)
+  */
+  virtual int SelectInstance(int index);
+
+  /// Метод возвращает номер текущей задачи семейства
+  virtual int GetSelectedInstance() const;
+
+  /** Метод, вычисляющий функцию нескольких задач семейства в одних и тех же точках
+
+  Результат -- блок numInstances x numPoints по строкам: значение задачи instances[m]
+  в точке i записывается в values[m * numPoints + i]. Реализация по умолчанию по очереди выбирает
+  задачи (#SelectInstance) и вызывает #CalculateFunctionalsBatch; текущая задача после вызова
+  не меняется
+  \param[in] instances номера задач семейства
+  \param[in] numInstances количество задач
+  \param[in] y массив непрерывных координат точек, координаты точки i начинаются с y[i * stride]
+  \param[in] numPoints количество точек
+  \param[in] stride расстояние между началами соседних точек, 0 -- плотная упаковка
+  \param[in] fNumber Номер вычисляемой функции
+  \param[out] values массив из numInstances * numPoints элементов для значений
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR, в том числе при неверном номере задачи)
+  */
+  virtual int CalculateInstancesBatch(const int* instances, int numInstances, const double* y, int numPoints,
+    int stride, int fNumber, double* values);
+
   /// Метод возвращает число дискретных параметров, дискретные параметры всегда последние в векторе y
   virtual int GetNumberOfDiscreteVariable() const;
 
@@ -181,6 +621,48 @@ public:
   */
   virtual int GetDiscreteVariableValues(std::vector< std::vector<std::string>>& values) const;
 
+  /** Метод преобразует строковые значения дискретных параметров в их номера
+
+  Номер значения -- это его позиция в таблице #GetDiscreteVariableValues, которая
+  фиксируется при вызове #Initialize и далее не меняется
+  \param[in] u строковые значения дискретных параметров
+  \param[in] count число дискретных параметров
+  \param[out] indices массив из count элементов для номеров значений
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR, если значение не найдено)
+  */
+  virtual int GetDiscreteValueIndices(const std::string* u, int count, int* indices) const;
+
+  /** Метод преобразует номера значений дискретных параметров в строковые значения,
+  используется только для вывода результатов
+  \param[in] indices номера значений дискретных параметров
+  \param[in] count число дискретных параметров
+  \param[out] u строковые значения дискретных параметров
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR, если номер вне допустимого диапазона)
+  */
+  virtual int GetDiscreteValueLabels(const int* indices, int count, std::vector<std::string>& u) const;
+
+  /** Метод, вычисляющий функции задачи, дискретные параметры которой заданы номерами значений
+
+  Реализация по умолчанию восстанавливает строковые значения через #GetDiscreteValueLabels
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u номера значений дискретных параметров в таблице #GetDiscreteVariableValues
+  \param[in] uCount число дискретных параметров
+  \param[in] fNumber Номер вычисляемой функции
+  \return Значение функции с указанным номером
+  */
+  virtual double CalculateFunctionalsByIndex(const double* y, int yCount, const int* u, int uCount, int fNumber);
+
+  /** Метод, вычисляющий все функции задачи, дискретные параметры которой заданы номерами значений
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u номера значений дискретных параметров в таблице #GetDiscreteVariableValues
+  \param[in] uCount число дискретных параметров
+  \param[out] values массив из #GetNumberOfFunctions() элементов для значений функций
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int CalculateAllFunctionalsByIndex(const double* y, int yCount, const int* u, int uCount, double* values);
+
   /** Метод возвращает число непрерывных переменных
   \return Число непрерывных переменных
   */
@@ -207,6 +689,18 @@ public:
   */
   virtual int SetParameter(std::string name, void* value);
 
+  /** Метод передает задаче общие неизменяемые данные
+
+  Задача хранит копию указателя, а не копию данных, поэтому один буфер (обучающая выборка,
+  таблица коэффициентов) используется всеми экземплярами задачи, включая копии #Clone.
+  Вызывается до или после #Initialize, в зависимости от задачи.
+  \param[in] name имя данных, известное задаче
+  \param[in] data данные
+  \return Код ошибки (#PROBLEM_OK, #PROBLEM_ERROR при неверной форме данных
+  или #PROBLEM_UNDEFINED, если задача не использует данные с таким именем)
+  */
+  virtual int SetSharedData(const std::string& name, const TSharedDataPtr& data);
+
   /** Метод возвращает параметры задачи
   \param[out] names имена параметраметров 
   \param[out] values значениея параметров
@@ -250,6 +744,15 @@ inline double IGlobalOptimizationProblem::CalculateFunctionals(const std::vector
     + std::string(__FUNCTION__));
 }
 
+// ------------------------------------------------------------------------------------------------
+inline double IGlobalOptimizationProblem::CalculateFunctionals(const double* y, int yCount,
+  const std::string* u, int uCount, int fNumber)
+{
+  std::vector<double> point(y, y + yCount);
+  std::vector<std::string> discretePoint(u, u + uCount);
+  return CalculateFunctionals(point, discretePoint, fNumber);
+}
+
 // ------------------------------------------------------------------------------------------------
 inline void IGlobalOptimizationProblem::CalculateFunctionals(std::vector<std::vector<double>>& y, std::vector<std::vector<std::string>>& u,
   int fNumber, int& numPoints, std::vector<double>& values)
@@ -258,6 +761,204 @@ inline void IGlobalOptimizationProblem::CalculateFunctionals(std::vector<std::ve
     + std::string(__FUNCTION__));
 }
 
+// ------------------------------------------------------------------------------------------------
+inline int IGlobalOptimizationProblem::CalculateFunctionalsBatch(const double* y, int numPoints, int stride,
+  int fNumber, double* values)
+{
+  int n = GetNumberOfContinuousVariable();
+  if (stride == 0)
+    stride = n;
+  if (stride < n || numPoints < 0)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  std::vector<double> point(n);
+  std::vector<std::string> u;
+  for (int i = 0; i < numPoints; i++)
+  {
+    std::copy(y + (size_t)i * stride, y + (size_t)i * stride + n, point.begin());
+    values[i] = CalculateFunctionals(point, u, fNumber);
+  }
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline int IGlobalOptimizationProblem::CalculateFunctionalsBatchFloat(const float* y, int numPoints, int stride,
+  int fNumber, float* values)
+{
+  int n = GetNumberOfContinuousVariable();
+  if (stride == 0)
+    stride = n;
+  if (stride < n || numPoints < 0)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  // точки преобразуются порциями, чтобы не выделять память под весь пакет
+  const int blockSize = 256;
+  std::vector<double> points((size_t)blockSize * n);
+  std::vector<double> blockValues(blockSize);
+  for (int first = 0; first < numPoints; first += blockSize)
+  {
+    int count = std::min(blockSize, numPoints - first);
+    for (int i = 0; i < count; i++)
+      for (int j = 0; j < n; j++)
+        points[(size_t)i * n + j] = y[(size_t)(first + i) * stride + j];
+    int status = CalculateFunctionalsBatch(points.data(), count, n, fNumber, blockValues.data());
+    if (status != IGlobalOptimizationProblem::PROBLEM_OK)
+      return status;
+    for (int i = 0; i < count; i++)
+      values[first + i] = (float)blockValues[i];
+  }
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline int IGlobalOptimizationProblem::TryCalculateFunctionals(const double* y, int yCount,
+  const std::string* u, int uCount, int fNumber, double& value)
+{
+  try
+  {
+    value = CalculateFunctionals(y, yCount, u, uCount, fNumber);
+  }
+  catch (...)
+  {
+    return IGlobalOptimizationProblem::FUNCTIONAL_ERROR;
+  }
+  // задачи, не сообщающие статус, отмечают невычислимые точки максимальным значением double
+  if (!std::isfinite(value) || std::fabs(value) == std::numeric_limits<double>::max())
+    return IGlobalOptimizationProblem::FUNCTIONAL_NOT_COMPUTABLE;
+  return IGlobalOptimizationProblem::FUNCTIONAL_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline int IGlobalOptimizationProblem::TryCalculateAllFunctionals(const double* y, int yCount,
+  const std::string* u, int uCount, double* values, int* statuses)
+{
+  int numberOfFunctions = GetNumberOfFunctions();
+  for (int i = 0; i < numberOfFunctions; i++)
+    statuses[i] = TryCalculateFunctionals(y, yCount, u, uCount, i, values[i]);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline int IGlobalOptimizationProblem::TryCalculateFunctionalsBatch(const double* y, int numPoints, int stride,
+  int fNumber, double* values, int* statuses)
+{
+  int n = GetNumberOfContinuousVariable();
+  if (stride == 0)
+    stride = n;
+  if (stride < n || numPoints < 0)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  TProblemCapabilities capabilities;
+  GetCapabilities(capabilities);
+  bool isBatchComputed = false;
+  if (capabilities.hasNativeBatch)
+  {
+    try
+    {
+      isBatchComputed = CalculateFunctionalsBatch(y, numPoints, stride, fNumber, values) ==
+        IGlobalOptimizationProblem::PROBLEM_OK;
+    }
+    catch (...)
+    {
+    }
+  }
+
+  for (int i = 0; i < numPoints; i++)
+  {
+    if (!isBatchComputed)
+      statuses[i] = TryCalculateFunctionals(y + (size_t)i * stride, n, nullptr, 0, fNumber, values[i]);
+    else if (!std::isfinite(values[i]) || std::fabs(values[i]) == std::numeric_limits<double>::max())
+      statuses[i] = IGlobalOptimizationProblem::FUNCTIONAL_NOT_COMPUTABLE;
+    else
+      statuses[i] = IGlobalOptimizationProblem::FUNCTIONAL_OK;
+  }
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline int IGlobalOptimizationProblem::GetFidelityLevels(std::vector<double>& costs) const
+{
+  costs.assign(1, 1.0);
+  return IGlobalOptimizationProblem::PROBLEM_UNDEFINED;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline int IGlobalOptimizationProblem::TryCalculateFunctionalsAtFidelity(const double* y, int yCount,
+  const std::string* u, int uCount, int fNumber, int fidelity, double& value)
+{
+  std::vector<double> costs;
+  GetFidelityLevels(costs);
+  // младшие уровни должна вычислять сама задача
+  if (fidelity != -1 && fidelity != (int)costs.size() - 1)
+    return IGlobalOptimizationProblem::FUNCTIONAL_ERROR;
+  return TryCalculateFunctionals(y, yCount, u, uCount, fNumber, value);
+}
+
+// ------------------------------------------------------------------------------------------------
+inline int IGlobalOptimizationProblem::SetPruningCallback(const TPruningCallback& callback)
+{
+  return IGlobalOptimizationProblem::PROBLEM_UNDEFINED;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline int IGlobalOptimizationProblem::InitializeIncrementalState(const double* y, int yCount,
+  TIncrementalState& state)
+{
+  if (yCount < GetNumberOfContinuousVariable())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  state.point.assign(y, y + GetNumberOfContinuousVariable());
+  state.values.resize(GetNumberOfFunctions());
+  state.data.clear();
+  state.numberOfUpdates = 0;
+  return CalculateAllFunctionals(state.point.data(), (int)state.point.size(), nullptr, 0, state.values.data());
+}
+
+// ------------------------------------------------------------------------------------------------
+inline int IGlobalOptimizationProblem::UpdateIncrementalState(TIncrementalState& state, int coordinate,
+  double value)
+{
+  if (coordinate < 0 || coordinate >= (int)state.point.size() || (int)state.values.size() != GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  state.point[coordinate] = value;
+  state.numberOfUpdates++;
+  return CalculateAllFunctionals(state.point.data(), (int)state.point.size(), nullptr, 0, state.values.data());
+}
+
+// ------------------------------------------------------------------------------------------------
+inline int IGlobalOptimizationProblem::CalculateFunctionalGradient(const double* y, int yCount, int fNumber,
+  double& value, double* gradient)
+{
+  return IGlobalOptimizationProblem::PROBLEM_UNDEFINED;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline int IGlobalOptimizationProblem::CalculateFunctionalGradientBatch(const double* y, int numPoints, int stride,
+  int fNumber, double* values, double* gradients)
+{
+  int n = GetNumberOfContinuousVariable();
+  if (stride == 0)
+    stride = n;
+  if (stride < n || numPoints < 0)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  for (int i = 0; i < numPoints; i++)
+  {
+    int code = CalculateFunctionalGradient(y + (size_t)i * stride, n, fNumber, values[i], gradients + (size_t)i * n);
+    if (code != IGlobalOptimizationProblem::PROBLEM_OK)
+      return code;
+  }
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline int IGlobalOptimizationProblem::CalculateFunctionalBounds(const double* lower, const double* upper, int yCount,
+  int fNumber, double& fLower, double& fUpper)
+{
+  return IGlobalOptimizationProblem::PROBLEM_UNDEFINED;
+}
+
 // ------------------------------------------------------------------------------------------------
 inline std::vector<double> IGlobalOptimizationProblem::CalculateAllFunctionals(const std::vector<double>& y, std::vector<std::string>& u)
 {
@@ -265,6 +966,109 @@ inline std::vector<double> IGlobalOptimizationProblem::CalculateAllFunctionals(c
     + std::string(__FUNCTION__));
 }
 
+// ------------------------------------------------------------------------------------------------
+inline int IGlobalOptimizationProblem::CalculateAllFunctionals(const double* y, int yCount,
+  const std::string* u, int uCount, double* values)
+{
+  int numberOfFunctions = GetNumberOfFunctions();
+  for (int i = 0; i < numberOfFunctions; i++)
+    values[i] = CalculateFunctionals(y, yCount, u, uCount, i);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline int IGlobalOptimizationProblem::CalculateFunctionalsUpTo(const double* y, int yCount,
+  const std::string* u, int uCount, int lastIndex, double* values)
+{
+  if (lastIndex < 0 || lastIndex >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  int numberOfConstraints = GetNumberOfConstraints();
+  for (int i = 0; i <= lastIndex; i++)
+  {
+    values[i] = CalculateFunctionals(y, yCount, u, uCount, i);
+    if (i < numberOfConstraints && values[i] > 0)
+      return i;
+  }
+  return lastIndex;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline int IGlobalOptimizationProblem::GetCapabilities(TProblemCapabilities& capabilities) const
+{
+  capabilities = TProblemCapabilities();
+  return IGlobalOptimizationProblem::PROBLEM_UNDEFINED;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline int IGlobalOptimizationProblem::GetLipschitzConstant(int fNumber, double& constant) const
+{
+  return IGlobalOptimizationProblem::PROBLEM_UNDEFINED;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline int IGlobalOptimizationProblem::GetFunctionalStructure(int fNumber, TFunctionalStructure& structure) const
+{
+  if (fNumber < 0 || fNumber >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  structure = TFunctionalStructure();
+  structure.variables.resize(GetNumberOfContinuousVariable());
+  for (int j = 0; j < (int)structure.variables.size(); j++)
+    structure.variables[j] = j;
+  return IGlobalOptimizationProblem::PROBLEM_UNDEFINED;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline int IGlobalOptimizationProblem::CalculateFunctionalElements(const double* y, int yCount, int fNumber,
+  const int* blocks, int count, double* elements)
+{
+  return IGlobalOptimizationProblem::PROBLEM_ERROR;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline IGlobalOptimizationProblem* IGlobalOptimizationProblem::Clone() const
+{
+  return nullptr;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline int IGlobalOptimizationProblem::GetNumberOfInstances() const
+{
+  return 1;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline int IGlobalOptimizationProblem::SelectInstance(int index)
+{
+  return index == 0 ? IGlobalOptimizationProblem::PROBLEM_OK : IGlobalOptimizationProblem::PROBLEM_ERROR;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline int IGlobalOptimizationProblem::GetSelectedInstance() const
+{
+  return 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline int IGlobalOptimizationProblem::CalculateInstancesBatch(const int* instances, int numInstances,
+  const double* y, int numPoints, int stride, int fNumber, double* values)
+{
+  if (numInstances < 0 || numPoints < 0)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  int selected = GetSelectedInstance();
+  int result = IGlobalOptimizationProblem::PROBLEM_OK;
+  for (int m = 0; m < numInstances && result == IGlobalOptimizationProblem::PROBLEM_OK; m++)
+  {
+    result = SelectInstance(instances[m]);
+    if (result == IGlobalOptimizationProblem::PROBLEM_OK)
+      result = CalculateFunctionalsBatch(y, numPoints, stride, fNumber, values + (size_t)m * numPoints);
+  }
+  SelectInstance(selected);
+  return result;
+}
+
 // ------------------------------------------------------------------------------------------------
 inline int IGlobalOptimizationProblem::GetNumberOfDiscreteVariable() const
 {
@@ -290,6 +1094,64 @@ inline int IGlobalOptimizationProblem::GetDiscreteVariableValues(std::vector< st
   return IGlobalOptimizationProblem::PROBLEM_UNDEFINED;
 }
 
+// ------------------------------------------------------------------------------------------------
+inline int IGlobalOptimizationProblem::GetDiscreteValueIndices(const std::string* u, int count, int* indices) const
+{
+  std::vector< std::vector<std::string>> values;
+  if (count > 0 && GetDiscreteVariableValues(values) != IGlobalOptimizationProblem::PROBLEM_OK)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+  if (count > (int)values.size())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  for (int i = 0; i < count; i++)
+  {
+    auto it = std::find(values[i].begin(), values[i].end(), u[i]);
+    if (it == values[i].end())
+      return IGlobalOptimizationProblem::PROBLEM_ERROR;
+    indices[i] = (int)(it - values[i].begin());
+  }
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline int IGlobalOptimizationProblem::GetDiscreteValueLabels(const int* indices, int count, std::vector<std::string>& u) const
+{
+  std::vector< std::vector<std::string>> values;
+  if (count > 0 && GetDiscreteVariableValues(values) != IGlobalOptimizationProblem::PROBLEM_OK)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+  if (count > (int)values.size())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  u.resize(count);
+  for (int i = 0; i < count; i++)
+  {
+    if (indices[i] < 0 || indices[i] >= (int)values[i].size())
+      return IGlobalOptimizationProblem::PROBLEM_ERROR;
+    u[i] = values[i][indices[i]];
+  }
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline double IGlobalOptimizationProblem::CalculateFunctionalsByIndex(const double* y, int yCount,
+  const int* u, int uCount, int fNumber)
+{
+  std::vector<std::string> labels;
+  if (GetDiscreteValueLabels(u, uCount, labels) != IGlobalOptimizationProblem::PROBLEM_OK)
+    throw std::out_of_range("Discrete value index is out of range");
+  return CalculateFunctionals(y, yCount, labels.data(), uCount, fNumber);
+}
+
+// ------------------------------------------------------------------------------------------------
+inline int IGlobalOptimizationProblem::CalculateAllFunctionalsByIndex(const double* y, int yCount,
+  const int* u, int uCount, double* values)
+{
+  std::vector<std::string> labels;
+  if (GetDiscreteValueLabels(u, uCount, labels) != IGlobalOptimizationProblem::PROBLEM_OK)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+  return CalculateAllFunctionals(y, yCount, labels.data(), uCount, values);
+}
+
 // ------------------------------------------------------------------------------------------------
 inline int IGlobalOptimizationProblem::SetParameter(std::string name, std::string value)
 {
@@ -308,6 +1170,12 @@ inline int IGlobalOptimizationProblem::SetParameter(std::string name, void* valu
   return IGlobalOptimizationProblem::PROBLEM_UNDEFINED;
 }
 
+// ------------------------------------------------------------------------------------------------
+inline int IGlobalOptimizationProblem::SetSharedData(const std::string& name, const TSharedDataPtr& data)
+{
+  return IGlobalOptimizationProblem::PROBLEM_UNDEFINED;
+}
+
 // ------------------------------------------------------------------------------------------------
 inline void IGlobalOptimizationProblem::GetParameters(std::vector<std::string>& names, std::vector<std::string>& values)
 {
@@ -329,5 +1197,19 @@ typedef void destroyProblem(IGlobalOptimizationProblem*);
 #define LIB_EXPORT_API
 #endif
 
+/**
+Имя функции, экспортируемой библиотекой с задачей
+
+При статической сборке задач (см. StaticProblemRegistry.h) к имени добавляется префикс
+с именем задачи, чтобы функции разных задач не конфликтовали при компоновке
+*/
+#ifdef GLOBALIZER_BENCHMARKS_STATIC_PROBLEM
+#define PROBLEM_EXPORT_NAME_(problem, function) problem##_##function
+#define PROBLEM_EXPORT_NAME__(problem, function) PROBLEM_EXPORT_NAME_(problem, function)
+#define PROBLEM_EXPORT_NAME(function) PROBLEM_EXPORT_NAME__(GLOBALIZER_BENCHMARKS_STATIC_PROBLEM, function)
+#else
+#define PROBLEM_EXPORT_NAME(function) function
+#endif
+
 #endif
 // - end of file ----------------------------------------------------------------------------------
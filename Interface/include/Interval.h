@@ -0,0 +1,279 @@
+﻿/////////////////////////////////////////////////////////////////////////////
+//                                                                         //
+//             LOBACHEVSKY STATE UNIVERSITY OF NIZHNY NOVGOROD             //
+//                                                                         //
+//                       Copyright (c) 2025 by UNN.                        //
+//                          All Rights Reserved.                           //
+//                                                                         //
+//  File:      Interval.h                                                  //
+//                                                                         //
+//  Purpose:   Header file for interval arithmetic                         //
+//                                                                         //
+//                                                                         //
+//  Author(s): Lebedev I.G.                                                //
+//                                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+\file Interval.h
+
+\authors Лебедев И.Г.
+\date 2025
+\copyright ННГУ им. Н.И. Лобачевского
+
+\brief Объявление класса #TInterval и элементарных функций от интервалов
+
+\details Все операции выполняют внешнее округление: границы результата сдвигаются
+наружу на несколько единиц последнего разряда, поэтому полученный интервал
+гарантированно содержит все значения функции на исходных интервалах
+с учетом ошибок округления. Файл не требует компиляции и может подключаться
+в библиотеки с задачами.
+*/
+
+#ifndef __INTERVAL_H__
+#define __INTERVAL_H__
+
+// задачи используют M_PI, поэтому математические константы включаются до первого подключения cmath
+#ifndef _USE_MATH_DEFINES
+#define _USE_MATH_DEFINES
+#endif
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+/// Интервал [lower, upper] вещественной прямой
+class TInterval
+{
+public:
+  /// Нижняя граница
+  double lower;
+  /// Верхняя граница
+  double upper;
+
+  TInterval() : lower(0.0), upper(0.0) {}
+  /// Интервал из одной точки
+  TInterval(double value) : lower(value), upper(value) {}
+  TInterval(double lowerBound, double upperBound) : lower(lowerBound), upper(upperBound) {}
+
+  /** Создает интервал, расширенный наружу на ulps единиц последнего разряда с каждой стороны
+
+  Используется для учета ошибок округления вычисленных границ
+  */
+  static TInterval Outward(double lowerBound, double upperBound, int ulps = 1)
+  {
+    for (int i = 0; i < ulps; i++)
+    {
+      lowerBound = std::nextafter(lowerBound, -std::numeric_limits<double>::infinity());
+      upperBound = std::nextafter(upperBound, std::numeric_limits<double>::infinity());
+    }
+    return TInterval(lowerBound, upperBound);
+  }
+
+  /// Содержит ли интервал точку value
+  bool Contains(double value) const
+  {
+    return lower <= value && value <= upper;
+  }
+};
+
+/// Число единиц последнего разряда, на которое расширяются результаты функций стандартной библиотеки
+const int INTERVAL_LIBM_ULPS = 4;
+
+// ------------------------------------------------------------------------------------------------
+inline TInterval operator+(const TInterval& a, const TInterval& b)
+{
+  return TInterval::Outward(a.lower + b.lower, a.upper + b.upper);
+}
+
+// ------------------------------------------------------------------------------------------------
+inline TInterval operator-(const TInterval& a)
+{
+  return TInterval(-a.upper, -a.lower);
+}
+
+// ------------------------------------------------------------------------------------------------
+inline TInterval operator-(const TInterval& a, const TInterval& b)
+{
+  return TInterval::Outward(a.lower - b.upper, a.upper - b.lower);
+}
+
+// ------------------------------------------------------------------------------------------------
+inline TInterval operator*(const TInterval& a, const TInterval& b)
+{
+  double p1 = a.lower * b.lower;
+  double p2 = a.lower * b.upper;
+  double p3 = a.upper * b.lower;
+  double p4 = a.upper * b.upper;
+  return TInterval::Outward(std::min(std::min(p1, p2), std::min(p3, p4)),
+    std::max(std::max(p1, p2), std::max(p3, p4)));
+}
+
+// ------------------------------------------------------------------------------------------------
+/// Деление; интервал b не должен содержать ноль
+inline TInterval operator/(const TInterval& a, const TInterval& b)
+{
+  double q1 = a.lower / b.lower;
+  double q2 = a.lower / b.upper;
+  double q3 = a.upper / b.lower;
+  double q4 = a.upper / b.upper;
+  return TInterval::Outward(std::min(std::min(q1, q2), std::min(q3, q4)),
+    std::max(std::max(q1, q2), std::max(q3, q4)));
+}
+
+// ------------------------------------------------------------------------------------------------
+/// Квадрат интервала, в отличие от x * x учитывает зависимость сомножителей
+inline TInterval Sqr(const TInterval& x)
+{
+  double l = x.lower * x.lower;
+  double u = x.upper * x.upper;
+  if (x.Contains(0.0))
+    return TInterval(0.0, std::nextafter(std::max(l, u), std::numeric_limits<double>::infinity()));
+  TInterval r = TInterval::Outward(std::min(l, u), std::max(l, u));
+  r.lower = std::max(r.lower, 0.0);
+  return r;
+}
+
+// ------------------------------------------------------------------------------------------------
+/// Целая степень интервала
+inline TInterval Pow(const TInterval& x, int n)
+{
+  double l = std::pow(x.lower, n);
+  double u = std::pow(x.upper, n);
+  if (n % 2 == 0 && x.Contains(0.0))
+    return TInterval(0.0, TInterval::Outward(0.0, std::max(l, u), INTERVAL_LIBM_ULPS).upper);
+  TInterval r = TInterval::Outward(std::min(l, u), std::max(l, u), INTERVAL_LIBM_ULPS);
+  if (n % 2 == 0)
+    r.lower = std::max(r.lower, 0.0);
+  return r;
+}
+
+// ------------------------------------------------------------------------------------------------
+/// Вещественная степень p > 0 неотрицательного интервала
+inline TInterval Pow(const TInterval& x, double p)
+{
+  TInterval r = TInterval::Outward(std::pow(std::max(x.lower, 0.0), p), std::pow(x.upper, p), INTERVAL_LIBM_ULPS);
+  r.lower = std::max(r.lower, 0.0);
+  return r;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline TInterval Abs(const TInterval& x)
+{
+  if (x.lower >= 0)
+    return x;
+  if (x.upper <= 0)
+    return -x;
+  return TInterval(0.0, std::max(-x.lower, x.upper));
+}
+
+// ------------------------------------------------------------------------------------------------
+inline TInterval Exp(const TInterval& x)
+{
+  TInterval r = TInterval::Outward(std::exp(x.lower), std::exp(x.upper), INTERVAL_LIBM_ULPS);
+  r.lower = std::max(r.lower, 0.0);
+  return r;
+}
+
+// ------------------------------------------------------------------------------------------------
+/// Натуральный логарифм; интервал x должен быть положительным
+inline TInterval Log(const TInterval& x)
+{
+  return TInterval::Outward(std::log(x.lower), std::log(x.upper), INTERVAL_LIBM_ULPS);
+}
+
+// ------------------------------------------------------------------------------------------------
+inline TInterval Sqrt(const TInterval& x)
+{
+  TInterval r = TInterval::Outward(std::sqrt(std::max(x.lower, 0.0)), std::sqrt(x.upper));
+  r.lower = std::max(r.lower, 0.0);
+  return r;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline TInterval Tanh(const TInterval& x)
+{
+  TInterval r = TInterval::Outward(std::tanh(x.lower), std::tanh(x.upper), INTERVAL_LIBM_ULPS);
+  r.lower = std::max(r.lower, -1.0);
+  r.upper = std::min(r.upper, 1.0);
+  return r;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline TInterval Sinh(const TInterval& x)
+{
+  return TInterval::Outward(std::sinh(x.lower), std::sinh(x.upper), INTERVAL_LIBM_ULPS);
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Периодическая функция с экстремумами в точках maxPhase + 2 * pi * k (значение 1)
+и maxPhase + pi + 2 * pi * k (значение -1)
+*/
+template <class TFunction>
+inline TInterval PeriodicUnitRange(const TInterval& x, double maxPhase, TFunction f)
+{
+  const double pi = 3.14159265358979323846;
+  const double twoPi = 2.0 * pi;
+  if (!(x.upper - x.lower < twoPi))
+    return TInterval(-1.0, 1.0);
+
+  double fl = f(x.lower);
+  double fu = f(x.upper);
+  TInterval r = TInterval::Outward(std::min(fl, fu), std::max(fl, fu), INTERVAL_LIBM_ULPS);
+
+  // допуск на ошибку вычисления точек экстремума; лишнее расширение не нарушает гарантию
+  double eps = 1e-12 * (1.0 + std::max(std::fabs(x.lower), std::fabs(x.upper)));
+  double k = std::ceil((x.lower - maxPhase - eps) / twoPi);
+  if (maxPhase + k * twoPi <= x.upper + eps)
+    r.upper = 1.0;
+  k = std::ceil((x.lower - maxPhase - pi - eps) / twoPi);
+  if (maxPhase + pi + k * twoPi <= x.upper + eps)
+    r.lower = -1.0;
+
+  r.lower = std::max(r.lower, -1.0);
+  r.upper = std::min(r.upper, 1.0);
+  return r;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline TInterval Cos(const TInterval& x)
+{
+  return PeriodicUnitRange(x, 0.0, [](double v) { return std::cos(v); });
+}
+
+// ------------------------------------------------------------------------------------------------
+inline TInterval Sin(const TInterval& x)
+{
+  return PeriodicUnitRange(x, 3.14159265358979323846 / 2.0, [](double v) { return std::sin(v); });
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Точная область значений квадратного трехчлена c + a * x + b * x^2 на интервале x
+
+В отличие от интервальной формулы c + a * x + b * Sqr(x) не переоценивает результат
+*/
+inline TInterval Quadratic(const TInterval& x, double a, double b, double c = 0.0)
+{
+  auto q = [a, b, c](double v) { return c + a * v + b * v * v; };
+  // оценка ошибки округления значения q(v) по модулю слагаемых
+  auto error = [a, b, c](double v)
+  {
+    return 4.0 * std::numeric_limits<double>::epsilon() * (std::fabs(c) + std::fabs(a * v) + std::fabs(b * v * v));
+  };
+  double ql = q(x.lower) - error(x.lower);
+  double qu = q(x.upper) - error(x.upper);
+  double l = std::min(ql, qu);
+  double u = std::max(q(x.lower) + error(x.lower), q(x.upper) + error(x.upper));
+  if (b != 0.0)
+  {
+    double vertex = -a / (2.0 * b);
+    if (x.Contains(vertex))
+    {
+      l = std::min(l, q(vertex) - error(vertex));
+      u = std::max(u, q(vertex) + error(vertex));
+    }
+  }
+  return TInterval::Outward(l, u);
+}
+
+#endif
+// - end of file ----------------------------------------------------------------------------------
@@ -0,0 +1,119 @@
+﻿/////////////////////////////////////////////////////////////////////////////
+//                                                                         //
+//             LOBACHEVSKY STATE UNIVERSITY OF NIZHNY NOVGOROD             //
+//                                                                         //
+//                       Copyright (c) 2025 by UNN.                        //
+//                          All Rights Reserved.                           //
+//                                                                         //
+//  File:      LipschitzEstimator.h                                        //
+//                                                                         //
+//  Purpose:   Header file for Lipschitz constant estimator class          //
+//                                                                         //
+//                                                                         //
+//  Author(s): Lebedev I.G.                                                //
+//                                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+\file LipschitzEstimator.h
+
+\authors Лебедев И.Г.
+\date 2025
+\copyright ННГУ им. Н.И. Лобачевского
+
+\brief Объявление класса #TLipschitzEstimator
+
+*/
+
+#ifndef __LIPSCHITZ_ESTIMATOR_H__
+#define __LIPSCHITZ_ESTIMATOR_H__
+
+#include "IGlobalOptimizationProblem.h"
+
+#include <map>
+#include <mutex>
+#include <string>
+
+/**
+Класс, оценивающий константу Липшица функций задачи
+
+Если задача сообщает оценку через #IGlobalOptimizationProblem::GetLipschitzConstant,
+возвращается она. Иначе область поиска покрывается случайными парами близких точек,
+которые вычисляются через #IGlobalOptimizationProblem::CalculateFunctionalsBatch
+в нескольких потоках, и в качестве оценки берется наибольшая разностная производная.
+Такая оценка является нижней оценкой истинной константы, поэтому решатель должен
+умножать ее на параметр надежности.
+
+Результаты хранятся в общем для процесса кэше по ключу (тип задачи, размерность, номер задачи
+семейства, параметры задачи, номер функции, настройки оценки). Общие данные задачи
+(#IGlobalOptimizationProblem::SetSharedData) в ключ не входят, так как интерфейс задачи не позволяет
+их получить: после передачи задаче других данных кэш нужно очистить (#ClearCache).
+*/
+class TLipschitzEstimator
+{
+protected:
+  /// Число потоков, 0 -- по числу ядер
+  int mNumberOfThreads;
+  /// Число пар точек
+  int mNumberOfPoints;
+  /// Шаг между точками пары относительно размера области по каждой координате
+  double mStep;
+  /// Начальное значение генератора случайных чисел
+  unsigned int mSeed;
+
+  /// Кэш оценок
+  static std::map<std::string, double>& Cache();
+  /// Мьютекс кэша
+  static std::mutex& CacheMutex();
+
+  /// Строит ключ кэша для функции fNumber задачи problem с настройками этого объекта
+  std::string MakeKey(IGlobalOptimizationProblem* problem, int fNumber) const;
+
+  /** Вычисляет наибольшую разностную производную на части пар точек
+
+  \param[in] problem задача
+  \param[in] fNumber номер функции
+  \param[in] lower нижние границы области
+  \param[in] upper верхние границы области
+  \param[in] numberOfPairs число пар точек
+  \param[in] batchSize число пар точек в одном вызове #IGlobalOptimizationProblem::CalculateFunctionalsBatch
+  \param[in] seed начальное значение генератора
+  \return наибольшая разностная производная или -1, если ни одна пара не вычислена
+  */
+  double SampleSlopes(IGlobalOptimizationProblem* problem, int fNumber, const std::vector<double>& lower,
+    const std::vector<double>& upper, int numberOfPairs, int batchSize, unsigned int seed) const;
+
+public:
+
+  /// Код ошибки, возвращаемый при успешной оценке
+  static const int OK_ = 0;
+  /// Код ошибки, возвращаемый, если оценку получить не удалось
+  static const int ERROR_ = -2;
+
+  /** Конструктор
+  \param[in] numberOfThreads число потоков, 0 -- по числу ядер
+  \param[in] numberOfPoints число пар точек
+  \param[in] step шаг между точками пары относительно размера области
+  \param[in] seed начальное значение генератора случайных чисел
+  */
+  TLipschitzEstimator(int numberOfThreads = 0, int numberOfPoints = 10000, double step = 1e-4,
+    unsigned int seed = 0);
+
+  /** Метод оценивает константу Липшица функции задачи
+
+  Задача должна быть инициализирована и не иметь дискретных параметров.
+  Задачи, не допускающие параллельных вызовов (см. #TProblemCapabilities), вычисляются в каждом потоке
+  через свою копию (#IGlobalOptimizationProblem::Clone), а без поддержки копирования -- в одном потоке
+  \param[in] problem задача
+  \param[in] fNumber номер функции
+  \param[out] constant оценка константы Липшица
+  \return Код ошибки (#OK_ или #ERROR_)
+  */
+  int Estimate(IGlobalOptimizationProblem* problem, int fNumber, double& constant) const;
+
+  /// Очищает кэш оценок, вызывается после изменения общих данных задачи
+  static void ClearCache();
+};
+
+#endif
+// - end of file ----------------------------------------------------------------------------------
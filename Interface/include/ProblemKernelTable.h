@@ -0,0 +1,163 @@
+﻿/////////////////////////////////////////////////////////////////////////////
+//                                                                         //
+//             LOBACHEVSKY STATE UNIVERSITY OF NIZHNY NOVGOROD             //
+//                                                                         //
+//                       Copyright (c) 2025 by UNN.                        //
+//                          All Rights Reserved.                           //
+//                                                                         //
+//  File:      ProblemKernelTable.h                                        //
+//                                                                         //
+//  Purpose:   Header file for plain C problem kernel table                //
+//                                                                         //
+//                                                                         //
+//  Author(s): Lebedev I.G.                                                //
+//                                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+\file ProblemKernelTable.h
+
+\authors Лебедев И.Г.
+\date 2025
+\copyright ННГУ им. Н.И. Лобачевского
+
+\brief Объявление таблицы вычислительных функций задачи #TProblemKernelTable
+
+\details Помимо функций create и destroy библиотека с задачей может экспортировать функцию
+getKernelTable (см. #getProblemKernelTable), заполняющую таблицу указателей на обычные функции C,
+которые вычисляют задачу по массивам без виртуальных вызовов. Внутри библиотеки тип задачи известен,
+поэтому такие функции встраивают вычисление целиком, и в пакетном режиме на весь пакет приходится
+один косвенный вызов.
+
+Таблица версионируется: вызывающая сторона передает поддерживаемую версию, библиотека заполняет
+поля не новее этой версии и записывает в #TProblemKernelTable::version фактическую версию.
+Новые поля добавляются только в конец структуры.
+*/
+
+#ifndef __PROBLEM_KERNEL_TABLE_H__
+#define __PROBLEM_KERNEL_TABLE_H__
+
+/// Текущая версия таблицы вычислительных функций
+#define PROBLEM_KERNEL_TABLE_VERSION 1
+
+/// Код, возвращаемый функциями таблицы при успешном вычислении
+#define PROBLEM_KERNEL_OK 0
+/// Код, возвращаемый функциями таблицы при ошибке
+#define PROBLEM_KERNEL_ERROR -2
+
+/** Вычисляет функцию fNumber в точке y
+\return #PROBLEM_KERNEL_OK или #PROBLEM_KERNEL_ERROR
+*/
+typedef int (*TKernelFunction)(void* state, const double* y, int yCount, int fNumber, double* value);
+/** Вычисляет функцию fNumber в numPoints точках, точка i начинается с y[i * stride], 0 -- плотная упаковка
+\return #PROBLEM_KERNEL_OK или #PROBLEM_KERNEL_ERROR
+*/
+typedef int (*TKernelBatch)(void* state, const double* y, int numPoints, int stride, int fNumber, double* values);
+/** Вычисляет все функции задачи в точке y
+\return #PROBLEM_KERNEL_OK или #PROBLEM_KERNEL_ERROR
+*/
+typedef int (*TKernelAllFunctions)(void* state, const double* y, int yCount, double* values);
+
+/// Таблица вычислительных функций задачи
+struct TProblemKernelTable
+{
+  /// Версия заполненной таблицы
+  int version;
+  /// Непрозрачное состояние, передаваемое первым аргументом во все функции таблицы
+  void* state;
+  /// Вычисление одной функции в одной точке
+  TKernelFunction calculateFunction;
+  /// Вычисление одной функции в нескольких точках
+  TKernelBatch calculateBatch;
+  /// Вычисление всех функций в одной точке
+  TKernelAllFunctions calculateAllFunctions;
+};
+
+/** Тип функции getKernelTable, которую может экспортировать библиотека с задачей
+
+Таблица действительна, пока существует задача problem, созданная функцией create той же библиотеки.
+Функции таблицы не вычисляют дискретные параметры и используются только для задач без них
+\param[in] problem задача, созданная функцией create
+\param[in] version наибольшая версия таблицы, поддерживаемая вызывающей стороной
+\param[out] table заполняемая таблица
+\return #PROBLEM_KERNEL_OK или #PROBLEM_KERNEL_ERROR, если версия не поддерживается
+*/
+typedef int getProblemKernelTable(void* problem, int version, struct TProblemKernelTable* table);
+
+#ifdef __cplusplus
+
+#include "IGlobalOptimizationProblem.h"
+
+/**
+Функции таблицы для задачи типа TProblem
+
+Методы задачи вызываются с явным указанием класса, поэтому вызовы не виртуальные
+и компилятор может встроить их в функции таблицы. Исключения не выходят за границу C.
+Метод CalculateFunctionals задач не проверяет число координат, поэтому его проверяет функция таблицы.
+*/
+template <class TProblem>
+struct TProblemKernels
+{
+  static int CalculateFunction(void* state, const double* y, int yCount, int fNumber, double* value)
+  {
+    TProblem* problem = static_cast<TProblem*>(state);
+    if (yCount < problem->TProblem::GetDimension())
+      return PROBLEM_KERNEL_ERROR;
+    try
+    {
+      *value = problem->TProblem::CalculateFunctionals(y, yCount, nullptr, 0, fNumber);
+      return PROBLEM_KERNEL_OK;
+    }
+    catch (...)
+    {
+      return PROBLEM_KERNEL_ERROR;
+    }
+  }
+
+  static int CalculateBatch(void* state, const double* y, int numPoints, int stride, int fNumber, double* values)
+  {
+    try
+    {
+      if (static_cast<TProblem*>(state)->TProblem::CalculateFunctionalsBatch(y, numPoints, stride, fNumber, values)
+        == IGlobalOptimizationProblem::PROBLEM_OK)
+        return PROBLEM_KERNEL_OK;
+    }
+    catch (...)
+    {
+    }
+    return PROBLEM_KERNEL_ERROR;
+  }
+
+  static int CalculateAllFunctions(void* state, const double* y, int yCount, double* values)
+  {
+    try
+    {
+      if (static_cast<TProblem*>(state)->TProblem::CalculateAllFunctionals(y, yCount, nullptr, 0, values)
+        == IGlobalOptimizationProblem::PROBLEM_OK)
+        return PROBLEM_KERNEL_OK;
+    }
+    catch (...)
+    {
+    }
+    return PROBLEM_KERNEL_ERROR;
+  }
+
+  /// Заполняет таблицу для задачи, созданной функцией create библиотеки
+  static int Fill(void* problem, int version, TProblemKernelTable* table)
+  {
+    if (!problem || !table || version < 1)
+      return PROBLEM_KERNEL_ERROR;
+
+    table->version = 1;
+    table->state = static_cast<TProblem*>(static_cast<IGlobalOptimizationProblem*>(problem));
+    table->calculateFunction = &TProblemKernels::CalculateFunction;
+    table->calculateBatch = &TProblemKernels::CalculateBatch;
+    table->calculateAllFunctions = &TProblemKernels::CalculateAllFunctions;
+    return PROBLEM_KERNEL_OK;
+  }
+};
+
+#endif
+
+#endif
+// - end of file ----------------------------------------------------------------------------------
@@ -0,0 +1,204 @@
+﻿/////////////////////////////////////////////////////////////////////////////
+//                                                                         //
+//             LOBACHEVSKY STATE UNIVERSITY OF NIZHNY NOVGOROD             //
+//                                                                         //
+//                       Copyright (c) 2025 by UNN.                        //
+//                          All Rights Reserved.                           //
+//                                                                         //
+//  File:      ProblemRegistry.h                                           //
+//                                                                         //
+//  Purpose:   Header file for concurrent problem registry class           //
+//                                                                         //
+//                                                                         //
+//  Author(s): Lebedev I.G.                                                //
+//                                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+\file ProblemRegistry.h
+
+\authors Лебедев И.Г.
+\date 2025
+\copyright ННГУ им. Н.И. Лобачевского
+
+\brief Объявление класса #TProblemRegistry
+
+*/
+
+#ifndef __PROBLEM_REGISTRY_H__
+#define __PROBLEM_REGISTRY_H__
+
+#include "GlobalOptimizationProblemManager.h"
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+Реестр одновременно существующих задач, доступных по имени или номеру
+
+Реестр хранит неизменяемый снимок таблицы задач. Поиск (#Find, #Get) свободен от блокировок:
+читатель отмечается в счетчике текущей эпохи и читает снимок по атомарному указателю, не захватывая
+мьютексов и не ожидая других потоков.
+Изменения копируют таблицу и подменяют снимок под мьютексом, затем переключают эпоху и удаляют
+старый снимок, когда из него выйдут все читатели предыдущей эпохи. Создание и инициализация
+задачи выполняются до захвата мьютекса, поэтому несколько задач могут создаваться одновременно.
+
+Задачи отдаются как #TProblemPtr: удаленная из реестра задача существует, пока ее используют.
+Можно ли вызывать одну задачу из нескольких потоков, определяют ее свойства (#TProblemCapabilities).
+
+Задачи, созданные #Create, можно перезагрузить из пересобранной библиотеки (#Reload): новая
+версия подменяет старую под тем же именем и номером, поэтому данные, связанные с именем задачи,
+сохраняются. Новые вычисления сразу получают новую версию, а начатые завершаются на старой.
+*/
+class TProblemRegistry
+{
+public:
+  /// Номер задачи в реестре, 0 -- нет задачи
+  typedef long long THandle;
+  /// Функция, настраивающая и инициализирующая созданную задачу, возвращает код ошибки задачи
+  typedef TProblemSetup TSetup;
+
+  /// Код ошибки, возвращаемый при успешном выполнении операции
+  static const int OK_ = 0;
+  /// Код ошибки, возвращаемый, если задачи нет или имя уже занято
+  static const int ERROR_ = -2;
+  /// Код, возвращаемый #Reload, если библиотека задачи не изменилась
+  static const int NOT_MODIFIED_ = 1;
+
+protected:
+  /// Запись реестра
+  struct TEntry
+  {
+    std::string name;
+    TProblemPtr problem;
+    /// Путь к библиотеке и функция настройки задачи, созданной #Create; пустой путь -- задача добавлена #Register
+    std::string libPath;
+    TProblemSetup setup;
+    /// Версия библиотеки, из которой создана задача
+    std::shared_ptr<const TProblemLibrary> library;
+  };
+
+  /// Снимок таблицы задач
+  struct TSnapshot
+  {
+    std::map<std::string, THandle> handles;
+    std::unordered_map<THandle, TEntry> entries;
+  };
+
+  /// Чтение снимка: пока объект существует, снимок, полученный #Get, не удаляется
+  class TReader
+  {
+  protected:
+    const TProblemRegistry& mRegistry;
+    /// Счетчик читателей эпохи, в которой начато чтение
+    std::atomic<long long>* mReaders;
+  public:
+    TReader(const TProblemRegistry& registry);
+    ~TReader();
+    TReader(const TReader&) = delete;
+    TReader& operator=(const TReader&) = delete;
+    const TSnapshot* Get() const;
+  };
+
+  /// Менеджер, из библиотек которого создаются задачи
+  GlobalOptimizationProblemManager mManager;
+  /// Текущий снимок, подменяется только под мьютексом mWriteMutex
+  std::atomic<const TSnapshot*> mSnapshot;
+  /// Номер эпохи, переключается после каждой подмены снимка
+  std::atomic<unsigned int> mEpoch;
+  /// Число читателей четных и нечетных эпох
+  mutable std::atomic<long long> mReaders[2];
+  /// Мьютекс, упорядочивающий изменения реестра
+  std::mutex mWriteMutex;
+  /// Номер следующей задачи
+  THandle mNextHandle;
+  /// Замененные при перезагрузке версии задач по именам, пока их еще используют
+  std::map<std::string, std::vector<std::weak_ptr<IGlobalOptimizationProblem>>> mRetired;
+
+  /** Подменяет текущий снимок на snapshot и удаляет старый
+
+  Вызывается под мьютексом mWriteMutex; ждет только читателей, начавших чтение до подмены
+  */
+  void Publish(std::unique_ptr<const TSnapshot> snapshot);
+  /// Добавляет запись, если имя не занято, возвращает ее номер или 0
+  THandle Insert(TEntry entry);
+
+public:
+  TProblemRegistry();
+  ~TProblemRegistry();
+
+  TProblemRegistry(const TProblemRegistry&) = delete;
+  TProblemRegistry& operator=(const TProblemRegistry&) = delete;
+
+  /** Добавляет задачу под именем name
+  \param[in] name имя задачи, уникальное в реестре
+  \param[in] problem задача
+  \return Номер задачи или 0, если имя занято или задача пуста
+  */
+  THandle Register(const std::string& name, const TProblemPtr& problem);
+
+  /** Создает задачу из библиотеки и добавляет ее под именем name
+
+  Библиотека загружается один раз (см. #GlobalOptimizationProblemManager::CreateProblem)
+  \param[in] name имя задачи, уникальное в реестре
+  \param[in] libPath путь к библиотеке
+  \param[in] setup функция, задающая параметры и вызывающая Initialize; пустая функция -- только Initialize
+  \return Номер задачи или 0 при ошибке создания, инициализации или занятом имени
+  */
+  THandle Create(const std::string& name, const std::string& libPath, const TSetup& setup = TSetup());
+
+  /// Возвращает задачу по имени или пустой указатель
+  TProblemPtr Find(const std::string& name) const;
+  /// Возвращает задачу по номеру или пустой указатель
+  TProblemPtr Get(THandle handle) const;
+  /// Возвращает номер задачи по имени или 0
+  THandle GetHandle(const std::string& name) const;
+
+  /** Удаляет задачу из реестра
+  \return #OK_ или #ERROR_, если задачи нет
+  */
+  int Remove(const std::string& name);
+  /// Удаляет задачу с номером handle, возвращает #OK_ или #ERROR_
+  int Remove(THandle handle);
+
+  /** Перезагружает задачу, созданную #Create, из новой версии ее библиотеки
+
+  Если файл библиотеки изменился, новая версия загружается рядом со старой
+  (#GlobalOptimizationProblemManager::ReloadLibrary). Новая задача создается и настраивается
+  той же функцией setup, затем атомарно подменяет старую под тем же именем и номером.
+  Старая задача удаляется, когда завершатся использующие ее вычисления (#WaitForDrain)
+  \param[in] name имя задачи
+  \param[in] force пересоздать задачу, даже если библиотека не изменилась
+  \return #OK_, #NOT_MODIFIED_ или #ERROR_
+  */
+  int Reload(const std::string& name, bool force = false);
+
+  /** Перезагружает все задачи, библиотеки которых изменились
+  \return Число перезагруженных задач
+  */
+  int ReloadModified();
+
+  /** Ждет, пока не будут удалены все старые версии задачи, замененные #Reload
+  \param[in] name имя задачи
+  \param[in] timeout время ожидания в секундах, отрицательное -- без ограничения
+  \return true, если старых версий не осталось
+  */
+  bool WaitForDrain(const std::string& name, double timeout = -1.0);
+
+  /// Имена задач в реестре
+  std::vector<std::string> GetNames() const;
+  /// Число задач в реестре
+  int GetNumberOfProblems() const;
+
+  /// Менеджер библиотек, например для передачи общих данных создаваемым задачам
+  GlobalOptimizationProblemManager& GetManager();
+};
+
+#endif
+// - end of file ----------------------------------------------------------------------------------
@@ -0,0 +1,229 @@
+﻿/////////////////////////////////////////////////////////////////////////////
+//                                                                         //
+//             LOBACHEVSKY STATE UNIVERSITY OF NIZHNY NOVGOROD             //
+//                                                                         //
+//                       Copyright (c) 2025 by UNN.                        //
+//                          All Rights Reserved.                           //
+//                                                                         //
+//  File:      SharedData.h                                                //
+//                                                                         //
+//  Purpose:   Header file for shared read-only problem data               //
+//                                                                         //
+//                                                                         //
+//  Author(s): Lebedev I.G.                                                //
+//                                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+\file SharedData.h
+
+\authors Лебедев И.Г.
+\date 2025
+\copyright ННГУ им. Н.И. Лобачевского
+
+\brief Объявление неизменяемого буфера данных #TSharedData, общего для нескольких экземпляров задач
+
+\details Большие данные задачи (обучающие выборки, таблицы коэффициентов) создаются один раз
+и передаются экземплярам задачи методом #IGlobalOptimizationProblem::SetSharedData. Буфер
+не изменяется после создания и освобождается, когда его перестает использовать последний
+экземпляр, поэтому одна копия данных может одновременно читаться из многих потоков.
+*/
+
+#ifndef __SHARED_DATA_H__
+#define __SHARED_DATA_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/// Описание формы общих данных
+struct TSharedDataShape
+{
+  /// Тип элемента: байт
+  static const int ELEMENT_BYTE = 0;
+  /// Тип элемента: 32-битное целое
+  static const int ELEMENT_INT32 = 1;
+  /// Тип элемента: 64-битное целое
+  static const int ELEMENT_INT64 = 2;
+  /// Тип элемента: float
+  static const int ELEMENT_FLOAT = 3;
+  /// Тип элемента: double
+  static const int ELEMENT_DOUBLE = 4;
+
+  /// Тип элемента
+  int elementType;
+  /// Размеры по измерениям, последнее измерение меняется быстрее всех (порядок C)
+  std::vector<size_t> dimensions;
+
+  TSharedDataShape() : elementType(ELEMENT_BYTE)
+  {}
+
+  TSharedDataShape(int type, const std::vector<size_t>& sizes) : elementType(type), dimensions(sizes)
+  {}
+
+  /// Число элементов, произведение размеров по всем измерениям
+  size_t GetNumberOfElements() const
+  {
+    size_t count = 1;
+    for (size_t size : dimensions)
+      count *= size;
+    return count;
+  }
+
+  /// Размер элемента в байтах, 0 -- неизвестный тип
+  size_t GetElementSize() const
+  {
+    switch (elementType)
+    {
+    case ELEMENT_BYTE:
+      return 1;
+    case ELEMENT_INT32:
+    case ELEMENT_FLOAT:
+      return 4;
+    case ELEMENT_INT64:
+    case ELEMENT_DOUBLE:
+      return 8;
+    default:
+      return 0;
+    }
+  }
+};
+
+/// Соответствие типа C++ типу элемента #TSharedDataShape
+template <class T>
+struct TSharedDataElement;
+
+template <>
+struct TSharedDataElement<std::uint8_t>
+{
+  static const int type = TSharedDataShape::ELEMENT_BYTE;
+};
+
+template <>
+struct TSharedDataElement<std::int32_t>
+{
+  static const int type = TSharedDataShape::ELEMENT_INT32;
+};
+
+template <>
+struct TSharedDataElement<std::int64_t>
+{
+  static const int type = TSharedDataShape::ELEMENT_INT64;
+};
+
+template <>
+struct TSharedDataElement<float>
+{
+  static const int type = TSharedDataShape::ELEMENT_FLOAT;
+};
+
+template <>
+struct TSharedDataElement<double>
+{
+  static const int type = TSharedDataShape::ELEMENT_DOUBLE;
+};
+
+class TSharedData;
+
+/// Указатель на общие данные, экземпляры задач хранят его копии
+typedef std::shared_ptr<const TSharedData> TSharedDataPtr;
+
+/**
+Неизменяемый буфер данных с описанием формы
+
+Создается только фабричными методами, которые возвращают пустой указатель,
+если размер данных не соответствует форме.
+*/
+class TSharedData
+{
+protected:
+  /// Форма данных
+  TSharedDataShape mShape;
+  /// Данные, владелец памяти определяется способом создания
+  std::shared_ptr<const void> mData;
+
+  TSharedData(const TSharedDataShape& shape, std::shared_ptr<const void> data) : mShape(shape),
+    mData(std::move(data))
+  {}
+
+public:
+  TSharedData(const TSharedData&) = delete;
+  TSharedData& operator=(const TSharedData&) = delete;
+
+  /** Создает буфер, копируя данные
+  \param[in] data массив из произведения dimensions элементов
+  \param[in] dimensions размеры по измерениям
+  */
+  template <class T>
+  static TSharedDataPtr Create(const T* data, const std::vector<size_t>& dimensions)
+  {
+    TSharedDataShape shape(TSharedDataElement<T>::type, dimensions);
+    if (!data && shape.GetNumberOfElements() > 0)
+      return TSharedDataPtr();
+    return Create(std::vector<T>(data, data + shape.GetNumberOfElements()), dimensions);
+  }
+
+  /** Создает буфер, забирая память вектора без копирования
+  \param[in] data данные, число элементов равно произведению dimensions
+  \param[in] dimensions размеры по измерениям
+  */
+  template <class T>
+  static TSharedDataPtr Create(std::vector<T>&& data, const std::vector<size_t>& dimensions)
+  {
+    TSharedDataShape shape(TSharedDataElement<T>::type, dimensions);
+    if (data.size() != shape.GetNumberOfElements())
+      return TSharedDataPtr();
+    auto storage = std::make_shared<const std::vector<T>>(std::move(data));
+    return TSharedDataPtr(new TSharedData(shape, std::shared_ptr<const void>(storage, storage->data())));
+  }
+
+  /** Создает буфер над внешней памятью (например, отображенным файлом)
+
+  Память освобождается владельцем data, когда буфер перестает использоваться
+  \param[in] data внешняя память не меньше размера, заданного формой
+  \param[in] shape форма данных
+  */
+  static TSharedDataPtr Wrap(std::shared_ptr<const void> data, const TSharedDataShape& shape)
+  {
+    if (shape.GetElementSize() == 0 || (!data && shape.GetNumberOfElements() > 0))
+      return TSharedDataPtr();
+    return TSharedDataPtr(new TSharedData(shape, std::move(data)));
+  }
+
+  /// Форма данных
+  const TSharedDataShape& GetShape() const
+  {
+    return mShape;
+  }
+
+  /// Число элементов
+  size_t GetNumberOfElements() const
+  {
+    return mShape.GetNumberOfElements();
+  }
+
+  /// Размер данных в байтах
+  size_t GetSize() const
+  {
+    return mShape.GetNumberOfElements() * mShape.GetElementSize();
+  }
+
+  /// Данные без проверки типа
+  const void* GetData() const
+  {
+    return mData.get();
+  }
+
+  /// Данные как массив элементов типа T, nullptr, если тип элемента другой
+  template <class T>
+  const T* GetData() const
+  {
+    if (mShape.elementType != TSharedDataElement<T>::type)
+      return nullptr;
+    return static_cast<const T*>(mData.get());
+  }
+};
+
+#endif
+// - end of file ----------------------------------------------------------------------------------
@@ -0,0 +1,153 @@
+﻿/////////////////////////////////////////////////////////////////////////////
+//                                                                         //
+//             LOBACHEVSKY STATE UNIVERSITY OF NIZHNY NOVGOROD             //
+//                                                                         //
+//                       Copyright (c) 2025 by UNN.                        //
+//                          All Rights Reserved.                           //
+//                                                                         //
+//  File:      StaticProblemRegistry.h                                     //
+//                                                                         //
+//  Purpose:   Header file for statically linked problems registry         //
+//                                                                         //
+//                                                                         //
+//  Author(s): Lebedev I.G.                                                //
+//                                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+\file StaticProblemRegistry.h
+
+\authors Лебедев И.Г.
+\date 2025
+\copyright ННГУ им. Н.И. Лобачевского
+
+\brief Объявление реестра задач, скомпонованных в программу статически
+
+\details При сборке с опцией GLOBALIZER_BENCHMARKS_STATIC_PROBLEMS каждая задача собирается
+в статическую библиотеку с определением GLOBALIZER_BENCHMARKS_STATIC_PROBLEM=<имя задачи>.
+Экспортируемые функции получают имена с префиксом задачи (#PROBLEM_EXPORT_NAME), чтобы задачи
+не конфликтовали при компоновке, а макрос #REGISTER_STATIC_PROBLEM регистрирует их под именем
+задачи при статической инициализации. #GlobalOptimizationProblemManager находит такие задачи
+по имени или по пути к библиотеке без загрузки библиотеки.
+
+При обычной сборке реестр пуст, а #REGISTER_STATIC_PROBLEM ничего не делает.
+*/
+
+#ifndef __STATIC_PROBLEM_REGISTRY_H__
+#define __STATIC_PROBLEM_REGISTRY_H__
+
+#include "IGlobalOptimizationProblem.h"
+#include "ProblemKernelTable.h"
+
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <string>
+#include <vector>
+
+/// Функции задачи, скомпонованной статически
+struct TStaticProblem
+{
+  /// Имя задачи
+  std::string name;
+  /// Функция-фабрика задач
+  createProblem* create;
+  /// Функция-деструктор задач
+  destroyProblem* destroy;
+  /// Функция, заполняющая таблицу вычислительных функций, или NULL
+  getProblemKernelTable* getKernelTable;
+};
+
+/**
+Реестр задач, скомпонованных статически
+
+Задачи регистрируются при статической инициализации, до вызова main, поэтому после
+запуска программы реестр только читается и доступен из любых потоков без блокировок.
+*/
+class TStaticProblemRegistry
+{
+protected:
+  /// Задачи по именам
+  static std::map<std::string, TStaticProblem>& Problems()
+  {
+    static std::map<std::string, TStaticProblem> problems;
+    return problems;
+  }
+
+public:
+  /** Регистрирует задачу, вызывается макросом #REGISTER_STATIC_PROBLEM
+  \return true, если задача с таким именем еще не зарегистрирована
+  */
+  static bool Register(const char* name, createProblem* create, destroyProblem* destroy,
+    getProblemKernelTable* getKernelTable)
+  {
+    return Problems().emplace(name, TStaticProblem{ name, create, destroy, getKernelTable }).second;
+  }
+
+  /** Ищет задачу по имени или по пути к ее библиотеке
+
+  Для пути вида "dir/librastrigin.so" или "dir\rastrigin.dll" задача ищется по имени файла
+  без расширения, сначала с префиксом "lib", затем без него; если точного совпадения нет,
+  регистр букв не учитывается (имена библиотек Windows не зависят от регистра)
+  \return Задача или NULL, если такой задачи нет
+  */
+  static const TStaticProblem* Find(const std::string& nameOrPath)
+  {
+    std::map<std::string, TStaticProblem>& problems = Problems();
+    if (problems.empty())
+      return NULL;
+    auto it = problems.find(nameOrPath);
+    if (it != problems.end())
+      return &it->second;
+
+    size_t begin = nameOrPath.find_last_of("/\\");
+    std::string name = nameOrPath.substr(begin == std::string::npos ? 0 : begin + 1);
+    name = name.substr(0, name.find('.'));
+    it = problems.find(name);
+    if (it == problems.end() && name.compare(0, 3, "lib") == 0)
+      it = problems.find(name.substr(3));
+    if (it != problems.end())
+      return &it->second;
+
+    auto equal = [](const std::string& a, const std::string& b)
+    {
+      return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(),
+        [](char x, char y) { return std::tolower((unsigned char)x) == std::tolower((unsigned char)y); });
+    };
+    for (auto& problem : problems)
+    {
+      if (equal(problem.first, name) || (name.compare(0, 3, "lib") == 0 && equal(problem.first, name.substr(3))))
+        return &problem.second;
+    }
+    return NULL;
+  }
+
+  /// Имена зарегистрированных задач
+  static std::vector<std::string> GetNames()
+  {
+    std::vector<std::string> names;
+    for (auto& problem : Problems())
+      names.push_back(problem.first);
+    return names;
+  }
+};
+
+#define GLOBALIZER_BENCHMARKS_STRINGIFY_(value) #value
+#define GLOBALIZER_BENCHMARKS_STRINGIFY(value) GLOBALIZER_BENCHMARKS_STRINGIFY_(value)
+
+/**
+Регистрирует функции create и destroy задачи (с именами #PROBLEM_EXPORT_NAME) и функцию
+getKernelTableFunction, если задача собирается статически; ставится в файле с этими функциями
+\param[in] getKernelTableFunction функция, заполняющая таблицу вычислительных функций, или NULL
+*/
+#ifdef GLOBALIZER_BENCHMARKS_STATIC_PROBLEM
+#define REGISTER_STATIC_PROBLEM(getKernelTableFunction) \
+  [[maybe_unused]] static const bool staticProblemRegistered = TStaticProblemRegistry::Register( \
+    GLOBALIZER_BENCHMARKS_STRINGIFY(GLOBALIZER_BENCHMARKS_STATIC_PROBLEM), PROBLEM_EXPORT_NAME(create), \
+    PROBLEM_EXPORT_NAME(destroy), getKernelTableFunction);
+#else
+#define REGISTER_STATIC_PROBLEM(getKernelTableFunction)
+#endif
+
+#endif
+// - end of file ----------------------------------------------------------------------------------
@@ -0,0 +1,308 @@
+/////////////////////////////////////////////////////////////////////////////
+//                                                                         //
+//             LOBACHEVSKY STATE UNIVERSITY OF NIZHNY NOVGOROD             //
+//                                                                         //
+//                       Copyright (c) 2025 by UNN.                        //
+//                          All Rights Reserved.                           //
+//                                                                         //
+//  File:      AsyncEvaluator.cpp                                          //
+//                                                                         //
+//  Purpose:   Source file for asynchronous evaluator class                //
+//                                                                         //
+//                                                                         //
+//  Author(s): Lebedev I.G.                                                //
+//                                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+#include "AsyncEvaluator.h"
+
+#include <algorithm>
+#include <cstdint>
+
+// ------------------------------------------------------------------------------------------------
+TCompletionQueue::TCompletionQueue(size_t capacity) : mBuffer(), mMask(0), mEnqueuePosition(0),
+  mDequeuePosition(0)
+{
+  size_t size = 2;
+  while (size < capacity)
+    size *= 2;
+  mBuffer = std::vector<TCell>(size);
+  mMask = size - 1;
+  for (size_t i = 0; i < size; i++)
+  {
+    mBuffer[i].sequence.store(i, std::memory_order_relaxed);
+    mBuffer[i].data = nullptr;
+  }
+}
+
+// ------------------------------------------------------------------------------------------------
+bool TCompletionQueue::Push(TAsyncResult* result)
+{
+  TCell* cell;
+  size_t position = mEnqueuePosition.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    cell = &mBuffer[position & mMask];
+    size_t sequence = cell->sequence.load(std::memory_order_acquire);
+    intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+    if (difference == 0)
+    {
+      if (mEnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+        break;
+    }
+    else if (difference < 0)
+      return false;
+    else
+      position = mEnqueuePosition.load(std::memory_order_relaxed);
+  }
+  cell->data = result;
+  cell->sequence.store(position + 1, std::memory_order_release);
+  return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool TCompletionQueue::Pop(TAsyncResult*& result)
+{
+  TCell* cell;
+  size_t position = mDequeuePosition.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    cell = &mBuffer[position & mMask];
+    size_t sequence = cell->sequence.load(std::memory_order_acquire);
+    intptr_t difference = (intptr_t)sequence - (intptr_t)(position + 1);
+    if (difference == 0)
+    {
+      if (mDequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+        break;
+    }
+    else if (difference < 0)
+      return false;
+    else
+      position = mDequeuePosition.load(std::memory_order_relaxed);
+  }
+  result = cell->data;
+  cell->sequence.store(position + mMask + 1, std::memory_order_release);
+  return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t TCompletionQueue::GetCapacity() const
+{
+  return mBuffer.size();
+}
+
+// ------------------------------------------------------------------------------------------------
+TAsyncEvaluator::TAsyncEvaluator(IGlobalOptimizationProblem* problem, int numberOfThreads, int capacity) :
+  mProblem(problem), mIsStopped(false), mCompleted((size_t)std::max(capacity, 1)), mCapacity(std::max(capacity, 1)),
+  mInFlight(0), mNextTicket(0)
+{
+  TProblemCapabilities capabilities;
+  if (mProblem)
+    mProblem->GetCapabilities(capabilities);
+
+  if (numberOfThreads <= 0)
+    numberOfThreads = std::max(1, (int)std::thread::hardware_concurrency());
+  if (!mProblem)
+    numberOfThreads = 1;
+
+  if (capabilities.threadSafety == TProblemCapabilities::THREAD_REENTRANT)
+  {
+    for (int i = 0; i < numberOfThreads; i++)
+      mWorkers.emplace_back(&TAsyncEvaluator::WorkerLoop, this, mProblem);
+    return;
+  }
+
+  // каждый дополнительный поток вычисляет свою копию задачи
+  for (int i = 1; i < numberOfThreads; i++)
+  {
+    IGlobalOptimizationProblem* clone = mProblem->Clone();
+    if (!clone)
+      break;
+    mClones.emplace_back(clone);
+  }
+  mWorkers.emplace_back(&TAsyncEvaluator::WorkerLoop, this, mProblem);
+  for (auto& clone : mClones)
+    mWorkers.emplace_back(&TAsyncEvaluator::WorkerLoop, this, clone.get());
+}
+
+// ------------------------------------------------------------------------------------------------
+TAsyncEvaluator::~TAsyncEvaluator()
+{
+  {
+    std::lock_guard<std::mutex> lock(mTasksMutex);
+    mIsStopped = true;
+  }
+  mTasksCondition.notify_all();
+  for (auto& worker : mWorkers)
+    worker.join();
+
+  TAsyncResult* result;
+  while (mCompleted.Pop(result))
+    delete result;
+}
+
+// ------------------------------------------------------------------------------------------------
+void TAsyncEvaluator::WorkerLoop(IGlobalOptimizationProblem* problem)
+{
+  for (;;)
+  {
+    TTask task;
+    {
+      std::unique_lock<std::mutex> lock(mTasksMutex);
+      mTasksCondition.wait(lock, [this] { return mIsStopped || !mTasks.empty(); });
+      if (mIsStopped)
+        return;
+      task = std::move(mTasks.front());
+      mTasks.pop_front();
+    }
+
+    TAsyncResult* result = new TAsyncResult();
+    Evaluate(problem, task, *result);
+
+    // число заявок не превышает емкости очереди, поэтому место в ней всегда есть
+    while (!mCompleted.Push(result))
+      std::this_thread::yield();
+
+    {
+      std::lock_guard<std::mutex> lock(mWaitMutex);
+    }
+    mWaitCondition.notify_all();
+  }
+}
+
+// ------------------------------------------------------------------------------------------------
+void TAsyncEvaluator::Evaluate(IGlobalOptimizationProblem* problem, TTask& task, TAsyncResult& result)
+{
+  auto start = std::chrono::steady_clock::now();
+  result.ticket = task.ticket;
+  result.fNumber = task.fNumber;
+  result.status = TAsyncEvaluator::OK_;
+
+  int yCount = (int)task.y.size();
+  int uCount = (int)task.u.size();
+  const std::string* u = uCount > 0 ? task.u.data() : nullptr;
+  try
+  {
+    if (task.fNumber < 0)
+    {
+      result.values.resize(problem->GetNumberOfFunctions());
+      result.statuses.resize(result.values.size());
+      if (problem->TryCalculateAllFunctionals(task.y.data(), yCount, u, uCount, result.values.data(),
+        result.statuses.data()) != IGlobalOptimizationProblem::PROBLEM_OK)
+        result.status = TAsyncEvaluator::ERROR_;
+    }
+    else
+    {
+      result.values.resize(1);
+      result.statuses.assign(1, problem->TryCalculateFunctionals(task.y.data(), yCount, u, uCount, task.fNumber,
+        result.values[0]));
+    }
+  }
+  catch (...)
+  {
+    result.status = TAsyncEvaluator::ERROR_;
+  }
+
+  auto finish = std::chrono::steady_clock::now();
+  result.queueTime = std::chrono::duration<double>(start - task.submitTime).count();
+  result.evaluationTime = std::chrono::duration<double>(finish - start).count();
+}
+
+// ------------------------------------------------------------------------------------------------
+long long TAsyncEvaluator::Submit(const double* y, int yCount, const std::string* u, int uCount, int fNumber)
+{
+  if (!mProblem || !y || yCount <= 0 || uCount < 0 || (uCount > 0 && !u) ||
+    fNumber >= mProblem->GetNumberOfFunctions())
+    return -1;
+
+  int inFlight = mInFlight.load(std::memory_order_relaxed);
+  do
+  {
+    if (inFlight >= mCapacity)
+      return -1;
+  } while (!mInFlight.compare_exchange_weak(inFlight, inFlight + 1, std::memory_order_relaxed));
+
+  TTask task;
+  task.ticket = mNextTicket.fetch_add(1, std::memory_order_relaxed);
+  task.y.assign(y, y + yCount);
+  task.u.assign(u, u + uCount);
+  task.fNumber = fNumber < 0 ? -1 : fNumber;
+  task.submitTime = std::chrono::steady_clock::now();
+  long long ticket = task.ticket;
+  {
+    std::lock_guard<std::mutex> lock(mTasksMutex);
+    mTasks.push_back(std::move(task));
+  }
+  mTasksCondition.notify_one();
+  return ticket;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool TAsyncEvaluator::PopCompleted(TAsyncResult& result, bool& isLast)
+{
+  TAsyncResult* completed;
+  if (!mCompleted.Pop(completed))
+    return false;
+
+  result = std::move(*completed);
+  delete completed;
+  isLast = mInFlight.fetch_sub(1, std::memory_order_relaxed) == 1;
+  return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+int TAsyncEvaluator::Poll(TAsyncResult& result)
+{
+  bool isLast = false;
+  if (!PopCompleted(result, isLast))
+    return TAsyncEvaluator::NOT_READY_;
+
+  // потоки в WaitAny ждали этот результат, больше ждать нечего
+  if (isLast)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mWaitMutex);
+    }
+    mWaitCondition.notify_all();
+  }
+  return TAsyncEvaluator::OK_;
+}
+
+// ------------------------------------------------------------------------------------------------
+int TAsyncEvaluator::WaitAny(TAsyncResult& result, double timeout)
+{
+  if (Poll(result) == TAsyncEvaluator::OK_)
+    return TAsyncEvaluator::OK_;
+  if (mInFlight.load(std::memory_order_relaxed) == 0)
+    return TAsyncEvaluator::ERROR_;
+
+  // число заявок проверяется и под мьютексом: результат, которого ждал этот поток, мог забрать другой
+  std::unique_lock<std::mutex> lock(mWaitMutex);
+  bool isReceived = false;
+  auto isDone = [this, &result, &isReceived]
+  {
+    bool isLast = false;
+    isReceived = PopCompleted(result, isLast);
+    if (isLast)
+      mWaitCondition.notify_all();
+    return isReceived || mInFlight.load(std::memory_order_relaxed) == 0;
+  };
+  if (timeout < 0)
+    mWaitCondition.wait(lock, isDone);
+  else if (!mWaitCondition.wait_for(lock, std::chrono::duration<double>(timeout), isDone))
+    return TAsyncEvaluator::NOT_READY_;
+  return isReceived ? TAsyncEvaluator::OK_ : TAsyncEvaluator::ERROR_;
+}
+
+// ------------------------------------------------------------------------------------------------
+int TAsyncEvaluator::GetNumberOfInFlight() const
+{
+  return mInFlight.load(std::memory_order_relaxed);
+}
+
+// ------------------------------------------------------------------------------------------------
+int TAsyncEvaluator::GetNumberOfThreads() const
+{
+  return (int)mWorkers.size();
+}
+// - end of file ----------------------------------------------------------------------------------
@@ -0,0 +1,226 @@
+/////////////////////////////////////////////////////////////////////////////
+//                                                                         //
+//             LOBACHEVSKY STATE UNIVERSITY OF NIZHNY NOVGOROD             //
+//                                                                         //
+//                       Copyright (c) 2025 by UNN.                        //
+//                          All Rights Reserved.                           //
+//                                                                         //
+//  File:      BlockEvaluator.cpp                                          //
+//                                                                         //
+//  Purpose:   Source file for block evaluator class                       //
+//                                                                         //
+//                                                                         //
+//  Author(s): Lebedev I.G.                                                //
+//                                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+#include "BlockEvaluator.h"
+
+#include <algorithm>
+
+// ------------------------------------------------------------------------------------------------
+TBlockEvaluator::TBlockEvaluator(IGlobalOptimizationProblem* problem) : mProblem(problem),
+  mNumberOfVariables(0), mIsPointSet(false), mNumberOfEvaluations(0)
+{
+  if (!mProblem)
+    return;
+
+  mNumberOfVariables = mProblem->GetNumberOfContinuousVariable();
+  int numberOfFunctions = mProblem->GetNumberOfFunctions();
+  mStructures.resize(numberOfFunctions);
+  mVariableFunctionals.resize(mNumberOfVariables);
+  mVariableBlocks.resize(numberOfFunctions);
+  mElements.resize(numberOfFunctions);
+  mValues.resize(numberOfFunctions);
+
+  for (int f = 0; f < numberOfFunctions; f++)
+  {
+    TFunctionalStructure& structure = mStructures[f];
+    if (mProblem->GetFunctionalStructure(f, structure) == IGlobalOptimizationProblem::PROBLEM_ERROR)
+      structure.variables.clear();
+    CheckStructure(structure);
+
+    for (int v : structure.variables)
+      mVariableFunctionals[v].push_back(f);
+    if (!structure.isSeparable)
+      continue;
+
+    mVariableBlocks[f].resize(mNumberOfVariables);
+    for (int k = 0; k < (int)structure.blocks.size(); k++)
+      for (int v : structure.blocks[k])
+        mVariableBlocks[f][v].push_back(k);
+    mElements[f].resize(structure.blocks.size());
+  }
+}
+
+// ------------------------------------------------------------------------------------------------
+void TBlockEvaluator::CheckStructure(TFunctionalStructure& structure) const
+{
+  std::sort(structure.variables.begin(), structure.variables.end());
+  structure.variables.erase(std::unique(structure.variables.begin(), structure.variables.end()),
+    structure.variables.end());
+  bool isCorrect = structure.variables.empty() ||
+    (structure.variables.front() >= 0 && structure.variables.back() < mNumberOfVariables);
+
+  // переменные слагаемых должны входить в список переменных функции
+  for (size_t k = 0; isCorrect && structure.isSeparable && k < structure.blocks.size(); k++)
+    for (int v : structure.blocks[k])
+      if (!std::binary_search(structure.variables.begin(), structure.variables.end(), v))
+        isCorrect = false;
+
+  // задача не описала структуру или описала ее неверно
+  if (!isCorrect || (structure.variables.empty() && !structure.isSeparable))
+  {
+    structure = TFunctionalStructure();
+    structure.variables.resize(mNumberOfVariables);
+    for (int v = 0; v < mNumberOfVariables; v++)
+      structure.variables[v] = v;
+  }
+}
+
+// ------------------------------------------------------------------------------------------------
+void TBlockEvaluator::SumElements(int fNumber)
+{
+  double sum = mStructures[fNumber].constant;
+  for (double element : mElements[fNumber])
+    sum += element;
+  mValues[fNumber] = sum;
+}
+
+// ------------------------------------------------------------------------------------------------
+int TBlockEvaluator::EvaluateFunctional(int fNumber)
+{
+  TFunctionalStructure& structure = mStructures[fNumber];
+  if (structure.isSeparable)
+  {
+    int count = (int)structure.blocks.size();
+    mBlocks.resize(count);
+    for (int k = 0; k < count; k++)
+      mBlocks[k] = k;
+    if (count == 0 || mProblem->CalculateFunctionalElements(mPoint.data(), mNumberOfVariables, fNumber,
+      mBlocks.data(), count, mElements[fNumber].data()) == IGlobalOptimizationProblem::PROBLEM_OK)
+    {
+      mNumberOfEvaluations += count;
+      SumElements(fNumber);
+      return TBlockEvaluator::OK_;
+    }
+
+    // задача не вычисляет слагаемые, функция далее вычисляется целиком
+    structure.isSeparable = false;
+    mElements[fNumber].clear();
+    mVariableBlocks[fNumber].clear();
+  }
+
+  mValues[fNumber] = mProblem->CalculateFunctionals(mPoint.data(), mNumberOfVariables, nullptr, 0, fNumber);
+  mNumberOfEvaluations++;
+  return TBlockEvaluator::OK_;
+}
+
+// ------------------------------------------------------------------------------------------------
+int TBlockEvaluator::SetPoint(const double* y, int yCount)
+{
+  mIsPointSet = false;
+  mNumberOfEvaluations = 0;
+  if (!mProblem || !y || yCount < mNumberOfVariables || mProblem->GetNumberOfDiscreteVariable() > 0)
+    return TBlockEvaluator::ERROR_;
+
+  mPoint.assign(y, y + mNumberOfVariables);
+  try
+  {
+    for (int f = 0; f < (int)mStructures.size(); f++)
+      EvaluateFunctional(f);
+  }
+  catch (...)
+  {
+    return TBlockEvaluator::ERROR_;
+  }
+  mIsPointSet = true;
+  return TBlockEvaluator::OK_;
+}
+
+// ------------------------------------------------------------------------------------------------
+int TBlockEvaluator::Update(const int* variables, const double* values, int count)
+{
+  mNumberOfEvaluations = 0;
+  if (!mIsPointSet || count < 0 || (count > 0 && (!variables || !values)))
+    return TBlockEvaluator::ERROR_;
+  for (int i = 0; i < count; i++)
+    if (variables[i] < 0 || variables[i] >= mNumberOfVariables)
+      return TBlockEvaluator::ERROR_;
+
+  mFunctionals.clear();
+  for (int i = 0; i < count; i++)
+  {
+    mPoint[variables[i]] = values[i];
+    const std::vector<int>& functionals = mVariableFunctionals[variables[i]];
+    mFunctionals.insert(mFunctionals.end(), functionals.begin(), functionals.end());
+  }
+  std::sort(mFunctionals.begin(), mFunctionals.end());
+  mFunctionals.erase(std::unique(mFunctionals.begin(), mFunctionals.end()), mFunctionals.end());
+
+  try
+  {
+    for (int f : mFunctionals)
+    {
+      if (!mStructures[f].isSeparable)
+      {
+        EvaluateFunctional(f);
+        continue;
+      }
+
+      mBlocks.clear();
+      for (int i = 0; i < count; i++)
+      {
+        const std::vector<int>& blocks = mVariableBlocks[f][variables[i]];
+        mBlocks.insert(mBlocks.end(), blocks.begin(), blocks.end());
+      }
+      std::sort(mBlocks.begin(), mBlocks.end());
+      mBlocks.erase(std::unique(mBlocks.begin(), mBlocks.end()), mBlocks.end());
+      if (mBlocks.empty())
+        continue;
+
+      mBlockValues.resize(mBlocks.size());
+      if (mProblem->CalculateFunctionalElements(mPoint.data(), mNumberOfVariables, f, mBlocks.data(),
+        (int)mBlocks.size(), mBlockValues.data()) != IGlobalOptimizationProblem::PROBLEM_OK)
+      {
+        EvaluateFunctional(f);
+        continue;
+      }
+      for (size_t k = 0; k < mBlocks.size(); k++)
+        mElements[f][mBlocks[k]] = mBlockValues[k];
+      mNumberOfEvaluations += (int)mBlocks.size();
+      SumElements(f);
+    }
+  }
+  catch (...)
+  {
+    mIsPointSet = false;
+    return TBlockEvaluator::ERROR_;
+  }
+  return TBlockEvaluator::OK_;
+}
+
+// ------------------------------------------------------------------------------------------------
+const std::vector<double>& TBlockEvaluator::GetPoint() const
+{
+  return mPoint;
+}
+
+// ------------------------------------------------------------------------------------------------
+const std::vector<double>& TBlockEvaluator::GetValues() const
+{
+  return mValues;
+}
+
+// ------------------------------------------------------------------------------------------------
+const TFunctionalStructure& TBlockEvaluator::GetStructure(int fNumber) const
+{
+  return mStructures[fNumber];
+}
+
+// ------------------------------------------------------------------------------------------------
+int TBlockEvaluator::GetNumberOfEvaluations() const
+{
+  return mNumberOfEvaluations;
+}
+// - end of file ----------------------------------------------------------------------------------
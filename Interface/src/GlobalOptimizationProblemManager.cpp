@@ -15,117 +15,648 @@
 /////////////////////////////////////////////////////////////////////////////
 
 #include "GlobalOptimizationProblemManager.h"
+#include "StaticProblemRegistry.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
 #include <iostream>
 
-// ------------------------------------------------------------------------------------------------
-GlobalOptimizationProblemManager::GlobalOptimizationProblemManager() : mLibHandle(NULL), mProblem(NULL),
-  mCreate(NULL), mDestroy(NULL)
-{
+/** Время вычисления функции в секундах, ниже которого передача точки в другой поток
+или процесс обходится дороже самого вычисления
+*/
+static const double MIN_PARALLEL_FUNCTION_COST = 1e-5;
 
+/// Время изменения файла, 0 -- файла нет
+static long long GetFileModificationTime(const std::string& path)
+{
+  std::error_code error;
+  auto time = std::filesystem::last_write_time(path, error);
+  if (error)
+    return 0;
+  return (long long)time.time_since_epoch().count();
 }
 
 // ------------------------------------------------------------------------------------------------
-GlobalOptimizationProblemManager::~GlobalOptimizationProblemManager()
+TProblemLibrary::TProblemLibrary() : mHandle(NULL), mModificationTime(0), mCreate(NULL), mDestroy(NULL),
+  mGetKernelTable(NULL)
 {
-  FreeProblemLibrary();
+
 }
 
 // ------------------------------------------------------------------------------------------------
-int GlobalOptimizationProblemManager::LoadProblemLibrary(const std::string& libPath)
+std::shared_ptr<TProblemLibrary> TProblemLibrary::Load(const std::string& libPath, bool isCopy)
 {
-  if (mLibHandle)
-    FreeProblemLibrary();
+  std::shared_ptr<TProblemLibrary> library(new TProblemLibrary());
+  library->mPath = libPath;
+
+  // статически скомпонованная задача не требует загрузки библиотеки
+  const TStaticProblem* staticProblem = TStaticProblemRegistry::Find(libPath);
+  if (staticProblem)
+  {
+    library->mCreate = staticProblem->create;
+    library->mDestroy = staticProblem->destroy;
+    library->mGetKernelTable = staticProblem->getKernelTable;
+    return library;
+  }
+
+  library->mModificationTime = GetFileModificationTime(libPath);
+  std::string loadPath = libPath;
+  if (isCopy)
+  {
+    // загрузчик возвращает уже загруженную библиотеку по тому же пути, поэтому новая версия
+    // загружается из копии с уникальным именем
+    static std::atomic<unsigned long long> copyNumber(0);
+    std::filesystem::path source(libPath);
+    std::filesystem::path copy = std::filesystem::temp_directory_path() / (source.stem().string() + "." +
+      std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + "." +
+      std::to_string(copyNumber++) + source.extension().string());
+    std::error_code error;
+    if (!std::filesystem::copy_file(source, copy, error))
+    {
+      std::cerr << "Cannot copy library: " << libPath << ": " << error.message() << std::endl;
+      return std::shared_ptr<TProblemLibrary>();
+    }
+    library->mCopyPath = copy.string();
+    loadPath = library->mCopyPath;
+  }
+
   #ifdef WIN32
-    mLibHandle = LoadLibrary(TEXT(libPath.c_str()));
-    if (!mLibHandle)
+    library->mHandle = LoadLibrary(TEXT(loadPath.c_str()));
+    if (!library->mHandle)
     {
-        std::cerr << "Cannot load library: " << TEXT(libPath.c_str()) << std::endl;
-        return GlobalOptimizationProblemManager::ERROR_;
+        std::cerr << "Cannot load library: " << TEXT(loadPath.c_str()) << std::endl;
+        return std::shared_ptr<TProblemLibrary>();
     }
   #else
-    mLibHandle = dlopen(libPath.c_str(), RTLD_LAZY);
-    if (!mLibHandle)
+    library->mHandle = dlopen(loadPath.c_str(), RTLD_LAZY);
+    if (!library->mHandle)
     {
         std::cerr << dlerror() << std::endl;
-        return GlobalOptimizationProblemManager::ERROR_;
+        return std::shared_ptr<TProblemLibrary>();
     }
   #endif
   #ifdef WIN32
-    mCreate = (createProblem*) GetProcAddress(mLibHandle, "create");
-    mDestroy = (destroyProblem*) GetProcAddress(mLibHandle, "destroy");
-    if (!mCreate || !mDestroy)
+    library->mCreate = (createProblem*) GetProcAddress(library->mHandle, "create");
+    library->mDestroy = (destroyProblem*) GetProcAddress(library->mHandle, "destroy");
+    if (!library->mCreate || !library->mDestroy)
     {
       std::cerr << "Cannot load symbols: " << GetLastError() << std::endl;
-      FreeLibHandler();
-      return GlobalOptimizationProblemManager::ERROR_;
+      return std::shared_ptr<TProblemLibrary>();
     }
   #else
     dlerror();
-    mCreate = (createProblem*) dlsym(mLibHandle, "create");
+    library->mCreate = (createProblem*) dlsym(library->mHandle, "create");
     char* dlsym_error = dlerror();
     if (dlsym_error)
     {
-      mCreate = NULL;
       std::cerr << dlsym_error << std::endl;
-      FreeLibHandler();
-      return GlobalOptimizationProblemManager::ERROR_;
+      return std::shared_ptr<TProblemLibrary>();
     }
-    mDestroy = (destroyProblem*) dlsym(mLibHandle, "destroy");
+    library->mDestroy = (destroyProblem*) dlsym(library->mHandle, "destroy");
     dlsym_error = dlerror();
     if (dlsym_error)
     {
-      mCreate = NULL;
-      mDestroy = NULL;
       std::cerr << dlsym_error << std::endl;
-      FreeLibHandler();
-      return GlobalOptimizationProblemManager::ERROR_;
+      return std::shared_ptr<TProblemLibrary>();
     }
   #endif
 
-  mProblem = mCreate();
-  if (!mProblem)
+  // таблица вычислительных функций необязательна, ее отсутствие не является ошибкой
+  #ifdef WIN32
+    library->mGetKernelTable = (getProblemKernelTable*) GetProcAddress(library->mHandle, "getKernelTable");
+  #else
+    library->mGetKernelTable = (getProblemKernelTable*) dlsym(library->mHandle, "getKernelTable");
+    dlerror();
+  #endif
+  return library;
+}
+
+// ------------------------------------------------------------------------------------------------
+TProblemLibrary::~TProblemLibrary()
+{
+  if (mHandle)
+  {
+    #ifdef WIN32
+      FreeLibrary(mHandle);
+    #else
+      dlclose(mHandle);
+    #endif
+  }
+  if (!mCopyPath.empty())
+  {
+    std::error_code error;
+    std::filesystem::remove(mCopyPath, error);
+  }
+}
+
+// ------------------------------------------------------------------------------------------------
+const std::string& TProblemLibrary::GetPath() const
+{
+  return mPath;
+}
+
+// ------------------------------------------------------------------------------------------------
+const std::string& TProblemLibrary::GetCopyPath() const
+{
+  return mCopyPath;
+}
+
+// ------------------------------------------------------------------------------------------------
+long long TProblemLibrary::GetModificationTime() const
+{
+  return mModificationTime;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool TProblemLibrary::IsModified() const
+{
+  if (mModificationTime == 0)
+    return false;
+  // файл может отсутствовать, пока сборка его перезаписывает
+  long long time = GetFileModificationTime(mPath);
+  return time != 0 && time != mModificationTime;
+}
+
+// ------------------------------------------------------------------------------------------------
+createProblem* TProblemLibrary::GetCreate() const
+{
+  return mCreate;
+}
+
+// ------------------------------------------------------------------------------------------------
+destroyProblem* TProblemLibrary::GetDestroy() const
+{
+  return mDestroy;
+}
+
+// ------------------------------------------------------------------------------------------------
+getProblemKernelTable* TProblemLibrary::GetKernelTableFunction() const
+{
+  return mGetKernelTable;
+}
+
+// ------------------------------------------------------------------------------------------------
+GlobalOptimizationProblemManager::GlobalOptimizationProblemManager() : mLibrary(), mProblem(), mKernelTable(),
+  mHasKernelTable(false)
+{
+
+}
+
+// ------------------------------------------------------------------------------------------------
+GlobalOptimizationProblemManager::~GlobalOptimizationProblemManager()
+{
+  for (auto& thread : mBackgroundThreads)
+    thread.join();
+  FreeProblemLibrary();
+}
+
+// ------------------------------------------------------------------------------------------------
+std::shared_ptr<TProblemLibrary> GlobalOptimizationProblemManager::GetLibrary(const std::string& libPath)
+{
+  {
+    std::lock_guard<std::mutex> lock(mLibrariesMutex);
+    auto it = mLibraries.find(libPath);
+    if (it != mLibraries.end())
+      return it->second;
+  }
+
+  // библиотека загружается без блокировки, чтобы разные библиотеки загружались параллельно;
+  // если ее одновременно загрузил другой поток, используется уже добавленная в кэш
+  std::shared_ptr<TProblemLibrary> library = TProblemLibrary::Load(libPath);
+  if (!library)
+    return library;
+  std::lock_guard<std::mutex> lock(mLibrariesMutex);
+  return mLibraries.emplace(libPath, library).first->second;
+}
+
+// ------------------------------------------------------------------------------------------------
+TProblemPtr GlobalOptimizationProblemManager::CreateProblem(const std::string& libPath)
+{
+  return CreateProblem(GetLibrary(libPath));
+}
+
+// ------------------------------------------------------------------------------------------------
+TProblemPtr GlobalOptimizationProblemManager::CreateProblem(const std::shared_ptr<TProblemLibrary>& library)
+{
+  if (!library)
+    return TProblemPtr();
+
+  IGlobalOptimizationProblem* problem = library->GetCreate()();
+  if (!problem)
   {
-    FreeLibHandler();
-    mCreate = NULL;
-    mDestroy = NULL;
     std::cerr << "Cannot create problem instance" << std::endl;
+    return TProblemPtr();
   }
+  // удаляющая функция держит библиотеку загруженной, пока существует задача
+  TProblemPtr result(problem, [library](IGlobalOptimizationProblem* p) { library->GetDestroy()(p); });
 
+  // общие данные передаются до Initialize, пока задача может их учесть
+  std::map<std::string, TSharedDataPtr> sharedData;
+  {
+    std::lock_guard<std::mutex> lock(mLibrariesMutex);
+    sharedData = mSharedData;
+  }
+  for (auto& data : sharedData)
+    result->SetSharedData(data.first, data.second);
+  return result;
+}
+
+// ------------------------------------------------------------------------------------------------
+int GlobalOptimizationProblemManager::ReleaseUnusedLibraries()
+{
+  std::lock_guard<std::mutex> lock(mLibrariesMutex);
+  int count = 0;
+  for (auto it = mLibraries.begin(); it != mLibraries.end();)
+  {
+    // единственная ссылка -- из кэша
+    if (it->second.use_count() == 1)
+    {
+      it = mLibraries.erase(it);
+      count++;
+    }
+    else
+      ++it;
+  }
+  return count;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GlobalOptimizationProblemManager::IsLibraryModified(const std::string& libPath) const
+{
+  std::shared_ptr<const TProblemLibrary> library = FindLibrary(libPath);
+  return library && library->IsModified();
+}
+
+// ------------------------------------------------------------------------------------------------
+int GlobalOptimizationProblemManager::ReloadLibrary(const std::string& libPath)
+{
+  if (TStaticProblemRegistry::Find(libPath))
+    return GlobalOptimizationProblemManager::ERROR_;
+
+  std::shared_ptr<TProblemLibrary> library = TProblemLibrary::Load(libPath, true);
+  if (!library)
+    return GlobalOptimizationProblemManager::ERROR_;
+
+  // старая версия выгружается вместе с последней своей задачей
+  std::lock_guard<std::mutex> lock(mLibrariesMutex);
+  mLibraries[libPath] = library;
   return GlobalOptimizationProblemManager::OK_;
 }
 
 // ------------------------------------------------------------------------------------------------
-void GlobalOptimizationProblemManager::FreeLibHandler()
+std::shared_ptr<const TProblemLibrary> GlobalOptimizationProblemManager::FindLibrary(const std::string& libPath) const
 {
-  #ifdef WIN32
-    FreeLibrary(mLibHandle);
-  #else
-    dlclose(mLibHandle);
-  #endif
-  mLibHandle = NULL;
+  std::lock_guard<std::mutex> lock(mLibrariesMutex);
+  auto it = mLibraries.find(libPath);
+  return it == mLibraries.end() ? std::shared_ptr<const TProblemLibrary>() : it->second;
+}
+
+// ------------------------------------------------------------------------------------------------
+int GlobalOptimizationProblemManager::Preload(const std::vector<std::string>& libPaths, const TProblemSetup& setup,
+  int numberOfThreads)
+{
+  typedef std::chrono::steady_clock TClock;
+  auto seconds = [](TClock::time_point start, TClock::time_point finish)
+  {
+    return std::chrono::duration<double>(finish - start).count();
+  };
+  // копия функции настройки нужна фоновому потоку, который переживает вызов
+  auto initialize = [setup](IGlobalOptimizationProblem* problem)
+  {
+    try
+    {
+      return setup ? setup(problem) : problem->Initialize();
+    }
+    catch (...)
+    {
+      return IGlobalOptimizationProblem::PROBLEM_ERROR;
+    }
+  };
+
+  int count = (int)libPaths.size();
+  std::vector<TPreloadTiming> timings(count);
+  std::vector<TProblemPtr> problems(count);
+  std::atomic<int> next(0);
+  auto work = [&]()
+  {
+    for (int i = next++; i < count; i = next++)
+    {
+      TPreloadTiming& timing = timings[i];
+      timing.libPath = libPaths[i];
+      timing.status = GlobalOptimizationProblemManager::ERROR_;
+
+      auto start = TClock::now();
+      std::shared_ptr<TProblemLibrary> library = GetLibrary(libPaths[i]);
+      auto loaded = TClock::now();
+      timing.loadTime = seconds(start, loaded);
+      if (!library)
+        continue;
+      problems[i] = CreateProblem(library);
+      auto created = TClock::now();
+      timing.createTime = seconds(loaded, created);
+      if (!problems[i])
+        continue;
+
+      TProblemCapabilities capabilities;
+      problems[i]->GetCapabilities(capabilities);
+      if (capabilities.isInterpreterBacked)
+      {
+        timing.isBackground = true;
+        timing.status = GlobalOptimizationProblemManager::NOT_READY_;
+        continue;
+      }
+      if (initialize(problems[i].get()) == IGlobalOptimizationProblem::PROBLEM_OK)
+        timing.status = GlobalOptimizationProblemManager::OK_;
+      timing.initializeTime = seconds(created, TClock::now());
+    }
+  };
+
+  if (numberOfThreads <= 0)
+    numberOfThreads = (int)std::thread::hardware_concurrency();
+  numberOfThreads = std::max(1, std::min(numberOfThreads, count));
+  std::vector<std::thread> threads;
+  for (int t = 1; t < numberOfThreads; t++)
+    threads.emplace_back(work);
+  work();
+  for (auto& thread : threads)
+    thread.join();
+
+  int result = GlobalOptimizationProblemManager::OK_;
+  std::vector<int> background;
+  {
+    std::lock_guard<std::mutex> lock(mPreloadMutex);
+    for (int i = 0; i < count; i++)
+    {
+      auto old = std::find_if(mPreloadTimings.begin(), mPreloadTimings.end(),
+        [&](const TPreloadTiming& timing) { return timing.libPath == libPaths[i]; });
+      if (old != mPreloadTimings.end())
+        mPreloadTimings.erase(old);
+      mPreloadTimings.push_back(timings[i]);
+      mPreloaded.erase(libPaths[i]);
+
+      if (timings[i].status == GlobalOptimizationProblemManager::OK_)
+        mPreloaded[libPaths[i]] = problems[i];
+      else if (timings[i].status == GlobalOptimizationProblemManager::NOT_READY_)
+        background.push_back(i);
+      else
+        result = GlobalOptimizationProblemManager::ERROR_;
+    }
+  }
+  if (background.empty())
+    return result;
+
+  // задачи с интерпретатором инициализируются по одной: запуск интерпретатора и импорт модулей
+  // не допускают параллельных вызовов, а выполнение кода python все равно упорядочено GIL;
+  // Preload может вызываться из нескольких потоков, поэтому список потоков меняется под мьютексом
+  std::lock_guard<std::mutex> lock(mPreloadMutex);
+  mBackgroundThreads.emplace_back([this, background, problems, libPaths, initialize, seconds]()
+  {
+    for (int i : background)
+    {
+      int status;
+      double time;
+      {
+        std::lock_guard<std::mutex> backgroundLock(mBackgroundMutex);
+        auto start = TClock::now();
+        status = initialize(problems[i].get()) == IGlobalOptimizationProblem::PROBLEM_OK ?
+          GlobalOptimizationProblemManager::OK_ : GlobalOptimizationProblemManager::ERROR_;
+        time = seconds(start, TClock::now());
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(mPreloadMutex);
+        for (auto& timing : mPreloadTimings)
+        {
+          // путь мог быть загружен повторно, пока задача инициализировалась
+          if (timing.libPath == libPaths[i] && timing.status == GlobalOptimizationProblemManager::NOT_READY_)
+          {
+            timing.initializeTime = time;
+            timing.status = status;
+            if (status == GlobalOptimizationProblemManager::OK_)
+              mPreloaded[libPaths[i]] = problems[i];
+          }
+        }
+      }
+      mPreloadCondition.notify_all();
+    }
+  });
+  return result;
+}
+
+// ------------------------------------------------------------------------------------------------
+TProblemPtr GlobalOptimizationProblemManager::GetPreloadedProblem(const std::string& libPath, bool wait) const
+{
+  std::unique_lock<std::mutex> lock(mPreloadMutex);
+  auto isReady = [this, &libPath]()
+  {
+    for (auto& timing : mPreloadTimings)
+      if (timing.libPath == libPath)
+        return timing.status != GlobalOptimizationProblemManager::NOT_READY_;
+    return true;
+  };
+  if (wait)
+    mPreloadCondition.wait(lock, isReady);
+
+  auto it = mPreloaded.find(libPath);
+  return it == mPreloaded.end() ? TProblemPtr() : it->second;
+}
+
+// ------------------------------------------------------------------------------------------------
+int GlobalOptimizationProblemManager::WaitPreload() const
+{
+  std::unique_lock<std::mutex> lock(mPreloadMutex);
+  mPreloadCondition.wait(lock, [this]()
+  {
+    for (auto& timing : mPreloadTimings)
+      if (timing.status == GlobalOptimizationProblemManager::NOT_READY_)
+        return false;
+    return true;
+  });
+
+  for (auto& timing : mPreloadTimings)
+    if (timing.status != GlobalOptimizationProblemManager::OK_)
+      return GlobalOptimizationProblemManager::ERROR_;
+  return GlobalOptimizationProblemManager::OK_;
+}
+
+// ------------------------------------------------------------------------------------------------
+std::vector<TPreloadTiming> GlobalOptimizationProblemManager::GetPreloadTimings() const
+{
+  std::lock_guard<std::mutex> lock(mPreloadMutex);
+  return mPreloadTimings;
+}
+
+// ------------------------------------------------------------------------------------------------
+int GlobalOptimizationProblemManager::LoadProblemLibrary(const std::string& libPath)
+{
+  FreeProblemLibrary();
+
+  // задача создается из той же версии библиотеки, у которой запрашивается таблица: после
+  // ReloadLibrary кэш может уже содержать новую версию
+  mLibrary = GetLibrary(libPath);
+  mProblem = CreateProblem(mLibrary);
+  if (!mProblem)
+  {
+    mLibrary.reset();
+    return GlobalOptimizationProblemManager::ERROR_;
+  }
+
+  getProblemKernelTable* getKernelTable = mLibrary->GetKernelTableFunction();
+  if (getKernelTable)
+  {
+    mKernelTable = TProblemKernelTable();
+    mHasKernelTable = getKernelTable(mProblem.get(), PROBLEM_KERNEL_TABLE_VERSION, &mKernelTable) ==
+      PROBLEM_KERNEL_OK && mKernelTable.version >= 1 && mKernelTable.calculateFunction &&
+      mKernelTable.calculateBatch && mKernelTable.calculateAllFunctions;
+  }
+
+  return GlobalOptimizationProblemManager::OK_;
 }
 
 // ------------------------------------------------------------------------------------------------
 int GlobalOptimizationProblemManager::FreeProblemLibrary()
 {
-  if (mProblem)
-    mDestroy(mProblem);
-  if (mLibHandle)
-    FreeLibHandler();
-  mLibHandle = NULL;
-  mProblem = NULL;
-  mCreate = NULL;
-  mDestroy = NULL;
+  mProblem.reset();
+  mLibrary.reset();
+  mHasKernelTable = false;
   return GlobalOptimizationProblemManager::OK_;
 }
 
 // ------------------------------------------------------------------------------------------------
 IGlobalOptimizationProblem* GlobalOptimizationProblemManager::GetProblem() const
 {
-  if (mProblem)
-    return mProblem;
-  else
-    return NULL;
+  return mProblem.get();
+}
+
+// ------------------------------------------------------------------------------------------------
+int GlobalOptimizationProblemManager::SetSharedData(const std::string& name, const TSharedDataPtr& data)
+{
+  if (!data)
+  {
+    std::lock_guard<std::mutex> lock(mLibrariesMutex);
+    mSharedData.erase(name);
+    return GlobalOptimizationProblemManager::OK_;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mLibrariesMutex);
+    mSharedData[name] = data;
+  }
+  if (mProblem && mProblem->SetSharedData(name, data) != IGlobalOptimizationProblem::PROBLEM_OK)
+    return GlobalOptimizationProblemManager::ERROR_;
+  return GlobalOptimizationProblemManager::OK_;
+}
+
+// ------------------------------------------------------------------------------------------------
+int GlobalOptimizationProblemManager::GetProblemCapabilities(TProblemCapabilities& capabilities) const
+{
+  if (!mProblem)
+    return GlobalOptimizationProblemManager::ERROR_;
+
+  // задачи без описания свойств получают значения по умолчанию
+  mProblem->GetCapabilities(capabilities);
+  return GlobalOptimizationProblemManager::OK_;
+}
+
+// ------------------------------------------------------------------------------------------------
+int GlobalOptimizationProblemManager::GetRecommendedExecutionMode() const
+{
+  TProblemCapabilities capabilities;
+  if (GetProblemCapabilities(capabilities) != GlobalOptimizationProblemManager::OK_)
+    return GlobalOptimizationProblemManager::ERROR_;
+  return SelectExecutionMode(capabilities);
+}
+
+// ------------------------------------------------------------------------------------------------
+int GlobalOptimizationProblemManager::SelectExecutionMode(const TProblemCapabilities& capabilities)
+{
+  bool isCheap = capabilities.functionCost >= 0 && capabilities.functionCost < MIN_PARALLEL_FUNCTION_COST;
+  bool isExpensive = capabilities.functionCost >= MIN_PARALLEL_FUNCTION_COST;
+
+  if (capabilities.threadSafety == TProblemCapabilities::THREAD_REENTRANT)
+    return isCheap ? EXECUTION_INLINE : EXECUTION_THREADED;
+
+  if (capabilities.isInterpreterBacked || isExpensive)
+    return EXECUTION_OUT_OF_PROCESS;
+  return EXECUTION_INLINE;
+}
+
+// ------------------------------------------------------------------------------------------------
+const TProblemKernelTable* GlobalOptimizationProblemManager::GetKernelTable() const
+{
+  if (mProblem && mHasKernelTable)
+    return &mKernelTable;
+  return NULL;
+}
+
+// ------------------------------------------------------------------------------------------------
+int GlobalOptimizationProblemManager::CalculateFunction(const double* y, int yCount, int fNumber, double& value)
+{
+  if (!mProblem)
+    return GlobalOptimizationProblemManager::ERROR_;
+
+  if (mHasKernelTable)
+    return mKernelTable.calculateFunction(mKernelTable.state, y, yCount, fNumber, &value) == PROBLEM_KERNEL_OK ?
+      GlobalOptimizationProblemManager::OK_ : GlobalOptimizationProblemManager::ERROR_;
+
+  // метод задачи не проверяет число координат, как и функции таблицы
+  if (yCount < mProblem->GetNumberOfContinuousVariable())
+    return GlobalOptimizationProblemManager::ERROR_;
+  try
+  {
+    value = mProblem->CalculateFunctionals(y, yCount, NULL, 0, fNumber);
+  }
+  catch (...)
+  {
+    return GlobalOptimizationProblemManager::ERROR_;
+  }
+  return GlobalOptimizationProblemManager::OK_;
+}
+
+// ------------------------------------------------------------------------------------------------
+int GlobalOptimizationProblemManager::CalculateFunctionalsBatch(const double* y, int numPoints, int stride,
+  int fNumber, double* values)
+{
+  if (!mProblem)
+    return GlobalOptimizationProblemManager::ERROR_;
+
+  // один косвенный вызов на весь пакет вместо виртуального вызова на каждую точку
+  if (mHasKernelTable)
+    return mKernelTable.calculateBatch(mKernelTable.state, y, numPoints, stride, fNumber, values) ==
+      PROBLEM_KERNEL_OK ? GlobalOptimizationProblemManager::OK_ : GlobalOptimizationProblemManager::ERROR_;
+
+  try
+  {
+    if (mProblem->CalculateFunctionalsBatch(y, numPoints, stride, fNumber, values) ==
+      IGlobalOptimizationProblem::PROBLEM_OK)
+      return GlobalOptimizationProblemManager::OK_;
+  }
+  catch (...)
+  {
+  }
+  return GlobalOptimizationProblemManager::ERROR_;
+}
+
+// ------------------------------------------------------------------------------------------------
+int GlobalOptimizationProblemManager::CalculateAllFunctionals(const double* y, int yCount, double* values)
+{
+  if (!mProblem)
+    return GlobalOptimizationProblemManager::ERROR_;
+
+  if (mHasKernelTable)
+    return mKernelTable.calculateAllFunctions(mKernelTable.state, y, yCount, values) == PROBLEM_KERNEL_OK ?
+      GlobalOptimizationProblemManager::OK_ : GlobalOptimizationProblemManager::ERROR_;
+
+  try
+  {
+    if (mProblem->CalculateAllFunctionals(y, yCount, NULL, 0, values) == IGlobalOptimizationProblem::PROBLEM_OK)
+      return GlobalOptimizationProblemManager::OK_;
+  }
+  catch (...)
+  {
+  }
+  return GlobalOptimizationProblemManager::ERROR_;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -0,0 +1,208 @@
+/////////////////////////////////////////////////////////////////////////////
+//                                                                         //
+//             LOBACHEVSKY STATE UNIVERSITY OF NIZHNY NOVGOROD             //
+//                                                                         //
+//                       Copyright (c) 2025 by UNN.                        //
+//                          All Rights Reserved.                           //
+//                                                                         //
+//  File:      LipschitzEstimator.cpp                                      //
+//                                                                         //
+//  Purpose:   Source file for Lipschitz constant estimator class          //
+//                                                                         //
+//                                                                         //
+//  Author(s): Lebedev I.G.                                                //
+//                                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+#include "LipschitzEstimator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <typeinfo>
+
+// ------------------------------------------------------------------------------------------------
+TLipschitzEstimator::TLipschitzEstimator(int numberOfThreads, int numberOfPoints, double step,
+  unsigned int seed) : mNumberOfThreads(numberOfThreads), mNumberOfPoints(numberOfPoints), mStep(step),
+  mSeed(seed)
+{
+
+}
+
+// ------------------------------------------------------------------------------------------------
+std::map<std::string, double>& TLipschitzEstimator::Cache()
+{
+  static std::map<std::string, double> cache;
+  return cache;
+}
+
+// ------------------------------------------------------------------------------------------------
+std::mutex& TLipschitzEstimator::CacheMutex()
+{
+  static std::mutex cacheMutex;
+  return cacheMutex;
+}
+
+// ------------------------------------------------------------------------------------------------
+void TLipschitzEstimator::ClearCache()
+{
+  std::lock_guard<std::mutex> lock(CacheMutex());
+  Cache().clear();
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string TLipschitzEstimator::MakeKey(IGlobalOptimizationProblem* problem, int fNumber) const
+{
+  std::ostringstream key;
+  key << typeid(*problem).name() << ':' << problem->GetDimension() << ':' << problem->GetSelectedInstance() << ':'
+    << fNumber;
+  // оценки с разными настройками различаются, и более грубая не должна подменять точную
+  key.precision(17);
+  key << ':' << mNumberOfThreads << ':' << mNumberOfPoints << ':' << mStep << ':' << mSeed;
+
+  // параметры различают, например, разные скрипты одной и той же обертки python
+  std::vector<std::string> names;
+  std::vector<std::string> values;
+  problem->GetParameters(names, values);
+  for (size_t i = 0; i < names.size() && i < values.size(); i++)
+    key << ':' << names[i] << '=' << values[i];
+  return key.str();
+}
+
+// ------------------------------------------------------------------------------------------------
+double TLipschitzEstimator::SampleSlopes(IGlobalOptimizationProblem* problem, int fNumber,
+  const std::vector<double>& lower, const std::vector<double>& upper, int numberOfPairs, int batchSize,
+  unsigned int seed) const
+{
+  int n = (int)lower.size();
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+  // точки пары i лежат подряд: x начинается с points[2 * i * n], y -- сразу за ней
+  std::vector<double> points((size_t)2 * batchSize * n);
+  std::vector<double> values((size_t)2 * batchSize);
+  std::vector<int> statuses((size_t)2 * batchSize);
+  std::vector<double> distances(batchSize);
+
+  double maxSlope = -1.0;
+  for (int done = 0; done < numberOfPairs; done += batchSize)
+  {
+    int count = std::min(batchSize, numberOfPairs - done);
+    for (int i = 0; i < count; i++)
+    {
+      double* x = &points[(size_t)2 * i * n];
+      double* y = x + n;
+      double distance = 0.0;
+      for (int j = 0; j < n; j++)
+      {
+        double width = upper[j] - lower[j];
+        double h = mStep * width * (2.0 * uniform(generator) - 1.0);
+        x[j] = lower[j] + width * uniform(generator);
+        y[j] = x[j] + h;
+        if (y[j] < lower[j] || y[j] > upper[j])
+          y[j] = x[j] - h;
+        distance += (y[j] - x[j]) * (y[j] - x[j]);
+      }
+      distances[i] = std::sqrt(distance);
+    }
+
+    if (problem->TryCalculateFunctionalsBatch(points.data(), 2 * count, n, fNumber, values.data(),
+      statuses.data()) != IGlobalOptimizationProblem::PROBLEM_OK)
+      continue;
+
+    // пары, в которых функция не вычисляется, не участвуют в оценке
+    for (int i = 0; i < count; i++)
+    {
+      if (distances[i] > 0 && statuses[2 * i] == IGlobalOptimizationProblem::FUNCTIONAL_OK &&
+        statuses[2 * i + 1] == IGlobalOptimizationProblem::FUNCTIONAL_OK)
+        maxSlope = std::max(maxSlope, std::fabs(values[2 * i + 1] - values[2 * i]) / distances[i]);
+    }
+  }
+  return maxSlope;
+}
+
+// ------------------------------------------------------------------------------------------------
+int TLipschitzEstimator::Estimate(IGlobalOptimizationProblem* problem, int fNumber, double& constant) const
+{
+  if (!problem || fNumber < 0 || fNumber >= problem->GetNumberOfFunctions())
+    return TLipschitzEstimator::ERROR_;
+
+  if (problem->GetLipschitzConstant(fNumber, constant) == IGlobalOptimizationProblem::PROBLEM_OK)
+    return TLipschitzEstimator::OK_;
+
+  // пакетное вычисление не передает дискретные параметры
+  if (problem->GetNumberOfDiscreteVariable() > 0)
+    return TLipschitzEstimator::ERROR_;
+
+  std::string key = MakeKey(problem, fNumber);
+  {
+    std::lock_guard<std::mutex> lock(CacheMutex());
+    auto it = Cache().find(key);
+    if (it != Cache().end())
+    {
+      constant = it->second;
+      return TLipschitzEstimator::OK_;
+    }
+  }
+
+  int n = problem->GetNumberOfContinuousVariable();
+  std::vector<double> lower(n);
+  std::vector<double> upper(n);
+  problem->GetBounds(lower, upper);
+  if (n <= 0 || (int)lower.size() < n || (int)upper.size() < n)
+    return TLipschitzEstimator::ERROR_;
+  lower.resize(n);
+  upper.resize(n);
+
+  TProblemCapabilities capabilities;
+  problem->GetCapabilities(capabilities);
+
+  int numberOfThreads = mNumberOfThreads > 0 ? mNumberOfThreads : (int)std::thread::hardware_concurrency();
+  numberOfThreads = std::max(1, std::min(numberOfThreads, mNumberOfPoints));
+  int batchSize = std::max(1, capabilities.preferredBatchSize / 2);
+
+  // задачи, не допускающие параллельных вызовов, вычисляются в каждом потоке через свою копию
+  std::vector<IGlobalOptimizationProblem*> problems(1, problem);
+  std::vector<std::unique_ptr<IGlobalOptimizationProblem>> clones;
+  for (int t = 1; t < numberOfThreads; t++)
+  {
+    if (capabilities.threadSafety == TProblemCapabilities::THREAD_REENTRANT)
+      problems.push_back(problem);
+    else
+    {
+      IGlobalOptimizationProblem* clone = problem->Clone();
+      if (!clone)
+        break;
+      clones.emplace_back(clone);
+      problems.push_back(clone);
+    }
+  }
+  numberOfThreads = (int)problems.size();
+
+  std::vector<double> slopes(numberOfThreads, -1.0);
+  auto sample = [&](int t)
+  {
+    int numberOfPairs = mNumberOfPoints / numberOfThreads + (t < mNumberOfPoints % numberOfThreads ? 1 : 0);
+    slopes[t] = SampleSlopes(problems[t], fNumber, lower, upper, numberOfPairs, batchSize, mSeed + t);
+  };
+
+  std::vector<std::thread> threads;
+  for (int t = 1; t < numberOfThreads; t++)
+    threads.emplace_back(sample, t);
+  sample(0);
+  for (auto& thread : threads)
+    thread.join();
+
+  double maxSlope = *std::max_element(slopes.begin(), slopes.end());
+  if (maxSlope < 0)
+    return TLipschitzEstimator::ERROR_;
+
+  constant = maxSlope;
+  std::lock_guard<std::mutex> lock(CacheMutex());
+  Cache()[key] = constant;
+  return TLipschitzEstimator::OK_;
+}
+// - end of file ----------------------------------------------------------------------------------
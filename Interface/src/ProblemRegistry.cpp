@@ -0,0 +1,315 @@
+/////////////////////////////////////////////////////////////////////////////
+//                                                                         //
+//             LOBACHEVSKY STATE UNIVERSITY OF NIZHNY NOVGOROD             //
+//                                                                         //
+//                       Copyright (c) 2025 by UNN.                        //
+//                          All Rights Reserved.                           //
+//                                                                         //
+//  File:      ProblemRegistry.cpp                                         //
+//                                                                         //
+//  Purpose:   Source file for concurrent problem registry class           //
+//                                                                         //
+//                                                                         //
+//  Author(s): Lebedev I.G.                                                //
+//                                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+#include "ProblemRegistry.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+// ------------------------------------------------------------------------------------------------
+TProblemRegistry::TReader::TReader(const TProblemRegistry& registry) : mRegistry(registry)
+{
+  // если эпоха сменилась до отметки, писатель мог не увидеть читателя, поэтому отметка повторяется
+  for (;;)
+  {
+    unsigned int epoch = registry.mEpoch.load();
+    mReaders = &registry.mReaders[epoch % 2];
+    mReaders->fetch_add(1);
+    if (registry.mEpoch.load() == epoch)
+      break;
+    mReaders->fetch_sub(1);
+  }
+}
+
+// ------------------------------------------------------------------------------------------------
+TProblemRegistry::TReader::~TReader()
+{
+  mReaders->fetch_sub(1);
+}
+
+// ------------------------------------------------------------------------------------------------
+const TProblemRegistry::TSnapshot* TProblemRegistry::TReader::Get() const
+{
+  return mRegistry.mSnapshot.load();
+}
+
+// ------------------------------------------------------------------------------------------------
+TProblemRegistry::TProblemRegistry() : mSnapshot(new TSnapshot()), mEpoch(0), mNextHandle(1)
+{
+  mReaders[0] = 0;
+  mReaders[1] = 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+TProblemRegistry::~TProblemRegistry()
+{
+  delete mSnapshot.load();
+}
+
+// ------------------------------------------------------------------------------------------------
+void TProblemRegistry::Publish(std::unique_ptr<const TSnapshot> snapshot)
+{
+  std::unique_ptr<const TSnapshot> old(mSnapshot.exchange(snapshot.release()));
+  // читатели новой эпохи получат уже новый снимок, старый мог быть прочитан только в прежней эпохе
+  unsigned int epoch = mEpoch.fetch_add(1);
+  while (mReaders[epoch % 2].load() != 0)
+    std::this_thread::yield();
+}
+
+// ------------------------------------------------------------------------------------------------
+TProblemRegistry::THandle TProblemRegistry::Insert(TEntry entry)
+{
+  std::lock_guard<std::mutex> lock(mWriteMutex);
+  const TSnapshot* current = mSnapshot.load();
+  if (current->handles.count(entry.name) > 0)
+    return 0;
+
+  // читатели продолжают работать со старым снимком, пока новый не подменит его
+  std::unique_ptr<TSnapshot> snapshot(new TSnapshot(*current));
+  THandle handle = mNextHandle++;
+  snapshot->handles[entry.name] = handle;
+  snapshot->entries[handle] = std::move(entry);
+  Publish(std::move(snapshot));
+  return handle;
+}
+
+// ------------------------------------------------------------------------------------------------
+TProblemRegistry::THandle TProblemRegistry::Register(const std::string& name, const TProblemPtr& problem)
+{
+  if (!problem)
+    return 0;
+
+  TEntry entry;
+  entry.name = name;
+  entry.problem = problem;
+  return Insert(std::move(entry));
+}
+
+// ------------------------------------------------------------------------------------------------
+TProblemRegistry::THandle TProblemRegistry::Create(const std::string& name, const std::string& libPath,
+  const TSetup& setup)
+{
+  if (GetHandle(name) != 0)
+    return 0;
+
+  TEntry entry;
+  entry.name = name;
+  entry.libPath = libPath;
+  entry.setup = setup;
+  // версия запоминается до создания задачи: при одновременной перезагрузке она может оказаться
+  // старше задачи, и следующая перезагрузка лишь пересоздаст задачу
+  entry.library = mManager.FindLibrary(libPath);
+  entry.problem = mManager.CreateProblem(libPath);
+  if (!entry.problem)
+    return 0;
+  if (!entry.library)
+    entry.library = mManager.FindLibrary(libPath);
+  int result = setup ? setup(entry.problem.get()) : entry.problem->Initialize();
+  if (result != IGlobalOptimizationProblem::PROBLEM_OK)
+    return 0;
+  return Insert(std::move(entry));
+}
+
+// ------------------------------------------------------------------------------------------------
+TProblemPtr TProblemRegistry::Find(const std::string& name) const
+{
+  TReader reader(*this);
+  const TSnapshot* snapshot = reader.Get();
+  auto it = snapshot->handles.find(name);
+  if (it == snapshot->handles.end())
+    return TProblemPtr();
+  return snapshot->entries.at(it->second).problem;
+}
+
+// ------------------------------------------------------------------------------------------------
+TProblemPtr TProblemRegistry::Get(THandle handle) const
+{
+  TReader reader(*this);
+  const TSnapshot* snapshot = reader.Get();
+  auto it = snapshot->entries.find(handle);
+  if (it == snapshot->entries.end())
+    return TProblemPtr();
+  return it->second.problem;
+}
+
+// ------------------------------------------------------------------------------------------------
+TProblemRegistry::THandle TProblemRegistry::GetHandle(const std::string& name) const
+{
+  TReader reader(*this);
+  const TSnapshot* snapshot = reader.Get();
+  auto it = snapshot->handles.find(name);
+  return it == snapshot->handles.end() ? 0 : it->second;
+}
+
+// ------------------------------------------------------------------------------------------------
+int TProblemRegistry::Remove(const std::string& name)
+{
+  std::lock_guard<std::mutex> lock(mWriteMutex);
+  const TSnapshot* current = mSnapshot.load();
+  auto it = current->handles.find(name);
+  if (it == current->handles.end())
+    return TProblemRegistry::ERROR_;
+
+  std::unique_ptr<TSnapshot> snapshot(new TSnapshot(*current));
+  snapshot->entries.erase(it->second);
+  snapshot->handles.erase(name);
+  Publish(std::move(snapshot));
+  return TProblemRegistry::OK_;
+}
+
+// ------------------------------------------------------------------------------------------------
+int TProblemRegistry::Remove(THandle handle)
+{
+  std::string name;
+  {
+    TReader reader(*this);
+    const TSnapshot* snapshot = reader.Get();
+    auto it = snapshot->entries.find(handle);
+    if (it == snapshot->entries.end())
+      return TProblemRegistry::ERROR_;
+    name = it->second.name;
+  }
+
+  std::lock_guard<std::mutex> lock(mWriteMutex);
+  const TSnapshot* current = mSnapshot.load();
+  // имя могло быть удалено и занято другой задачей, пока мьютекс не был захвачен
+  auto it = current->handles.find(name);
+  if (it == current->handles.end() || it->second != handle)
+    return TProblemRegistry::ERROR_;
+
+  std::unique_ptr<TSnapshot> snapshot(new TSnapshot(*current));
+  snapshot->entries.erase(handle);
+  snapshot->handles.erase(name);
+  Publish(std::move(snapshot));
+  return TProblemRegistry::OK_;
+}
+
+// ------------------------------------------------------------------------------------------------
+int TProblemRegistry::Reload(const std::string& name, bool force)
+{
+  TEntry entry;
+  THandle handle;
+  {
+    TReader reader(*this);
+    const TSnapshot* snapshot = reader.Get();
+    auto it = snapshot->handles.find(name);
+    if (it == snapshot->handles.end())
+      return TProblemRegistry::ERROR_;
+    handle = it->second;
+    entry = snapshot->entries.at(handle);
+  }
+  if (entry.libPath.empty())
+    return TProblemRegistry::ERROR_;
+
+  if (mManager.IsLibraryModified(entry.libPath) &&
+    mManager.ReloadLibrary(entry.libPath) != GlobalOptimizationProblemManager::OK_)
+    return TProblemRegistry::ERROR_;
+  std::shared_ptr<const TProblemLibrary> library = mManager.FindLibrary(entry.libPath);
+  if (!force && library == entry.library)
+    return TProblemRegistry::NOT_MODIFIED_;
+
+  // новая версия создается и инициализируется без блокировки, старая тем временем продолжает работать
+  TProblemPtr old = entry.problem;
+  entry.library = library;
+  entry.problem = mManager.CreateProblem(entry.libPath);
+  if (!entry.problem)
+    return TProblemRegistry::ERROR_;
+  int result = entry.setup ? entry.setup(entry.problem.get()) : entry.problem->Initialize();
+  if (result != IGlobalOptimizationProblem::PROBLEM_OK)
+    return TProblemRegistry::ERROR_;
+
+  std::lock_guard<std::mutex> lock(mWriteMutex);
+  const TSnapshot* current = mSnapshot.load();
+  auto it = current->entries.find(handle);
+  // задачу могли удалить или перезагрузить в другом потоке
+  if (it == current->entries.end() || it->second.problem != old)
+    return TProblemRegistry::ERROR_;
+
+  std::unique_ptr<TSnapshot> snapshot(new TSnapshot(*current));
+  snapshot->entries[handle] = std::move(entry);
+  Publish(std::move(snapshot));
+
+  std::vector<std::weak_ptr<IGlobalOptimizationProblem>>& retired = mRetired[name];
+  retired.erase(std::remove_if(retired.begin(), retired.end(),
+    [](const std::weak_ptr<IGlobalOptimizationProblem>& problem) { return problem.expired(); }), retired.end());
+  retired.push_back(old);
+  return TProblemRegistry::OK_;
+}
+
+// ------------------------------------------------------------------------------------------------
+int TProblemRegistry::ReloadModified()
+{
+  int count = 0;
+  for (auto& name : GetNames())
+    if (Reload(name) == TProblemRegistry::OK_)
+      count++;
+  return count;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool TProblemRegistry::WaitForDrain(const std::string& name, double timeout)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (;;)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mWriteMutex);
+      auto it = mRetired.find(name);
+      if (it == mRetired.end())
+        return true;
+      std::vector<std::weak_ptr<IGlobalOptimizationProblem>>& retired = it->second;
+      retired.erase(std::remove_if(retired.begin(), retired.end(),
+        [](const std::weak_ptr<IGlobalOptimizationProblem>& problem) { return problem.expired(); }), retired.end());
+      if (retired.empty())
+      {
+        mRetired.erase(it);
+        return true;
+      }
+    }
+
+    // старые версии освобождают вычисления, о завершении которых реестр не знает, поэтому их ждут опросом
+    if (timeout >= 0 && std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() >= timeout)
+      return false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+// ------------------------------------------------------------------------------------------------
+std::vector<std::string> TProblemRegistry::GetNames() const
+{
+  TReader reader(*this);
+  const TSnapshot* snapshot = reader.Get();
+  std::vector<std::string> names;
+  names.reserve(snapshot->handles.size());
+  for (auto& handle : snapshot->handles)
+    names.push_back(handle.first);
+  return names;
+}
+
+// ------------------------------------------------------------------------------------------------
+int TProblemRegistry::GetNumberOfProblems() const
+{
+  TReader reader(*this);
+  return (int)reader.Get()->handles.size();
+}
+
+// ------------------------------------------------------------------------------------------------
+GlobalOptimizationProblemManager& TProblemRegistry::GetManager()
+{
+  return mManager;
+}
+// - end of file ----------------------------------------------------------------------------------
@@ -1,4 +1,5 @@
 ﻿#include "X2.h"
+#include "StaticProblemRegistry.h"
 
 #define _USE_MATH_DEFINES
 #include <math.h>
@@ -31,6 +32,9 @@ double X_magic[] = {
 
 
 double minVal = 0.0;
+
+/// Число точек в блоке, для которого коэффициенты функции читаются один раз
+static const int INSTANCES_POINT_BLOCK = 64;
 // ------------------------------------------------------------------------------------------------
 X2Problem::X2Problem()
 {
@@ -39,6 +43,8 @@ X2Problem::X2Problem()
   function_number = 1;
   mLeftBorder = -2.2;
   mRightBorder = 1.8;
+  mCoefficients = X_magic;
+  mNumberOfCoefficients = sizeof(X_magic) / sizeof(X_magic[0]);
 
 }
 
@@ -63,7 +69,7 @@ int X2Problem::GetDimension() const
 // ------------------------------------------------------------------------------------------------
 int X2Problem::Initialize()
 {
-  if (mDimension > 0)
+  if (mDimension > 0 && (size_t)function_number * mDimension * 2 <= mNumberOfCoefficients)
   {
     mIsInitialized = true;
     return IGlobalOptimizationProblem::PROBLEM_OK;
@@ -90,14 +96,14 @@ int X2Problem::GetOptimumValue(double& value) const
   value = 0.0;
   int fn = function_number;
   for (int j = 0; j < mDimension; j++)
-    if (X_magic[(fn - 1) * mDimension * 2 + j * 2 + 1] != 0)
-      value += -X_magic[(fn - 1) * mDimension * 2 + j * 2 + 0] * X_magic[(fn - 1) * mDimension * 2 + j * 2 + 0]
-      / (4.0 * X_magic[(fn - 1) * mDimension * 2 + j * 2 + 1]);
+    if (mCoefficients[(fn - 1) * mDimension * 2 + j * 2 + 1] != 0)
+      value += -mCoefficients[(fn - 1) * mDimension * 2 + j * 2 + 0] * mCoefficients[(fn - 1) * mDimension * 2 + j * 2 + 0]
+      / (4.0 * mCoefficients[(fn - 1) * mDimension * 2 + j * 2 + 1]);
     else
-      if (X_magic[(fn - 1) * mDimension * 2 + j * 2 + 0] > 0)
-        value += X_magic[(fn - 1) * mDimension * 2 + j * 2 + 0] * mLeftBorder;
+      if (mCoefficients[(fn - 1) * mDimension * 2 + j * 2 + 0] > 0)
+        value += mCoefficients[(fn - 1) * mDimension * 2 + j * 2 + 0] * mLeftBorder;
       else
-        value += X_magic[(fn - 1) * mDimension * 2 + j * 2 + 0] * mRightBorder;
+        value += mCoefficients[(fn - 1) * mDimension * 2 + j * 2 + 0] * mRightBorder;
 
   return IGlobalOptimizationProblem::PROBLEM_OK;
 }
@@ -113,9 +119,9 @@ int X2Problem::GetOptimumPoint(std::vector<double>& point, std::vector<std::stri
   for (int i = 0; i < mDimension; i++) 
   {
 
-    if (X_magic[(function_number - 1) * mDimension * 2 + i * 2 + 1] == 0) 
+    if (mCoefficients[(function_number - 1) * mDimension * 2 + i * 2 + 1] == 0) 
     {
-      if (X_magic[(function_number - 1) * mDimension * 2 + i * 2 + 0] > 0) 
+      if (mCoefficients[(function_number - 1) * mDimension * 2 + i * 2 + 0] > 0) 
       {
         min_ = mLeftBorder;
       }
@@ -126,8 +132,8 @@ int X2Problem::GetOptimumPoint(std::vector<double>& point, std::vector<std::stri
       point[i] = min_;
     }
     else {
-      min_ = -X_magic[(function_number - 1) * mDimension * 2 + i * 2 + 0]
-        / (2 * X_magic[(function_number - 1) * mDimension * 2 + i * 2 + 1]);
+      min_ = -mCoefficients[(function_number - 1) * mDimension * 2 + i * 2 + 0]
+        / (2 * mCoefficients[(function_number - 1) * mDimension * 2 + i * 2 + 1]);
       if (min_ < mLeftBorder)
         point[i] = mLeftBorder;
       else if (min_ > mRightBorder)
@@ -157,15 +163,257 @@ int X2Problem::GetNumberOfCriterions() const
   return 1;
 }
 
+// ------------------------------------------------------------------------------------------------
+int X2Problem::GetCapabilities(TProblemCapabilities& capabilities) const
+{
+  capabilities = TProblemCapabilities();
+  capabilities.threadSafety = TProblemCapabilities::THREAD_REENTRANT;
+  capabilities.hasNativeBatch = true;
+  capabilities.isDeterministic = true;
+  // несколько умножений на координату
+  capabilities.functionCost = 1e-9 * mDimension;
+  capabilities.preferredBatchSize = 256;
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int X2Problem::GetLipschitzConstant(int fNumber, double& constant) const
+{
+  if (!mIsInitialized || fNumber < 0 || fNumber >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_UNDEFINED;
+
+  // функция сепарабельна, производная слагаемого a + 2 b x линейна и достигает
+  // максимума модуля на границе, поэтому оценка точная
+  double sum = 0.;
+  const double* coeff = mCoefficients + (function_number - 1) * mDimension * 2;
+  for (int j = 0; j < mDimension; j++)
+  {
+    double dl = fabs(coeff[j * 2 + 0] + 2.0 * coeff[j * 2 + 1] * mLeftBorder);
+    double du = fabs(coeff[j * 2 + 0] + 2.0 * coeff[j * 2 + 1] * mRightBorder);
+    double d = std::max(dl, du);
+    sum += d * d;
+  }
+  constant = sqrt(sum);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+
+// ------------------------------------------------------------------------------------------------
+int X2Problem::SetSharedData(const std::string& name, const TSharedDataPtr& data)
+{
+  if (name != "coefficients")
+    return IGlobalOptimizationProblem::PROBLEM_UNDEFINED;
+  if (!data || !data->GetData<double>())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+  // у инициализированной задачи размерность уже известна
+  if (mIsInitialized && (size_t)function_number * mDimension * 2 > data->GetNumberOfElements())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  mSharedCoefficients = data;
+  mCoefficients = data->GetData<double>();
+  mNumberOfCoefficients = data->GetNumberOfElements();
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+IGlobalOptimizationProblem* X2Problem::Clone() const
+{
+  return new X2Problem(*this);
+}
+
+// ------------------------------------------------------------------------------------------------
+int X2Problem::GetNumberOfInstances() const
+{
+  return (int)(mNumberOfCoefficients / ((size_t)mDimension * 2));
+}
+
+// ------------------------------------------------------------------------------------------------
+int X2Problem::SelectInstance(int index)
+{
+  if (index < 0 || index >= GetNumberOfInstances())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+  function_number = index + 1;
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int X2Problem::GetSelectedInstance() const
+{
+  return function_number - 1;
+}
+
+// ------------------------------------------------------------------------------------------------
+int X2Problem::CalculateInstancesBatch(const int* instances, int numInstances, const double* y, int numPoints,
+  int stride, int fNumber, double* values)
+{
+  if (stride == 0)
+    stride = mDimension;
+  if (stride < mDimension || numPoints < 0 || numInstances < 0)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+  int numberOfInstances = GetNumberOfInstances();
+  for (int m = 0; m < numInstances; m++)
+    if (instances[m] < 0 || instances[m] >= numberOfInstances)
+      return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  // блок точек остается в кэше, пока по нему проходят коэффициенты всех функций
+  for (int begin = 0; begin < numPoints; begin += INSTANCES_POINT_BLOCK)
+  {
+    int end = std::min(begin + INSTANCES_POINT_BLOCK, numPoints);
+    for (int m = 0; m < numInstances; m++)
+    {
+      const double* coeff = mCoefficients + (size_t)instances[m] * mDimension * 2;
+      double* instanceValues = values + (size_t)m * numPoints;
+      int i = begin;
+      for (; i + 4 <= end; i += 4)
+        CalculateFunction4(coeff, y + (size_t)i * stride, stride, instanceValues + i);
+      for (; i < end; i++)
+        instanceValues[i] = CalculateFunction(coeff, y + (size_t)i * stride);
+    }
+  }
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline double X2Problem::CalculateFunction(const double* coeff, const double* x) const
+{
+  double sum = 0.;
+  for (int j = 0; j < mDimension; j++)
+    sum += coeff[j * 2 + 0] * x[j] + coeff[j * 2 + 1] * x[j] * x[j];
+
+  return sum;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline void X2Problem::CalculateFunction4(const double* coeff, const double* x, int stride, double* values) const
+{
+  // четыре независимые суммы не ждут друг друга; порядок сложения в каждой тот же, что в CalculateFunction,
+  // но компилятор может по-разному объединять умножение и сложение (FMA), поэтому значения
+  // могут отличаться от CalculateFunction в последнем знаке
+  const double* x0 = x;
+  const double* x1 = x0 + stride;
+  const double* x2 = x1 + stride;
+  const double* x3 = x2 + stride;
+  double sum0 = 0., sum1 = 0., sum2 = 0., sum3 = 0.;
+  for (int j = 0; j < mDimension; j++)
+  {
+    double a = coeff[j * 2 + 0];
+    double b = coeff[j * 2 + 1];
+    sum0 += a * x0[j] + b * x0[j] * x0[j];
+    sum1 += a * x1[j] + b * x1[j] * x1[j];
+    sum2 += a * x2[j] + b * x2[j] * x2[j];
+    sum3 += a * x3[j] + b * x3[j] * x3[j];
+  }
+  values[0] = sum0;
+  values[1] = sum1;
+  values[2] = sum2;
+  values[3] = sum3;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline double X2Problem::CalculateFunction(const double* x, int fNumber) const
+{
+  return CalculateFunction(mCoefficients + (function_number - 1) * mDimension * 2, x);
+}
 
 // ------------------------------------------------------------------------------------------------
 double X2Problem::CalculateFunctionals(const std::vector<double>& x, std::vector<std::string>& u, int fNumber)
+{
+  return CalculateFunction(x.data(), fNumber);
+}
+
+// ------------------------------------------------------------------------------------------------
+double X2Problem::CalculateFunctionals(const double* y, int yCount, const std::string* u, int uCount, int fNumber)
+{
+  return CalculateFunction(y, fNumber);
+}
+
+// ------------------------------------------------------------------------------------------------
+int X2Problem::CalculateAllFunctionals(const double* y, int yCount, const std::string* u, int uCount, double* values)
+{
+  if (yCount < mDimension)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  int numberOfFunctions = GetNumberOfFunctions();
+  for (int i = 0; i < numberOfFunctions; i++)
+    values[i] = CalculateFunction(y, i);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int X2Problem::CalculateFunctionalsBatch(const double* y, int numPoints, int stride, int fNumber, double* values)
+{
+  if (stride == 0)
+    stride = mDimension;
+  if (stride < mDimension || numPoints < 0)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  for (int i = 0; i < numPoints; i++)
+    values[i] = CalculateFunction(y + (size_t)i * stride, fNumber);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int X2Problem::CalculateFunctionalGradient(const double* y, int yCount, int fNumber, double& value, double* gradient)
+{
+  if (yCount < mDimension || fNumber < 0 || fNumber >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  value = CalculateGradient(y, fNumber, gradient);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int X2Problem::CalculateFunctionalGradientBatch(const double* y, int numPoints, int stride, int fNumber,
+  double* values, double* gradients)
+{
+  if (stride == 0)
+    stride = mDimension;
+  if (stride < mDimension || numPoints < 0 || fNumber < 0 || fNumber >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  for (int i = 0; i < numPoints; i++)
+    values[i] = CalculateGradient(y + (size_t)i * stride, fNumber, gradients + (size_t)i * mDimension);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int X2Problem::CalculateFunctionalBounds(const double* lower, const double* upper, int yCount, int fNumber,
+  double& fLower, double& fUpper)
+{
+  if (yCount < mDimension || fNumber < 0 || fNumber >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+  for (int j = 0; j < mDimension; j++)
+    if (!(lower[j] <= upper[j]))
+      return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  TInterval bounds = CalculateFunctionBounds(lower, upper, fNumber);
+  fLower = bounds.lower;
+  fUpper = bounds.upper;
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline TInterval X2Problem::CalculateFunctionBounds(const double* lower, const double* upper, int fNumber) const
+{
+  // каждое слагаемое -- квадратный трехчлен от одной координаты, его область значений точная
+  TInterval sum = 0.;
+  const double* coeff = mCoefficients + (function_number - 1) * mDimension * 2;
+  for (int j = 0; j < mDimension; j++)
+    sum = sum + Quadratic(TInterval(lower[j], upper[j]), coeff[j * 2 + 0], coeff[j * 2 + 1]);
+
+  return sum;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline double X2Problem::CalculateGradient(const double* x, int fNumber, double* gradient) const
 {
   double sum = 0.;
-  int fn = function_number;
+  const double* coeff = mCoefficients + (function_number - 1) * mDimension * 2;
   for (int j = 0; j < mDimension; j++)
-    sum += X_magic[(fn - 1) * mDimension * 2 + j * 2 + 0] * (x[j])
-    + X_magic[(fn - 1) * mDimension * 2 + j * 2 + 1] * x[j] * x[j];
+  {
+    sum += coeff[j * 2 + 0] * x[j] + coeff[j * 2 + 1] * x[j] * x[j];
+    gradient[j] = coeff[j * 2 + 0] + 2.0 * coeff[j * 2 + 1] * x[j];
+  }
 
   return sum;
 }
@@ -177,14 +425,23 @@ X2Problem::~X2Problem()
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API IGlobalOptimizationProblem* create()
+LIB_EXPORT_API IGlobalOptimizationProblem* PROBLEM_EXPORT_NAME(create)()
 {
   return new X2Problem();
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API void destroy(IGlobalOptimizationProblem* ptr)
+LIB_EXPORT_API void PROBLEM_EXPORT_NAME(destroy)(IGlobalOptimizationProblem* ptr)
 {
   delete ptr;
 }
+
+// ------------------------------------------------------------------------------------------------
+LIB_EXPORT_API int PROBLEM_EXPORT_NAME(getKernelTable)(void* problem, int version, TProblemKernelTable* table)
+{
+  return TProblemKernels<X2Problem>::Fill(problem, version, table);
+}
+
+// ------------------------------------------------------------------------------------------------
+REGISTER_STATIC_PROBLEM(PROBLEM_EXPORT_NAME(getKernelTable))
 // - end of file ----------------------------------------------------------------------------------
@@ -8,6 +8,8 @@
 #include <fstream>
 
 #include "IGlobalOptimizationProblem.h"
+#include "ProblemKernelTable.h"
+#include "Interval.h"
 
 /// Задача a*x^2+b*x+c
 class X2Problem : public IGlobalOptimizationProblem
@@ -27,6 +29,24 @@ protected:
   /// Верхняя граница области поиска
   double mRightBorder;
 
+  /// Коэффициенты функций: для функции с номером function_number и координаты j пара (b, a) функции b x + a x^2
+  const double* mCoefficients;
+  /// Число элементов в mCoefficients
+  size_t mNumberOfCoefficients;
+  /// Общие данные, из которых взяты коэффициенты, пусто -- встроенная таблица
+  TSharedDataPtr mSharedCoefficients;
+
+  /// Вычисляет значение функции с номером fNumber в точке x без виртуальных вызовов
+  double CalculateFunction(const double* x, int fNumber) const;
+  /// Вычисляет функцию с коэффициентами coeff в точке x
+  double CalculateFunction(const double* coeff, const double* x) const;
+  /// Вычисляет функцию с коэффициентами coeff в четырех точках, точка k начинается с x[k * stride]
+  void CalculateFunction4(const double* coeff, const double* x, int stride, double* values) const;
+  /// Вычисляет значение функции с номером fNumber и записывает ее градиент в gradient
+  double CalculateGradient(const double* x, int fNumber, double* gradient) const;
+  /// Вычисляет интервальную оценку функции с номером fNumber на параллелепипеде [lower, upper]
+  TInterval CalculateFunctionBounds(const double* lower, const double* upper, int fNumber) const;
+
 public:
 
   X2Problem();
@@ -69,6 +89,61 @@ public:
   \return Число критериев
   */
   virtual int GetNumberOfCriterions() const;
+
+  /** Метод возвращает вычислительные свойства задачи
+  \param[out] capabilities свойства задачи
+  \return Код ошибки (#PROBLEM_OK)
+  */
+  virtual int GetCapabilities(TProblemCapabilities& capabilities) const;
+
+  /** Метод возвращает верхнюю оценку константы Липшица функции в области поиска
+  \param[in] fNumber Номер функции
+  \param[out] constant оценка константы Липшица
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_UNDEFINED)
+  */
+  virtual int GetLipschitzConstant(int fNumber, double& constant) const;
+
+  /** Метод заменяет встроенную таблицу коэффициентов общими данными
+
+  Принимаются данные с именем "coefficients" -- массив double, в котором функции с номером
+  function_number соответствуют 2 * размерность элементов, начиная с (function_number - 1) * 2 * размерность
+  \param[in] name имя данных
+  \param[in] data данные
+  \return Код ошибки (#PROBLEM_OK, #PROBLEM_ERROR или #PROBLEM_UNDEFINED для неизвестного имени)
+  */
+  virtual int SetSharedData(const std::string& name, const TSharedDataPtr& data);
+
+  /** Метод создает независимую копию задачи
+  \return Указатель на копию
+  */
+  virtual IGlobalOptimizationProblem* Clone() const;
+
+  /** Метод возвращает число функций в таблице коэффициентов при текущей размерности
+  \return Число функций семейства
+  */
+  virtual int GetNumberOfInstances() const;
+  /** Метод выбирает функцию семейства, function_number становится равным index + 1
+  \param[in] index номер функции
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int SelectInstance(int index);
+  /// Метод возвращает номер текущей функции семейства, function_number - 1
+  virtual int GetSelectedInstance() const;
+
+  /** Метод, вычисляющий несколько функций семейства в одних и тех же точках
+
+  Точки обрабатываются блоками, и коэффициенты каждой функции читаются один раз на блок точек
+  \param[in] instances номера функций семейства
+  \param[in] numInstances количество функций
+  \param[in] y массив непрерывных координат точек, координаты точки i начинаются с y[i * stride]
+  \param[in] numPoints количество точек
+  \param[in] stride расстояние между началами соседних точек, 0 -- плотная упаковка
+  \param[in] fNumber Номер вычисляемой функции
+  \param[out] values массив из numInstances * numPoints элементов, значения функции m -- с values[m * numPoints]
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int CalculateInstancesBatch(const int* instances, int numInstances, const double* y, int numPoints,
+    int stride, int fNumber, double* values);
   /** Метод, вычисляющий функции задачи
 
   \param[in] y непрерывные координаты точки, в которой необходимо вычислить значение
@@ -79,11 +154,82 @@ public:
   */
   virtual double CalculateFunctionals(const std::vector<double>& x, std::vector<std::string>& u, int fNumber);
 
+  /** Метод, вычисляющий функции задачи без создания временных векторов
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки
+  \param[in] uCount число дискретных координат
+  \param[in] fNumber Номер вычисляемой функции
+  \return Значение функции с указанным номером
+  */
+  virtual double CalculateFunctionals(const double* y, int yCount, const std::string* u, int uCount, int fNumber);
+
+  /** Метод, вычисляющий все функции задачи в буфер вызывающей стороны
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки
+  \param[in] uCount число дискретных координат
+  \param[out] values массив из #GetNumberOfFunctions() элементов для значений функций
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int CalculateAllFunctionals(const double* y, int yCount, const std::string* u, int uCount, double* values);
+
+  /** Метод, вычисляющий функцию задачи сразу в нескольких точках
+
+  \param[in] y массив непрерывных координат точек, координаты точки i начинаются с y[i * stride]
+  \param[in] numPoints количество точек
+  \param[in] stride расстояние между началами соседних точек, 0 -- плотная упаковка
+  \param[in] fNumber Номер вычисляемой функции
+  \param[out] values массив из numPoints элементов для значений функции
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int CalculateFunctionalsBatch(const double* y, int numPoints, int stride, int fNumber, double* values);
+
+  /** Метод, вычисляющий значение и градиент функции задачи за один проход
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] fNumber Номер вычисляемой функции
+  \param[out] value значение функции
+  \param[out] gradient массив из #GetDimension() элементов для градиента
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int CalculateFunctionalGradient(const double* y, int yCount, int fNumber, double& value, double* gradient);
+
+  /** Метод, вычисляющий значения и градиенты функции задачи сразу в нескольких точках
+
+  \param[in] y массив непрерывных координат точек, координаты точки i начинаются с y[i * stride]
+  \param[in] numPoints количество точек
+  \param[in] stride расстояние между началами соседних точек, 0 -- плотная упаковка
+  \param[in] fNumber Номер вычисляемой функции
+  \param[out] values массив из numPoints элементов для значений функции
+  \param[out] gradients массив из numPoints * #GetDimension() элементов для градиентов
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int CalculateFunctionalGradientBatch(const double* y, int numPoints, int stride, int fNumber,
+    double* values, double* gradients);
+
+  /** Метод, вычисляющий гарантированную оценку значений функции на параллелепипеде
+
+  \param[in] lower нижние границы параллелепипеда
+  \param[in] upper верхние границы параллелепипеда
+  \param[in] yCount число непрерывных координат
+  \param[in] fNumber Номер функции
+  \param[out] fLower нижняя оценка значений функции
+  \param[out] fUpper верхняя оценка значений функции
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int CalculateFunctionalBounds(const double* lower, const double* upper, int yCount, int fNumber,
+    double& fLower, double& fUpper);
+
   ~X2Problem();
 };
 
-extern "C" LIB_EXPORT_API IGlobalOptimizationProblem* create();
-extern "C" LIB_EXPORT_API void destroy(IGlobalOptimizationProblem* ptr);
+extern "C" LIB_EXPORT_API IGlobalOptimizationProblem* PROBLEM_EXPORT_NAME(create)();
+extern "C" LIB_EXPORT_API void PROBLEM_EXPORT_NAME(destroy)(IGlobalOptimizationProblem* ptr);
+extern "C" LIB_EXPORT_API int PROBLEM_EXPORT_NAME(getKernelTable)(void* problem, int version, TProblemKernelTable* table);
 
 #endif
 // - end of file ----------------------------------------------------------------------------------
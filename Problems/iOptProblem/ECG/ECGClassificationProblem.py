@@ -13,7 +13,7 @@ from sklearn.metrics import f1_score
 import torch
 import torch.nn as nn
 
-def train(model, train_loader, val_loader, epochs=10, lr=1e-3, gpu_id=0, patience=100):
+def train(model, train_loader, val_loader, epochs=10, lr=1e-3, gpu_id=0, patience=100, report=None):
     device = torch.device(f"cuda:{gpu_id}")
     model = model.to(device)
 
@@ -57,6 +57,10 @@ def train(model, train_loader, val_loader, epochs=10, lr=1e-3, gpu_id=0, patienc
             print(f"Early stopping at epoch {epoch+1}")
             break
 
+        if report is not None and report(epoch, -best_val_f1):
+            print(f"Pruned at epoch {epoch+1}")
+            break
+
     return best_val_f1
 
 
@@ -135,12 +139,22 @@ class ECGClassificationProblem(Problem):
 
         print(f"gpu_id = {self.gpu_id}")
 
+        # число эпох обучения на уровнях точности, последний уровень -- полное обучение
+        self.epochs = [10, 30, 100]
+
+
+    def get_fidelity_levels(self) -> list[float]:
+        return [epochs / self.epochs[-1] for epochs in self.epochs]
 
     def calculate(self, point: Point, function_value: FunctionValue) -> FunctionValue:
+        return self.calculate_at_fidelity(point, function_value, len(self.epochs) - 1)
+
+    def calculate_at_fidelity(self, point: Point, function_value: FunctionValue, fidelity: int) -> FunctionValue:
         p, f = point.float_variables[0], point.float_variables[1]
 
         model = MobileNetV3Small1D(in_channels=2, num_classes=3, p=p, o_features=int(f))
-        macro_F1 = train(model, self.train_loader, self.test_loader, epochs=100, lr=1e-3, gpu_id=self.gpu_id)
+        macro_F1 = train(model, self.train_loader, self.test_loader, epochs=self.epochs[fidelity], lr=1e-3,
+                         gpu_id=self.gpu_id, report=self.report)
 
         function_value.value = -macro_F1
 
@@ -8,6 +8,7 @@ from rastrigin import Rastrigin
 from trial import Point
 from trial import FunctionValue
 from problem import Problem
+from problem import TrialPruned
 from MachineLearning.SupportVectorMachines import SVC_Fixed_Kernel
 from sklearn.datasets import load_breast_cancer
 from sklearn.utils import shuffle
@@ -66,12 +67,20 @@ class GlobalizerProblem:
 
         #self.set_dimension(self.dimension)
 
-    def calculate(self, coordinate: List[float], discreteCoordinate: List[str], fNumber: int = 0) -> float:
+    def calculate(self, coordinate: List[float], discreteCoordinate: List[str], fNumber: int = 0,
+                  fidelity: int = -1) -> float:
         self.current_coordinate = coordinate
         self.point.float_variables = np.array(self.current_coordinate)
         self.point.discrete_variables = np.array(discreteCoordinate)
         self.function_value.functionID = fNumber
-        self.result = self.problem.calculate(self.point, self.function_value)
+        try:
+            if fidelity >= 0:
+                self.result = self.problem.calculate_at_fidelity(self.point, self.function_value, fidelity)
+            else:
+                self.result = self.problem.calculate(self.point, self.function_value)
+        except TrialPruned as pruned:
+            self.function_value.value = pruned.value
+            self.result = self.function_value
         self.result_value = float(self.result.value)
         return self.result_value
 
@@ -84,6 +93,15 @@ class GlobalizerProblem:
         self.result_value = float(self.result.value)
         return [self.result_value]
 
+    def set_shared_data(self, name: str, buffer: memoryview, dtype: str, shape: tuple):
+        self.problem.set_shared_data(name, np.frombuffer(buffer, dtype=dtype).reshape(shape))
+
+    def set_pruning_callback(self, callback):
+        self.problem.pruning_callback = callback
+
+    def get_fidelity_levels(self) -> List[float]:
+        return [float(cost) for cost in self.problem.get_fidelity_levels()]
+
     def get_dimension(self) -> int:
         return self.dimension
 
@@ -40,6 +40,11 @@ class SVC_Fixed_Kernel(Problem):
         self.float_variable_names = np.array(["Regularization parameter"], dtype=str)
         self.lower_bound_of_float_variables = np.array([regularization_bound['low']], dtype=np.double)
         self.upper_bound_of_float_variables = np.array([regularization_bound['up']], dtype=np.double)
+        # доли обучающей выборки на уровнях точности, последний уровень -- вся выборка
+        self.sample_fractions = [0.25, 0.5, 1.0]
+
+    def get_fidelity_levels(self) -> list[float]:
+        return list(self.sample_fractions)
 
     def calculate(self, point: Point, function_value: FunctionValue) -> FunctionValue:
         """
@@ -48,9 +53,21 @@ class SVC_Fixed_Kernel(Problem):
         :param point: Точка испытания
         :param function_value: объект хранения значения целевой функции в точке
         """
+        return self.calculate_at_fidelity(point, function_value, len(self.sample_fractions) - 1)
+
+    def calculate_at_fidelity(self, point: Point, function_value: FunctionValue, fidelity: int) -> FunctionValue:
+        """
+        Метод расчёта значения целевой функции по части обучающей выборки
+
+        :param point: Точка испытания
+        :param function_value: объект хранения значения целевой функции в точке
+        :param fidelity: уровень точности, номер доли выборки в sample_fractions
+        """
+        count = max(int(self.x.shape[0] * self.sample_fractions[fidelity]), 10)
+        x, y = self.x[:count], self.y[:count]
         cs = point.float_variables[0]
         clf = SVC(C=10 ** cs, gamma=10 ** self.kernelCoefficient)
-        clf.fit(self.x, self.y)
-        function_value.value = -cross_val_score(clf, self.x, self.y,
+        clf.fit(x, y)
+        function_value.value = -cross_val_score(clf, x, y,
                                                 scoring=lambda model, x, y: f1_score(y, model.predict(x))).mean()
         return function_value
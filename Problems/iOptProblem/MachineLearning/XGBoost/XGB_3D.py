@@ -4,7 +4,8 @@ from trial import Point
 from trial import FunctionValue
 from problem import Problem
 from sklearn.svm import SVC
-from sklearn.model_selection import cross_val_score
+from sklearn.base import clone
+from sklearn.model_selection import KFold
 from typing import Dict, List
 from sklearn.pipeline import Pipeline
 from sklearn.preprocessing import StandardScaler
@@ -48,8 +49,13 @@ class XGB_3D(Problem):
                                                    dtype=np.double)
         self.discrete_variable_names.append('booster')
         self.discrete_variable_values.append(booster_type['booster'])
+        # число блоков перекрестной проверки на уровнях точности, последний уровень -- полное вычисление
+        self.cv_folds = [2, 3, 5]
 
 
+    def get_fidelity_levels(self) -> List[float]:
+        return [folds / self.cv_folds[-1] for folds in self.cv_folds]
+
     def calculate(self, point: Point, function_value: FunctionValue) -> FunctionValue:
         """
         Метод расчёта значения целевой функции в точке
@@ -57,8 +63,25 @@ class XGB_3D(Problem):
         :param point: Точка испытания
         :param function_value: объект хранения значения целевой функции в точке
         """
+        return self.calculate_at_fidelity(point, function_value, len(self.cv_folds) - 1)
+
+    def calculate_at_fidelity(self, point: Point, function_value: FunctionValue, fidelity: int) -> FunctionValue:
+        """
+        Метод расчёта значения целевой функции с уменьшенным числом блоков перекрестной проверки
+
+        :param point: Точка испытания
+        :param function_value: объект хранения значения целевой функции в точке
+        :param fidelity: уровень точности, номер в cv_folds
+        """
         learning_rate, gamma = point.float_variables[0], point.float_variables[1]
         booster = point.discrete_variables[0]
         regr = xgb.XGBRegressor(learning_rate=learning_rate, gamma=gamma, booster=booster)
-        function_value.value = -cross_val_score(regr, self.x, self.y, scoring='r2', cv=5).mean()
+        # блоки те же, что у cross_val_score; после каждого блока сообщается среднее по пройденным
+        scores = []
+        for step, (train, test) in enumerate(KFold(n_splits=self.cv_folds[fidelity]).split(self.x)):
+            model = clone(regr).fit(self.x[train], self.y[train])
+            scores.append(r2_score(self.y[test], model.predict(self.x[test])))
+            function_value.value = -np.mean(scores)
+            if self.report(step, function_value.value):
+                break
         return function_value
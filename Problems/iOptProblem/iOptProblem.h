@@ -1,6 +1,7 @@
 ﻿#ifndef __IOPT_PROBLEM_H__
 #define __IOPT_PROBLEM_H__
 
+#include <map>
 #include <memory>
 
 #include "IGlobalOptimizationProblem.h"
@@ -38,6 +39,10 @@ protected:
   std::vector<std::string> problemParametersStringValues;
   /// Значения параметров
   std::vector<IOptVariantType> problemParametersValues;
+  /// Функция прерывания вычисления, передается обертке при инициализации
+  TPruningCallback mPruningCallback;
+  /// Общие данные, передаются обертке при инициализации и копиям задачи
+  std::map<std::string, TSharedDataPtr> mSharedData;
 
   int ProcRank = 0;
 public:
@@ -90,6 +95,17 @@ public:
   */
   virtual int GetNumberOfCriterions() const;
 
+  /** Метод возвращает вычислительные свойства задачи
+  \param[out] capabilities свойства задачи
+  \return Код ошибки (#PROBLEM_OK)
+  */
+  virtual int GetCapabilities(TProblemCapabilities& capabilities) const;
+
+  /** Метод создает независимую копию задачи
+  \return Указатель на копию или nullptr, если задача не инициализирована
+  */
+  virtual IGlobalOptimizationProblem* Clone() const;
+
   /** Метод, вычисляющий функции задачи
 
   \param[in] y непрерывные координаты точки, в которой необходимо вычислить значение
@@ -107,6 +123,111 @@ public:
   */
   virtual std::vector<double> CalculateAllFunctionals(const std::vector<double>& y, std::vector<std::string>& u);
 
+  /** Метод, вычисляющий функции задачи без создания временных векторов
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки
+  \param[in] uCount число дискретных координат
+  \param[in] fNumber Номер вычисляемой функции
+  \return Значение функции с указанным номером
+  */
+  virtual double CalculateFunctionals(const double* y, int yCount, const std::string* u, int uCount, int fNumber);
+
+  /** Метод, вычисляющий все функции задачи в буфер вызывающей стороны
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки
+  \param[in] uCount число дискретных координат
+  \param[out] values массив из #GetNumberOfFunctions() элементов для значений функций
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int CalculateAllFunctionals(const double* y, int yCount, const std::string* u, int uCount, double* values);
+
+  /** Метод, вычисляющий функции задачи с возвратом статуса
+
+  Исключение в скрипте не выходит из метода, а дает статус #FUNCTIONAL_ERROR
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки
+  \param[in] uCount число дискретных координат
+  \param[in] fNumber Номер вычисляемой функции
+  \param[out] value значение функции
+  \return Статус значения (#FUNCTIONAL_OK, #FUNCTIONAL_NOT_COMPUTABLE или #FUNCTIONAL_ERROR)
+  */
+  virtual int TryCalculateFunctionals(const double* y, int yCount, const std::string* u, int uCount, int fNumber,
+    double& value);
+
+  /** Метод, вычисляющий все функции задачи со статусом для каждой функции
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки
+  \param[in] uCount число дискретных координат
+  \param[out] values массив из #GetNumberOfFunctions() элементов для значений функций
+  \param[out] statuses массив из #GetNumberOfFunctions() элементов для статусов значений
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int TryCalculateAllFunctionals(const double* y, int yCount, const std::string* u, int uCount,
+    double* values, int* statuses);
+
+  /** Метод возвращает уровни точности вычисления, объявленные скриптом задачи
+
+  \param[out] costs стоимость вычисления на каждом уровне относительно полного вычисления
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_UNDEFINED, если задача не инициализирована)
+  */
+  virtual int GetFidelityLevels(std::vector<double>& costs) const;
+
+  /** Метод, вычисляющий функцию задачи с заданным уровнем точности
+
+  Уровень передается в GlobalizerProblem.calculate четвертым аргументом
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки
+  \param[in] uCount число дискретных координат
+  \param[in] fNumber Номер вычисляемой функции
+  \param[in] fidelity уровень точности, -1 -- полное вычисление
+  \param[out] value значение функции
+  \return Статус значения (#FUNCTIONAL_OK, #FUNCTIONAL_NOT_COMPUTABLE или #FUNCTIONAL_ERROR)
+  */
+  virtual int TryCalculateFunctionalsAtFidelity(const double* y, int yCount, const std::string* u, int uCount,
+    int fNumber, int fidelity, double& value);
+
+  /** Метод задает функцию прерывания вычисления
+
+  Промежуточные значения сообщает скрипт задачи методом Problem.report; функция вызывается
+  под GIL и не должна обращаться к этой же задаче. Прерываются только вычисления со статусом
+  (TryCalculate...), остальные методы вычисляют функции полностью. Копии задачи (#Clone)
+  получают ту же функцию
+  \param[in] callback функция прерывания, пустая функция отключает прерывание
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_UNDEFINED, если GlobalizerProblem не поддерживает
+  передачу промежуточных значений)
+  */
+  virtual int SetPruningCallback(const TPruningCallback& callback);
+
+  /** Метод, вычисляющий функции задачи, дискретные параметры которой заданы номерами значений
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u номера значений дискретных параметров
+  \param[in] uCount число дискретных координат
+  \param[in] fNumber Номер вычисляемой функции
+  \return Значение функции с указанным номером
+  */
+  virtual double CalculateFunctionalsByIndex(const double* y, int yCount, const int* u, int uCount, int fNumber);
+
+  /** Метод, вычисляющий все функции задачи, дискретные параметры которой заданы номерами значений
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u номера значений дискретных параметров
+  \param[in] uCount число дискретных координат
+  \param[out] values массив из #GetNumberOfFunctions() элементов для значений функций
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int CalculateAllFunctionalsByIndex(const double* y, int yCount, const int* u, int uCount, double* values);
+
   /** ћетод возвращает точку из допустимой области
   \param[out] y непрерывные координаты точки
   \param[out] u целочисленые координаты точки
@@ -136,6 +257,16 @@ public:
   */
   virtual int SetParameter(std::string name, void* value);
 
+  /** Метод передает скрипту задачи общие данные
+
+  Данные доступны объекту задачи python через Problem.set_shared_data как массив numpy
+  только для чтения, копии задачи (#Clone) используют тот же буфер
+  \param[in] name имя данных
+  \param[in] data данные
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_UNDEFINED, если скрипт не принимает общие данные)
+  */
+  virtual int SetSharedData(const std::string& name, const TSharedDataPtr& data);
+
   /** Метод возвращает параметры задачи
   \param[out] names имена параметраметров
   \param[out] values значениея параметров
@@ -154,8 +285,8 @@ public:
   ~iOptProblem();
 };
 
-extern "C" LIB_EXPORT_API IGlobalOptimizationProblem* create();
-extern "C" LIB_EXPORT_API void destroy(IGlobalOptimizationProblem* ptr);
+extern "C" LIB_EXPORT_API IGlobalOptimizationProblem* PROBLEM_EXPORT_NAME(create)();
+extern "C" LIB_EXPORT_API void PROBLEM_EXPORT_NAME(destroy)(IGlobalOptimizationProblem* ptr);
 
 #endif
 // - end of file ----------------------------------------------------------------------------------
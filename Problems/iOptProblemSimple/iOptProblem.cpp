@@ -3,6 +3,7 @@
 #endif
 
 #include "iOptProblem.h"
+#include "StaticProblemRegistry.h"
 
 #include <iostream>
 #include <filesystem>
@@ -60,6 +61,10 @@ int iOptProblem::Initialize()
     mFunction = std::make_shared<TPythonModuleWrapper>(mPyFilePath, problemParametersValues, 
       problemParametersNames, functionScriptName, functionClassName);
     mDimension = mFunction->GetDimension();
+    if (mPruningCallback)
+      mFunction->SetPruningCallback(mPruningCallback);
+    for (auto& sharedData : mSharedData)
+      mFunction->SetSharedData(sharedData.first, sharedData.second);
 
     mIsInitialized = true;
     return IGlobalOptimizationProblem::PROBLEM_OK;
@@ -124,6 +129,46 @@ int iOptProblem::GetNumberOfCriterions() const
   return 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+int iOptProblem::GetCapabilities(TProblemCapabilities& capabilities) const
+{
+  capabilities = TProblemCapabilities();
+  // вызовы экземпляра упорядочиваются мьютексом обертки и GIL, для параллельной работы служит #Clone
+  capabilities.threadSafety = TProblemCapabilities::THREAD_SERIALIZED;
+  capabilities.hasNativeBatch = false;
+  // детерминированность скрипта неизвестна (например, обучение моделей)
+  capabilities.isDeterministic = false;
+  capabilities.isInterpreterBacked = true;
+  capabilities.functionCost = -1.0;
+  capabilities.preferredBatchSize = 1;
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+IGlobalOptimizationProblem* iOptProblem::Clone() const
+{
+  if (!mIsInitialized)
+    return nullptr;
+
+  // копия создает собственные экземпляры объектов python с теми же параметрами
+  iOptProblem* clone = new iOptProblem();
+  clone->mPyFilePath = mPyFilePath;
+  clone->functionScriptName = functionScriptName;
+  clone->functionClassName = functionClassName;
+  clone->datasetName = datasetName;
+  clone->methodName = methodName;
+  clone->ProcRank = ProcRank;
+  clone->mDimension = mDimension;
+  clone->mSharedData = mSharedData;
+  clone->mPruningCallback = mPruningCallback;
+  if (clone->Initialize() != IGlobalOptimizationProblem::PROBLEM_OK)
+  {
+    delete clone;
+    return nullptr;
+  }
+  return clone;
+}
+
 // ------------------------------------------------------------------------------------------------
 double iOptProblem::CalculateFunctionals(const std::vector<double>& y, std::vector<std::string>& u, int fNumber)
 {
@@ -136,6 +181,94 @@ inline std::vector<double> iOptProblem::CalculateAllFunctionals(const std::vecto
   return mFunction->EvaluateAllFunction(y, u);
 }
 
+// ------------------------------------------------------------------------------------------------
+double iOptProblem::CalculateFunctionals(const double* y, int yCount, const std::string* u, int uCount, int fNumber)
+{
+  return mFunction->EvaluateFunction(y, yCount, u, uCount, fNumber);
+}
+
+// ------------------------------------------------------------------------------------------------
+int iOptProblem::CalculateAllFunctionals(const double* y, int yCount, const std::string* u, int uCount, double* values)
+{
+  int numberOfFunctions = GetNumberOfFunctions();
+  if (mFunction->EvaluateAllFunction(y, yCount, u, uCount, values, numberOfFunctions) != numberOfFunctions)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int iOptProblem::TryCalculateFunctionals(const double* y, int yCount, const std::string* u, int uCount, int fNumber,
+  double& value)
+{
+  return mFunction->TryEvaluateFunction(y, yCount, u, uCount, fNumber, value);
+}
+
+// ------------------------------------------------------------------------------------------------
+int iOptProblem::TryCalculateAllFunctionals(const double* y, int yCount, const std::string* u, int uCount,
+  double* values, int* statuses)
+{
+  int numberOfFunctions = GetNumberOfFunctions();
+  if (mFunction->TryEvaluateAllFunction(y, yCount, u, uCount, values, statuses, numberOfFunctions) !=
+    numberOfFunctions)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int iOptProblem::GetFidelityLevels(std::vector<double>& costs) const
+{
+  if (!mIsInitialized)
+  {
+    costs.assign(1, 1.0);
+    return IGlobalOptimizationProblem::PROBLEM_UNDEFINED;
+  }
+  costs = mFunction->GetFidelityLevels();
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int iOptProblem::TryCalculateFunctionalsAtFidelity(const double* y, int yCount, const std::string* u, int uCount,
+  int fNumber, int fidelity, double& value)
+{
+  return mFunction->TryEvaluateFunction(y, yCount, u, uCount, fNumber, value, fidelity);
+}
+
+// ------------------------------------------------------------------------------------------------
+int iOptProblem::SetPruningCallback(const TPruningCallback& callback)
+{
+  mPruningCallback = callback;
+  if (mIsInitialized && !mFunction->SetPruningCallback(callback))
+    return IGlobalOptimizationProblem::PROBLEM_UNDEFINED;
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int iOptProblem::SetSharedData(const std::string& name, const TSharedDataPtr& data)
+{
+  if (!data)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+  // отклоненные скриптом данные не запоминаются, чтобы их не получили копии задачи
+  if (mIsInitialized && !mFunction->SetSharedData(name, data))
+    return IGlobalOptimizationProblem::PROBLEM_UNDEFINED;
+  mSharedData[name] = data;
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+double iOptProblem::CalculateFunctionalsByIndex(const double* y, int yCount, const int* u, int uCount, int fNumber)
+{
+  return mFunction->EvaluateFunctionByIndex(y, yCount, u, uCount, fNumber);
+}
+
+// ------------------------------------------------------------------------------------------------
+int iOptProblem::CalculateAllFunctionalsByIndex(const double* y, int yCount, const int* u, int uCount, double* values)
+{
+  int numberOfFunctions = GetNumberOfFunctions();
+  if (mFunction->EvaluateAllFunctionByIndex(y, yCount, u, uCount, values, numberOfFunctions) != numberOfFunctions)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
 inline int iOptProblem::GetStartTrial(std::vector<double>& y, std::vector<std::string>& u, std::vector<double>& values)
 {
   if (mIsInitialized)
@@ -242,14 +375,17 @@ iOptProblem::~iOptProblem()
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API IGlobalOptimizationProblem* create()
+LIB_EXPORT_API IGlobalOptimizationProblem* PROBLEM_EXPORT_NAME(create)()
 {
   return new iOptProblem();
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API void destroy(IGlobalOptimizationProblem* ptr)
+LIB_EXPORT_API void PROBLEM_EXPORT_NAME(destroy)(IGlobalOptimizationProblem* ptr)
 {
   delete ptr;
 }
+
+// ------------------------------------------------------------------------------------------------
+REGISTER_STATIC_PROBLEM(NULL)
 // - end of file ----------------------------------------------------------------------------------
@@ -5,6 +5,14 @@ from trial import FunctionValue
 from trial import Trial
 
 
+class TrialPruned(Exception):
+    """Raised by an objective to stop an evaluation early, carries the last intermediate value"""
+
+    def __init__(self, value: float):
+        super().__init__(value)
+        self.value = value
+
+
 class Problem(ABC):
     """Base class for optimization problems"""
 
@@ -25,6 +33,9 @@ class Problem(ABC):
 
         self.known_optimum: list[Trial] = []
 
+        self.pruning_callback = None
+        self.shared_data: dict = {}
+
     def calculate(self, point: Point, function_value: FunctionValue) -> FunctionValue:
         """
         Calculate a function at a given point.
@@ -46,6 +57,46 @@ class Problem(ABC):
 
         return function_values
 
+    def report(self, step: int, value: float) -> bool:
+        """
+        Report an intermediate value of a long evaluation (a cross-validation fold, a training epoch).
+          The objective should stop and return the partial value, or raise :class:`TrialPruned`,
+          when this method returns True
+
+        :return: True if the evaluation should be stopped."""
+        callback = getattr(self, 'pruning_callback', None)
+        if callback is None:
+            return False
+        return bool(callback(step, float(value)))
+
+    def set_shared_data(self, name: str, value: np.ndarray):
+        """
+        Receive read-only data shared by all instances of the problem (a dataset, a coefficient table).
+          The array refers to memory owned by the caller and must not be modified
+
+        :param name: name of the data
+        :param value: read-only array"""
+        if not hasattr(self, 'shared_data'):
+            self.shared_data = {}
+        self.shared_data[name] = value
+
+    def get_fidelity_levels(self) -> list[float]:
+        """
+        Get the relative cost of the fidelity levels of the problem, the last level is the full evaluation.
+          Problems with cheaper approximations of the objective should overload this method
+          together with :meth:`calculate_at_fidelity`
+
+        :return: Costs of the levels relative to the full evaluation."""
+        return [1.0]
+
+    def calculate_at_fidelity(self, point: Point, function_value: FunctionValue, fidelity: int) -> FunctionValue:
+        """
+        Calculate a function at a given point with the given fidelity level.
+          By default every level is the full evaluation
+
+        :return: Calculated value of the function."""
+        return self.calculate(point, function_value)
+
 
     # @abstractmethod
     def get_name(self):
@@ -2,8 +2,9 @@
 
 #include <stdexcept>
 #include <iostream>
-#include <omp.h>
 #include <memory>
+#include <cmath>
+#include <limits>
 
 using namespace std;
 
@@ -23,15 +24,74 @@ PyObject* makeFloatList(const double* array, int size)
 }
 
 
-PyObject* makeStrList(std::vector<std::string> array)
+PyObject* makeStrList(const std::string* array, int size)
 {
-    PyObject* l = PyList_New(array.size());
-    for (int i = 0; i != array.size(); i++)
+    PyObject* l = PyList_New(size);
+    for (int i = 0; i != size; i++)
         PyList_SET_ITEM(l, i, PyUnicode_FromString(array[i].c_str()));
     return l;
 }
 
 
+// ------------------------------------------------------------------------------------------------
+/// <summary>
+/// Преобразует значение функции, возвращенное python, должна вызываться под GIL
+/// </summary>
+/// <remarks>None, inf и nan означают, что функция в точке не вычислима</remarks>
+/// <returns>статус значения (IGlobalOptimizationProblem::FUNCTIONAL_OK и др.)</returns>
+static int ConvertFunctionValue(PyObject* item, double& value)
+{
+  value = std::numeric_limits<double>::quiet_NaN();
+  if (!item)
+    return IGlobalOptimizationProblem::FUNCTIONAL_ERROR;
+  if (item == Py_None)
+    return IGlobalOptimizationProblem::FUNCTIONAL_NOT_COMPUTABLE;
+
+  value = PyFloat_AsDouble(item);
+  if (value == -1.0 && PyErr_Occurred())
+  {
+    PyErr_Clear();
+    value = std::numeric_limits<double>::quiet_NaN();
+    return IGlobalOptimizationProblem::FUNCTIONAL_ERROR;
+  }
+  if (!std::isfinite(value))
+    return IGlobalOptimizationProblem::FUNCTIONAL_NOT_COMPUTABLE;
+  return IGlobalOptimizationProblem::FUNCTIONAL_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+/// <summary>
+/// Копирует значения функций из python list в буфер, должна вызываться под GIL
+/// </summary>
+/// <param name="statuses">буфер для статусов значений, может быть nullptr</param>
+/// <returns>число скопированных значений или -1, если результат не список</returns>
+static int CopyFunctionValues(PyObject* list_obj, double* values, int* statuses, int valuesCount)
+{
+  if (!list_obj || !PyList_Check(list_obj))
+    return -1;
+
+  int count = (int)PyList_Size(list_obj);
+  if (count > valuesCount)
+    count = valuesCount;
+  for (int i = 0; i < count; i++)
+  {
+    int status = ConvertFunctionValue(PyList_GetItem(list_obj, i), values[i]);
+    if (statuses)
+      statuses[i] = status;
+  }
+  return count;
+}
+
+// ------------------------------------------------------------------------------------------------
+/// <summary>
+/// Возвращает значение функции или бросает исключение, если при вычислении произошла ошибка
+/// </summary>
+static double ValueOrThrow(int status, double value)
+{
+  if (status == IGlobalOptimizationProblem::FUNCTIONAL_ERROR)
+    throw std::runtime_error("Error of python function calculation");
+  return value;
+}
 
 // ------------------------------------------------------------------------------------------------
 #ifdef WIN32
@@ -238,6 +298,24 @@ PyObject* TPythonModuleWrapper::VectorToTuple(std::vector<IOptVariantType> param
   return tuple;
 }
 
+// ------------------------------------------------------------------------------------------------
+/// Функция python report_intermediate(step, value), self -- капсула с указателем на TPythonModuleWrapper
+static PyObject* ReportIntermediate(PyObject* self, PyObject* args)
+{
+  int step = 0;
+  double value = 0.0;
+  if (!PyArg_ParseTuple(args, "id", &step, &value))
+    return NULL;
+  auto wrapper = static_cast<const TPythonModuleWrapper*>(PyCapsule_GetPointer(self, "TPythonModuleWrapper"));
+  if (!wrapper)
+    return NULL;
+  return PyBool_FromLong(wrapper->ReportIntermediateValue(step, value));
+}
+
+/// Описание функции report_intermediate
+static PyMethodDef reportIntermediateDef = { "report_intermediate", ReportIntermediate, METH_VARARGS,
+  "Passes an intermediate value to the pruning callback, returns True if the evaluation should stop" };
+
 // ------------------------------------------------------------------------------------------------
 TPythonModuleWrapper::TPythonModuleWrapper(const std::string& module_path, std::vector<IOptVariantType> param,
   std::vector<std::string> paramName, std::string functionScriptName, std::string functionClassName)
@@ -392,11 +470,52 @@ TPythonModuleWrapper::TPythonModuleWrapper(const std::string& module_path, std::
 
   PyObject* pResultDiscreteParams = PyObject_CallMethod(pInstance, "get_discrete_params", NULL);
   discreteParams = py_list_of_list_to_vector_vectors_str(pResultDiscreteParams);
+  mDiscreteLabels.resize(discreteParams.size());
+  for (size_t i = 0; i < discreteParams.size(); i++)
+    for (const auto& label : discreteParams[i])
+      mDiscreteLabels[i].push_back(PyUnicode_FromString(label.c_str()));
   if (pResultDiscreteParams)
       Py_DECREF(pResultDiscreteParams);
   else
       PyErr_Print();
 
+  // Уровни точности вычисления необязательны
+  mFidelityLevels.assign(1, 1.0);
+  if (PyObject_HasAttrString(pInstance, "get_fidelity_levels"))
+  {
+    PyObject* pResultFidelity = PyObject_CallMethod(pInstance, "get_fidelity_levels", NULL);
+    if (pResultFidelity && PyList_Check(pResultFidelity) && PyList_Size(pResultFidelity) > 0)
+      mFidelityLevels = py_list_to_vector_double(pResultFidelity);
+    if (pResultFidelity)
+      Py_DECREF(pResultFidelity);
+    else
+      PyErr_Print();
+  }
+
+  // Промежуточные значения передаются только скриптам, поддерживающим прерывание вычислений
+  mIsPruned = false;
+  mIsPruningEnabled = false;
+  mReportFunction = nullptr;
+  if (PyObject_HasAttrString(pInstance, "set_pruning_callback"))
+  {
+    PyObject* capsule = PyCapsule_New(this, "TPythonModuleWrapper", NULL);
+    if (capsule)
+    {
+      mReportFunction = PyCFunction_New(&reportIntermediateDef, capsule);
+      Py_DECREF(capsule);
+    }
+    PyObject* pResultReport = mReportFunction ?
+      PyObject_CallMethod(pInstance, "set_pruning_callback", "O", mReportFunction) : NULL;
+    if (pResultReport)
+      Py_DECREF(pResultReport);
+    else
+    {
+      PyErr_Print();
+      Py_XDECREF(mReportFunction);
+      mReportFunction = nullptr;
+    }
+  }
+
   //main_ts = PyEval_SaveThread();  // Освобождаем GIL в каждом потоке
   //PyGILState_STATE gstate = PyGILState_Ensure();
   PyErr_Print();
@@ -413,69 +532,230 @@ int TPythonModuleWrapper::GetDimension() const
 // ------------------------------------------------------------------------------------------------
 double TPythonModuleWrapper::EvaluateFunction(const std::vector<double>& y, const std::vector<std::string>& categorys, int fNumber) const
 {
-  double retval = 0;
   int dim = mDimension - discreteParams.size();
+  return EvaluateFunction(y.data(), dim, categorys.data(), (int)categorys.size(), fNumber);
+}
+
+// ------------------------------------------------------------------------------------------------
+double TPythonModuleWrapper::EvaluateFunction(const double* y, int yCount, const std::string* categorys, int uCount,
+  int fNumber, int fidelity) const
+{
+  double retval = 0;
+  int status = EvaluateFunctionStatus(y, yCount, categorys, uCount, fNumber, retval, fidelity, false);
+  return ValueOrThrow(status, retval);
+}
+
+// ------------------------------------------------------------------------------------------------
+int TPythonModuleWrapper::TryEvaluateFunction(const double* y, int yCount, const std::string* categorys, int uCount,
+  int fNumber, double& value, int fidelity) const
+{
+  return EvaluateFunctionStatus(y, yCount, categorys, uCount, fNumber, value, fidelity, true);
+}
+
+// ------------------------------------------------------------------------------------------------
+int TPythonModuleWrapper::EvaluateFunctionStatus(const double* y, int yCount, const std::string* categorys,
+  int uCount, int fNumber, double& value, int fidelity, bool isPruningEnabled) const
+{
+  if (fidelity < -1 || fidelity >= (int)mFidelityLevels.size())
+    return IGlobalOptimizationProblem::FUNCTIONAL_ERROR;
+  // полное вычисление передается без уровня, как в скриптах, не знающих об уровнях
+  if (fidelity == (int)mFidelityLevels.size() - 1)
+    fidelity = -1;
+
+  int status = IGlobalOptimizationProblem::FUNCTIONAL_ERROR;
 
-#pragma omp critical
   {
+    std::lock_guard<std::mutex> lock(mCallMutex);
     PyGILState_STATE gstate = PyGILState_Ensure();
+    auto py_categorys = makeStrList(categorys, uCount);
+    mIsPruned = false;
+    mIsPruningEnabled = isPruningEnabled;
+    status = CallFunction(y, yCount, py_categorys, fNumber, fidelity, value);
+    mIsPruningEnabled = false;
+    if (mIsPruned && status == IGlobalOptimizationProblem::FUNCTIONAL_OK)
+      status = IGlobalOptimizationProblem::FUNCTIONAL_PRUNED;
+    Py_DECREF(py_categorys);
+    PyGILState_Release(gstate);
+  }
+  return status;
+}
 
+// ------------------------------------------------------------------------------------------------
+double TPythonModuleWrapper::EvaluateFunctionByIndex(const double* y, int yCount, const int* u, int uCount,
+  int fNumber) const
+{
+  if (!IsValidDiscreteIndices(u, uCount))
+    throw std::out_of_range("Discrete value index is out of range");
 
-    PyObject* py_arg1 = PyList_New(dim);
-    for (int i = 0; i != dim; i++)
-      PyList_SET_ITEM(py_arg1, i, PyFloat_FromDouble(y[i]));
+  double retval = 0;
+  int status = IGlobalOptimizationProblem::FUNCTIONAL_ERROR;
 
+  {
+    std::lock_guard<std::mutex> lock(mCallMutex);
+    PyGILState_STATE gstate = PyGILState_Ensure();
+    auto py_categorys = MakeLabelList(u, uCount);
+    status = CallFunction(y, yCount, py_categorys, fNumber, -1, retval);
+    Py_DECREF(py_categorys);
+    PyGILState_Release(gstate);
+  }
+  return ValueOrThrow(status, retval);
+}
 
-    //auto py_arg1 = makeFloatList(y.data(), dim);
-    auto py_arg2 = makeStrList(categorys);
-    auto py_arg3 = PyLong_FromLong(fNumber);
+// ------------------------------------------------------------------------------------------------
+int TPythonModuleWrapper::CallFunction(const double* y, int yCount, PyObject* categorys, int fNumber,
+  int fidelity, double& value) const
+{
+  auto py_arg1 = makeFloatList(y, yCount);
+  auto py_arg3 = PyLong_FromLong(fNumber);
 
-    auto arglist = PyTuple_Pack(3, py_arg1, py_arg2, py_arg3);
+  PyObject* arglist;
+  if (fidelity < 0)
+    arglist = PyTuple_Pack(3, py_arg1, categorys, py_arg3);
+  else
+  {
+    auto py_arg4 = PyLong_FromLong(fidelity);
+    arglist = PyTuple_Pack(4, py_arg1, categorys, py_arg3, py_arg4);
+    Py_DECREF(py_arg4);
+  }
 
-    auto result = PyObject_CallMethod(pInstance, "calculate", "O", arglist);
+  auto result = PyObject_CallMethod(pInstance, "calculate", "O", arglist);
+  // исключение в скрипте -- ошибка, о которой нужно сообщить; невычислимость сообщается без печати
+  if (!result)
     PyErr_Print();
-    retval = PyFloat_AsDouble(result);
-    Py_DECREF(py_arg1);
-    Py_DECREF(py_arg2);
-    Py_DECREF(py_arg3);
-    Py_DECREF(arglist);
-    Py_DECREF(result);
+  int status = ConvertFunctionValue(result, value);
+  Py_DECREF(py_arg1);
+  Py_DECREF(py_arg3);
+  Py_DECREF(arglist);
+  Py_XDECREF(result);
+  return status;
+}
 
-    PyGILState_Release(gstate);
+// ------------------------------------------------------------------------------------------------
+PyObject* TPythonModuleWrapper::CallAllFunctionals(const double* y, int yCount, PyObject* categorys) const
+{
+  auto py_arg1 = makeFloatList(y, yCount);
+
+  auto arglist = PyTuple_Pack(2, py_arg1, categorys);
+
+  auto result = PyObject_CallMethod(pInstance, "calculate_all_functionals", "O", arglist);
+  PyErr_Print();
+  Py_DECREF(py_arg1);
+  Py_DECREF(arglist);
+  return result;
+}
+
+// ------------------------------------------------------------------------------------------------
+PyObject* TPythonModuleWrapper::MakeLabelList(const int* u, int uCount) const
+{
+  PyObject* l = PyList_New(uCount);
+  for (int i = 0; i != uCount; i++)
+  {
+    PyObject* label = mDiscreteLabels[i][u[i]];
+    Py_INCREF(label);
+    PyList_SET_ITEM(l, i, label);
   }
-  return retval;
+  return l;
 }
 
+// ------------------------------------------------------------------------------------------------
+bool TPythonModuleWrapper::IsValidDiscreteIndices(const int* u, int uCount) const
+{
+  if (uCount > (int)mDiscreteLabels.size())
+    return false;
+  for (int i = 0; i < uCount; i++)
+    if (u[i] < 0 || u[i] >= (int)mDiscreteLabels[i].size())
+      return false;
+  return true;
+}
 
 // ------------------------------------------------------------------------------------------------
 std::vector<double> TPythonModuleWrapper::EvaluateAllFunction(const std::vector<double>& y, const std::vector<std::string>& categorys) const
 {
   std::vector<double> retval;
-#pragma omp critical
   {
+    std::lock_guard<std::mutex> lock(mCallMutex);
     PyGILState_STATE gstate = PyGILState_Ensure();
-    auto py_arg1 = makeFloatList(y.data(), mDimension);
-    auto py_arg2 = makeStrList(categorys);
-
-    auto arglist = PyTuple_Pack(2, py_arg1, py_arg2);
-
-    auto result = PyObject_CallMethod(pInstance, "calculate_all_functionals", "O", arglist);
-    PyErr_Print();
+    auto py_categorys = makeStrList(categorys.data(), (int)categorys.size());
+    auto result = CallAllFunctionals(y.data(), mDimension, py_categorys);
+    Py_DECREF(py_categorys);
     retval = py_list_to_vector_double(result);
-    Py_DECREF(py_arg1);
-    Py_DECREF(py_arg2);
-    Py_DECREF(arglist);
     Py_DECREF(result);
     PyGILState_Release(gstate);
   }
   return retval;
 }
 
+// ------------------------------------------------------------------------------------------------
+int TPythonModuleWrapper::EvaluateAllFunction(const double* y, int yCount, const std::string* categorys, int uCount,
+  double* values, int valuesCount) const
+{
+  return TryEvaluateAllFunction(y, yCount, categorys, uCount, values, nullptr, valuesCount);
+}
+
+// ------------------------------------------------------------------------------------------------
+int TPythonModuleWrapper::TryEvaluateAllFunction(const double* y, int yCount, const std::string* categorys,
+  int uCount, double* values, int* statuses, int valuesCount) const
+{
+  int count = -1;
+  {
+    std::lock_guard<std::mutex> lock(mCallMutex);
+    PyGILState_STATE gstate = PyGILState_Ensure();
+    auto py_categorys = makeStrList(categorys, uCount);
+    mIsPruned = false;
+    // без статусов о прерывании не сообщить, поэтому значения вычисляются полностью
+    mIsPruningEnabled = statuses != nullptr;
+    auto result = CallAllFunctionals(y, yCount, py_categorys);
+    mIsPruningEnabled = false;
+    Py_DECREF(py_categorys);
+    count = CopyFunctionValues(result, values, statuses, valuesCount);
+    for (int i = 0; statuses && mIsPruned && i < count; i++)
+      if (statuses[i] == IGlobalOptimizationProblem::FUNCTIONAL_OK)
+        statuses[i] = IGlobalOptimizationProblem::FUNCTIONAL_PRUNED;
+    Py_XDECREF(result);
+    PyGILState_Release(gstate);
+  }
+  return count;
+}
+
+// ------------------------------------------------------------------------------------------------
+int TPythonModuleWrapper::EvaluateAllFunctionByIndex(const double* y, int yCount, const int* u, int uCount,
+  double* values, int valuesCount) const
+{
+  if (!IsValidDiscreteIndices(u, uCount))
+    return -1;
+
+  int count = -1;
+  {
+    std::lock_guard<std::mutex> lock(mCallMutex);
+    PyGILState_STATE gstate = PyGILState_Ensure();
+    auto py_categorys = MakeLabelList(u, uCount);
+    auto result = CallAllFunctionals(y, yCount, py_categorys);
+    Py_DECREF(py_categorys);
+    count = CopyFunctionValues(result, values, nullptr, valuesCount);
+    Py_XDECREF(result);
+    PyGILState_Release(gstate);
+  }
+  return count;
+}
+
 // ------------------------------------------------------------------------------------------------
 TPythonModuleWrapper::~TPythonModuleWrapper()
 {
   // Очистка
   PyGILState_STATE gstate = PyGILState_Ensure();
+  // скрипт может пережить обертку, поэтому ссылка на нее у него отбирается
+  if (mReportFunction)
+  {
+    PyObject* pResultReport = PyObject_CallMethod(pInstance, "set_pruning_callback", "O", Py_None);
+    if (pResultReport)
+      Py_DECREF(pResultReport);
+    else
+      PyErr_Print();
+    Py_DECREF(mReportFunction);
+  }
+  for (auto& labels : mDiscreteLabels)
+    for (auto label : labels)
+      Py_DECREF(label);
   Py_DECREF(pInstance);
   Py_DECREF(pClass);
   Py_DECREF(pModule);
@@ -499,6 +779,67 @@ void TPythonModuleWrapper::GetBounds(std::vector<double>& lower, std::vector<dou
 }
 
 
+// ------------------------------------------------------------------------------------------------
+const std::vector<double>& TPythonModuleWrapper::GetFidelityLevels() const
+{
+  return mFidelityLevels;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool TPythonModuleWrapper::SetPruningCallback(const TPruningCallback& callback)
+{
+  std::lock_guard<std::mutex> lock(mCallMutex);
+  mPruningCallback = callback;
+  return mReportFunction != nullptr;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool TPythonModuleWrapper::ReportIntermediateValue(int step, double value) const
+{
+  // вызывается внутри CallFunction, мьютекс вычисления уже захвачен
+  if (!mIsPruningEnabled)
+    return false;
+  if (!mIsPruned && mPruningCallback && mPruningCallback(step, value))
+    mIsPruned = true;
+  return mIsPruned;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool TPythonModuleWrapper::SetSharedData(const std::string& name, const TSharedDataPtr& data)
+{
+  static const char* dtypes[] = { "uint8", "int32", "int64", "float32", "float64" };
+  const TSharedDataShape& shape = data->GetShape();
+  if (shape.elementType < 0 || shape.elementType > TSharedDataShape::ELEMENT_DOUBLE)
+    return false;
+
+  bool isAccepted = false;
+  std::lock_guard<std::mutex> lock(mCallMutex);
+  PyGILState_STATE gstate = PyGILState_Ensure();
+  if (PyObject_HasAttrString(pInstance, "set_shared_data"))
+  {
+    auto buffer = PyMemoryView_FromMemory(static_cast<char*>(const_cast<void*>(data->GetData())),
+      (Py_ssize_t)data->GetSize(), PyBUF_READ);
+    auto dimensions = PyTuple_New((Py_ssize_t)shape.dimensions.size());
+    for (size_t i = 0; i < shape.dimensions.size(); i++)
+      PyTuple_SET_ITEM(dimensions, i, PyLong_FromSize_t(shape.dimensions[i]));
+
+    auto result = buffer ? PyObject_CallMethod(pInstance, "set_shared_data", "sOsO", name.c_str(), buffer,
+      dtypes[shape.elementType], dimensions) : NULL;
+    if (result)
+    {
+      mSharedData[name] = data;
+      isAccepted = true;
+    }
+    else
+      PyErr_Print();
+    Py_XDECREF(result);
+    Py_XDECREF(buffer);
+    Py_DECREF(dimensions);
+  }
+  PyGILState_Release(gstate);
+  return isAccepted;
+}
+
 // ------------------------------------------------------------------------------------------------
 int TPythonModuleWrapper::GetNumberOfFunctions() const
 {
@@ -590,7 +931,7 @@ int TPythonModuleWrapper::GetNumberOfCriterions() const
   
 }
 
-std::vector<std::vector<std::string>> TPythonModuleWrapper::GetDescreteParameters()
+const std::vector<std::vector<std::string>>& TPythonModuleWrapper::GetDescreteParameters() const
 {
     return discreteParams;
 }
@@ -608,7 +949,7 @@ inline int TPythonModuleWrapper::GetStartTrial(std::vector<double>& y, std::vect
       y = py_list_to_vector_double(pStartY);
       u.resize(discreteParams.size());
       for (int i = 0; i < discreteParams.size(); i++)
-        u[i] = GetDescreteParameters()[i][0];
+        u[i] = discreteParams[i][0];
       Py_DECREF(pStartY);
     }
     else
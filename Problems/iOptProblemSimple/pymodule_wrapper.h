@@ -1,7 +1,9 @@
 ﻿#pragma once
 
+#include <map>
 #include <string>
 #include <vector>
+#include <mutex>
 #include <variant>
 
 #include "IGlobalOptimizationProblem.h"
@@ -34,11 +36,25 @@ protected:
 
   /// Список дискретных параметров
   std::vector<std::vector<std::string>> discreteParams;
+  /// Значения дискретных параметров в виде строк python, создаются один раз в конструкторе
+  std::vector<std::vector<PyObject*>> mDiscreteLabels;
 
   /// Верхняя граница области поиска
   std::vector<double> mUpperBound;
   /// Нижняя граница области поиска
   std::vector<double> mLowerBound;
+  /// Относительная стоимость уровней точности вычисления, последний -- полное вычисление
+  std::vector<double> mFidelityLevels;
+  /// Функция прерывания вычисления по промежуточным значениям
+  TPruningCallback mPruningCallback;
+  /// Признак того, что текущее вычисление прервано функцией mPruningCallback
+  mutable bool mIsPruned;
+  /// Можно ли прервать текущее вычисление: о прерывании сообщает только статус значения
+  mutable bool mIsPruningEnabled;
+  /// Функция report_intermediate, переданная скрипту через GlobalizerProblem.set_pruning_callback
+  PyObject* mReportFunction;
+  /// Общие данные, переданные скрипту; хранятся, пока скрипт может обращаться к их памяти
+  std::map<std::string, TSharedDataPtr> mSharedData;
 
   /// Экземпляр класса GlobalizerProblem
   PyObject* pInstance;
@@ -50,6 +66,13 @@ protected:
   PyObject* funcClass;
 
   PyThreadState* main_ts;
+  /** Мьютекс, упорядочивающий вычисления этого экземпляра
+
+  GlobalizerProblem изменяет свое состояние (point, result) при каждом вычислении, поэтому вызовы
+  одного экземпляра выполняются последовательно; разные экземпляры (см. iOptProblem::Clone)
+  вычисляются независимо
+  */
+  mutable std::mutex mCallMutex;
 
   
   /// <summary>
@@ -60,6 +83,24 @@ protected:
   PyObject* VectorToTuple(std::vector<IOptVariantType> param,
     std::vector<std::string> paramName, std::vector<std::string> mProblemParametersNames);
 
+  /** Вызывает GlobalizerProblem.calculate, должен вызываться под GIL
+  \return Статус значения (IGlobalOptimizationProblem::FUNCTIONAL_OK и др.)
+  */
+  int CallFunction(const double* y, int yCount, PyObject* categorys, int fNumber, int fidelity,
+    double& value) const;
+  /** Вычисляет функцию задачи со статусом, захватывая мьютекс вычисления и GIL
+  \param[in] isPruningEnabled можно ли прервать вычисление функцией #SetPruningCallback
+  \return Статус значения (IGlobalOptimizationProblem::FUNCTIONAL_OK и др.)
+  */
+  int EvaluateFunctionStatus(const double* y, int yCount, const std::string* categorys, int uCount, int fNumber,
+    double& value, int fidelity, bool isPruningEnabled) const;
+  /// Вызывает GlobalizerProblem.calculate_all_functionals, должен вызываться под GIL
+  PyObject* CallAllFunctionals(const double* y, int yCount, PyObject* categorys) const;
+  /// Создает список значений дискретных параметров по их номерам, должен вызываться под GIL
+  PyObject* MakeLabelList(const int* u, int uCount) const;
+  /// Проверяет, что номера значений дискретных параметров допустимы
+  bool IsValidDiscreteIndices(const int* u, int uCount) const;
+
 public:
   /// <summary>
   /// 
@@ -85,12 +126,118 @@ public:
   \return Значение функции с указанным номером
   */
   double EvaluateFunction(const std::vector<double>& y, const std::vector<std::string>& categorys, int fNumber) const;
+  /** Метод, вычисляющий функции задачи по указателям на координаты
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] categorys значения дискретных параметров
+  \param[in] uCount число дискретных параметров
+  \param[in] fNumber Номер вычисляемой функции
+  \param[in] fidelity уровень точности (см. #GetFidelityLevels), -1 -- полное вычисление
+  \return Значение функции с указанным номером, при исключении в скрипте бросает std::runtime_error;
+  вычисление не прерывается функцией #SetPruningCallback, так как без статуса о прерывании не сообщить
+  */
+  double EvaluateFunction(const double* y, int yCount, const std::string* categorys, int uCount, int fNumber,
+    int fidelity = -1) const;
+  /** Метод, вычисляющий функции задачи с возвратом статуса вместо исключения
+
+  Исключение в скрипте дает статус FUNCTIONAL_ERROR, значение None, inf или nan --
+  статус FUNCTIONAL_NOT_COMPUTABLE
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] categorys значения дискретных параметров
+  \param[in] uCount число дискретных параметров
+  \param[in] fNumber Номер вычисляемой функции
+  \param[out] value значение функции
+  \param[in] fidelity уровень точности (см. #GetFidelityLevels), -1 -- полное вычисление
+  \return Статус значения (IGlobalOptimizationProblem::FUNCTIONAL_OK и др.)
+  */
+  int TryEvaluateFunction(const double* y, int yCount, const std::string* categorys, int uCount, int fNumber,
+    double& value, int fidelity = -1) const;
   /** Метод, вычисляющий все функции задачи
 
   \param[in] y непрерывные координаты точки, в которой необходимо вычислить значение
   \return Значение функций
   */
   std::vector<double> EvaluateAllFunction(const std::vector<double>& y, const std::vector<std::string>& categorys) const;
+  /** Метод, вычисляющий все функции задачи в буфер вызывающей стороны
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] categorys значения дискретных параметров
+  \param[in] uCount число дискретных параметров
+  \param[out] values буфер для значений функций
+  \param[in] valuesCount размер буфера values
+  \return Число записанных значений или -1 при ошибке; вычисление не прерывается (см. #EvaluateFunction)
+  */
+  int EvaluateAllFunction(const double* y, int yCount, const std::string* categorys, int uCount,
+    double* values, int valuesCount) const;
+  /** Метод, вычисляющий все функции задачи со статусом для каждой функции
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] categorys значения дискретных параметров
+  \param[in] uCount число дискретных параметров
+  \param[out] values буфер для значений функций
+  \param[out] statuses буфер для статусов значений или nullptr; без статусов вычисление не прерывается
+  \param[in] valuesCount размер буферов values и statuses
+  \return Число записанных значений или -1, если скрипт завершился исключением
+  */
+  int TryEvaluateAllFunction(const double* y, int yCount, const std::string* categorys, int uCount,
+    double* values, int* statuses, int valuesCount) const;
+  /** Метод, вычисляющий функции задачи, дискретные параметры которой заданы номерами значений
+
+  Строки python для значений берутся из кэша, созданного в конструкторе
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u номера значений дискретных параметров
+  \param[in] uCount число дискретных параметров
+  \param[in] fNumber Номер вычисляемой функции
+  \return Значение функции с указанным номером
+  */
+  double EvaluateFunctionByIndex(const double* y, int yCount, const int* u, int uCount, int fNumber) const;
+  /** Метод, вычисляющий все функции задачи, дискретные параметры которой заданы номерами значений
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u номера значений дискретных параметров
+  \param[in] uCount число дискретных параметров
+  \param[out] values буфер для значений функций
+  \param[in] valuesCount размер буфера values
+  \return Число записанных значений или -1 при ошибке
+  */
+  int EvaluateAllFunctionByIndex(const double* y, int yCount, const int* u, int uCount,
+    double* values, int valuesCount) const;
+
+  /** Метод возвращает относительную стоимость уровней точности вычисления
+
+  Уровни берутся из GlobalizerProblem.get_fidelity_levels; если скрипт его не определяет,
+  уровень один -- полное вычисление
+  */
+  const std::vector<double>& GetFidelityLevels() const;
+
+  /** Метод задает функцию прерывания вычисления
+
+  Скрипт сообщает промежуточные значения через Problem.report; функция вызывается под GIL
+  только в вычислениях со статусом (#TryEvaluateFunction, #TryEvaluateAllFunction)
+  и не должна обращаться к этой же задаче
+  \return false, если скрипт не поддерживает передачу промежуточных значений
+  */
+  bool SetPruningCallback(const TPruningCallback& callback);
+  /** Метод передает промежуточное значение текущего вычисления в функцию прерывания
+
+  Вызывается из скрипта функцией report_intermediate во время вычисления
+  \return true, если вычисление нужно прекратить; false, если прерывание текущего вычисления запрещено
+  */
+  bool ReportIntermediateValue(int step, double value) const;
+
+  /** Метод передает скрипту общие данные без копирования
+
+  Вызывает GlobalizerProblem.set_shared_data(name, buffer, dtype, shape), где buffer --
+  memoryview только для чтения над памятью data
+  \return false, если скрипт не принимает общие данные
+  */
+  bool SetSharedData(const std::string& name, const TSharedDataPtr& data);
 
   /** Метод возвращает число общее функций в задаче (оно равно число ограничений + число критериев)
   \return Число функций
@@ -108,7 +255,7 @@ public:
   /** Метод возвращает список дискретных параметров
     \return вектор дискретных параметров
     */
-  virtual std::vector<std::vector<std::string>> GetDescreteParameters();
+  virtual const std::vector<std::vector<std::string>>& GetDescreteParameters() const;
 
   /** ћетод возвращает точку из допустимой области
   \param[out] y непрерывные координаты точки
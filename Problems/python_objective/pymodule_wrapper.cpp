@@ -2,6 +2,8 @@
 
 #include <stdexcept>
 #include <iostream>
+#include <cmath>
+#include <limits>
 
 using namespace std;
 
@@ -140,21 +142,55 @@ int TPythonModuleWrapper::GetDimension() const
 
 // ------------------------------------------------------------------------------------------------
 double TPythonModuleWrapper::EvaluateFunction(const std::vector<double>& y) const
+{
+  return EvaluateFunction(y.data(), mDimension);
+}
+
+// ------------------------------------------------------------------------------------------------
+double TPythonModuleWrapper::EvaluateFunction(const double* y, int yCount) const
 {
   double retval = 0;
-#pragma omp critical
+  if (TryEvaluateFunction(y, yCount, retval) == IGlobalOptimizationProblem::FUNCTIONAL_ERROR)
+    throw std::runtime_error("Error of python function calculation");
+  return retval;
+}
+
+// ------------------------------------------------------------------------------------------------
+int TPythonModuleWrapper::TryEvaluateFunction(const double* y, int yCount, double& value) const
+{
+  int status = IGlobalOptimizationProblem::FUNCTIONAL_OK;
 {
+  std::lock_guard<std::mutex> lock(mCallMutex);
   PyGILState_STATE gstate = PyGILState_Ensure();
-  auto py_arg = makeFloatList(y.data(), mDimension);
+  auto py_arg = makeFloatList(y, yCount);
   auto arglist = PyTuple_Pack(1, py_arg);
   auto result = PyObject_CallObject(mPFunc, arglist);
-  retval = PyFloat_AsDouble(result);
+  value = std::numeric_limits<double>::quiet_NaN();
+  if (!result)
+  {
+    // исключение в скрипте -- ошибка, о которой нужно сообщить
+    PyErr_Print();
+    status = IGlobalOptimizationProblem::FUNCTIONAL_ERROR;
+  }
+  else if (result == Py_None)
+    status = IGlobalOptimizationProblem::FUNCTIONAL_NOT_COMPUTABLE;
+  else
+  {
+    value = PyFloat_AsDouble(result);
+    if (value == -1.0 && PyErr_Occurred())
+    {
+      PyErr_Clear();
+      status = IGlobalOptimizationProblem::FUNCTIONAL_ERROR;
+    }
+    else if (!std::isfinite(value))
+      status = IGlobalOptimizationProblem::FUNCTIONAL_NOT_COMPUTABLE;
+  }
   Py_DECREF(py_arg);
   Py_DECREF(arglist);
-  Py_DECREF(result);
+  Py_XDECREF(result);
   PyGILState_Release(gstate);
 }
-  return retval;
+  return status;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -2,6 +2,9 @@
 
 #include <string>
 #include <vector>
+#include <mutex>
+
+#include "IGlobalOptimizationProblem.h"
 
 #ifndef WIN32
   #ifdef _DEBUG
@@ -35,6 +38,11 @@ protected:
   std::vector<double> mLowerBound;
 
   PyThreadState* main_ts;
+  /** Мьютекс, упорядочивающий вычисления этого экземпляра
+
+  Разные экземпляры вычисляются независимо, порядок вызовов внутри интерпретатора задает GIL
+  */
+  mutable std::mutex mCallMutex;
 
 
 public:
@@ -54,6 +62,23 @@ public:
   \return Значение функции с указанным номером
   */
   double EvaluateFunction(const std::vector<double>& y) const;
+  /** Метод, вычисляющий функцию задачи по указателю на координаты
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число координат
+  \return Значение функции
+  */
+  double EvaluateFunction(const double* y, int yCount) const;
+  /** Метод, вычисляющий функцию задачи с возвратом статуса вместо исключения
+
+  Исключение в скрипте дает статус FUNCTIONAL_ERROR, значение None, inf или nan --
+  статус FUNCTIONAL_NOT_COMPUTABLE
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число координат
+  \param[out] value значение функции
+  \return Статус значения (IGlobalOptimizationProblem::FUNCTIONAL_OK и др.)
+  */
+  int TryEvaluateFunction(const double* y, int yCount, double& value) const;
 
   ~TPythonModuleWrapper();
 };
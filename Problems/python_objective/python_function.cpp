@@ -3,6 +3,7 @@
 #endif
 
 #include "python_function.h"
+#include "StaticProblemRegistry.h"
 
 #include <iostream>
 #include <filesystem>
@@ -99,12 +100,63 @@ int PythonProblem::GetNumberOfCriterions() const
   return 1;
 }
 
+// ------------------------------------------------------------------------------------------------
+int PythonProblem::GetCapabilities(TProblemCapabilities& capabilities) const
+{
+  capabilities = TProblemCapabilities();
+  // вызовы экземпляра упорядочиваются мьютексом обертки и GIL, для параллельной работы служит #Clone
+  capabilities.threadSafety = TProblemCapabilities::THREAD_SERIALIZED;
+  capabilities.hasNativeBatch = false;
+  // детерминированность скрипта неизвестна (например, обучение моделей)
+  capabilities.isDeterministic = false;
+  capabilities.isInterpreterBacked = true;
+  capabilities.functionCost = -1.0;
+  capabilities.preferredBatchSize = 1;
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+IGlobalOptimizationProblem* PythonProblem::Clone() const
+{
+  if (!mIsInitialized)
+    return nullptr;
+
+  PythonProblem* clone = new PythonProblem();
+  clone->mPyFilePath = mPyFilePath;
+  if (clone->Initialize() != IGlobalOptimizationProblem::PROBLEM_OK)
+  {
+    delete clone;
+    return nullptr;
+  }
+  return clone;
+}
+
 // ------------------------------------------------------------------------------------------------
 double PythonProblem::CalculateFunctionals(const std::vector<double>& y, std::vector<std::string>& u, int fNumber)
 {
   return mFunction->EvaluateFunction(y);
 }
 
+// ------------------------------------------------------------------------------------------------
+double PythonProblem::CalculateFunctionals(const double* y, int yCount, const std::string* u, int uCount, int fNumber)
+{
+  return mFunction->EvaluateFunction(y, yCount);
+}
+
+// ------------------------------------------------------------------------------------------------
+int PythonProblem::CalculateAllFunctionals(const double* y, int yCount, const std::string* u, int uCount, double* values)
+{
+  values[0] = mFunction->EvaluateFunction(y, yCount);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int PythonProblem::TryCalculateFunctionals(const double* y, int yCount, const std::string* u, int uCount,
+  int fNumber, double& value)
+{
+  return mFunction->TryEvaluateFunction(y, yCount, value);
+}
+
 // ------------------------------------------------------------------------------------------------
 PythonProblem::~PythonProblem()
 {
@@ -115,14 +167,17 @@ PythonProblem::~PythonProblem()
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API IGlobalOptimizationProblem* create()
+LIB_EXPORT_API IGlobalOptimizationProblem* PROBLEM_EXPORT_NAME(create)()
 {
   return new PythonProblem();
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API void destroy(IGlobalOptimizationProblem* ptr)
+LIB_EXPORT_API void PROBLEM_EXPORT_NAME(destroy)(IGlobalOptimizationProblem* ptr)
 {
   delete ptr;
 }
+
+// ------------------------------------------------------------------------------------------------
+REGISTER_STATIC_PROBLEM(NULL)
 // - end of file ----------------------------------------------------------------------------------
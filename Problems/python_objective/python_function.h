@@ -71,6 +71,17 @@ public:
   */
   virtual int GetNumberOfCriterions() const;
 
+  /** Метод возвращает вычислительные свойства задачи
+  \param[out] capabilities свойства задачи
+  \return Код ошибки (#PROBLEM_OK)
+  */
+  virtual int GetCapabilities(TProblemCapabilities& capabilities) const;
+
+  /** Метод создает независимую копию задачи
+  \return Указатель на копию или nullptr, если задача не инициализирована
+  */
+  virtual IGlobalOptimizationProblem* Clone() const;
+
   /** Метод, вычисляющий функции задачи
 
   \param[in] y непрерывные координаты точки, в которой необходимо вычислить значение
@@ -81,11 +92,47 @@ public:
   */
   virtual double CalculateFunctionals(const std::vector<double>& y, std::vector<std::string>& u, int fNumber);
 
+  /** Метод, вычисляющий функции задачи без создания временных векторов
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки
+  \param[in] uCount число дискретных координат
+  \param[in] fNumber Номер вычисляемой функции
+  \return Значение функции с указанным номером
+  */
+  virtual double CalculateFunctionals(const double* y, int yCount, const std::string* u, int uCount, int fNumber);
+
+  /** Метод, вычисляющий все функции задачи в буфер вызывающей стороны
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки
+  \param[in] uCount число дискретных координат
+  \param[out] values массив из #GetNumberOfFunctions() элементов для значений функций
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int CalculateAllFunctionals(const double* y, int yCount, const std::string* u, int uCount, double* values);
+
+  /** Метод, вычисляющий функцию задачи с возвратом статуса
+
+  Исключение в скрипте не выходит из метода, а дает статус #FUNCTIONAL_ERROR
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки
+  \param[in] uCount число дискретных координат
+  \param[in] fNumber Номер вычисляемой функции
+  \param[out] value значение функции
+  \return Статус значения (#FUNCTIONAL_OK, #FUNCTIONAL_NOT_COMPUTABLE или #FUNCTIONAL_ERROR)
+  */
+  virtual int TryCalculateFunctionals(const double* y, int yCount, const std::string* u, int uCount, int fNumber,
+    double& value);
+
   ~PythonProblem();
 };
 
-extern "C" LIB_EXPORT_API IGlobalOptimizationProblem* create();
-extern "C" LIB_EXPORT_API void destroy(IGlobalOptimizationProblem* ptr);
+extern "C" LIB_EXPORT_API IGlobalOptimizationProblem* PROBLEM_EXPORT_NAME(create)();
+extern "C" LIB_EXPORT_API void PROBLEM_EXPORT_NAME(destroy)(IGlobalOptimizationProblem* ptr);
 
 #endif
 // - end of file ----------------------------------------------------------------------------------
@@ -1,4 +1,5 @@
 ﻿#include "rastrigin_problem.h"
+#include "StaticProblemRegistry.h"
 
 #define _USE_MATH_DEFINES
 #include <math.h>
@@ -98,12 +99,249 @@ int RastriginProblem::GetNumberOfCriterions() const
   return 1;
 }
 
+// ------------------------------------------------------------------------------------------------
+int RastriginProblem::GetCapabilities(TProblemCapabilities& capabilities) const
+{
+  capabilities = TProblemCapabilities();
+  capabilities.threadSafety = TProblemCapabilities::THREAD_REENTRANT;
+  capabilities.hasNativeBatch = true;
+  capabilities.hasIncrementalEvaluation = true;
+  capabilities.isDeterministic = true;
+  // один косинус на координату
+  capabilities.functionCost = 2e-8 * mDimension;
+  capabilities.preferredBatchSize = 256;
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginProblem::GetLipschitzConstant(int fNumber, double& constant) const
+{
+  if (!mIsInitialized || fNumber < 0 || fNumber >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_UNDEFINED;
+
+  // |d/dx (x^2 - 10 cos(2 pi x))| <= 2 max|x| + 20 pi на [-2.2, 1.8]
+  constant = sqrt((double)mDimension) * (2.0 * 2.2 + 20.0 * M_PI);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+IGlobalOptimizationProblem* RastriginProblem::Clone() const
+{
+  return new RastriginProblem(*this);
+}
+
+// ------------------------------------------------------------------------------------------------
+inline double RastriginProblem::CalculateFunction(const double* x, int fNumber) const
+{
+  double sum = 0.;
+  for (int j = 0; j < mDimension; j++)
+    sum += x[j] * x[j] - 10. * cos(2.0 * M_PI * x[j]) + 10.0;
+  return sum;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline float RastriginProblem::CalculateFunctionFloat(const float* x, int fNumber) const
+{
+  const float twoPi = (float)(2.0 * M_PI);
+  float sum = 0.f;
+  for (int j = 0; j < mDimension; j++)
+    sum += x[j] * x[j] - 10.f * cosf(twoPi * x[j]) + 10.f;
+  return sum;
+}
+
 // ------------------------------------------------------------------------------------------------
 double RastriginProblem::CalculateFunctionals(const std::vector<double>& x, std::vector<std::string>& u, int fNumber)
+{
+  return CalculateFunction(x.data(), fNumber);
+}
+
+// ------------------------------------------------------------------------------------------------
+double RastriginProblem::CalculateFunctionals(const double* y, int yCount, const std::string* u, int uCount, int fNumber)
+{
+  return CalculateFunction(y, fNumber);
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginProblem::CalculateAllFunctionals(const double* y, int yCount, const std::string* u, int uCount, double* values)
+{
+  if (yCount < mDimension)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  int numberOfFunctions = GetNumberOfFunctions();
+  for (int i = 0; i < numberOfFunctions; i++)
+    values[i] = CalculateFunction(y, i);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginProblem::CalculateFunctionalsBatch(const double* y, int numPoints, int stride, int fNumber, double* values)
+{
+  if (stride == 0)
+    stride = mDimension;
+  if (stride < mDimension || numPoints < 0)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  for (int i = 0; i < numPoints; i++)
+    values[i] = CalculateFunction(y + (size_t)i * stride, fNumber);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginProblem::CalculateFunctionalsBatchFloat(const float* y, int numPoints, int stride, int fNumber, float* values)
+{
+  if (stride == 0)
+    stride = mDimension;
+  if (stride < mDimension || numPoints < 0)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  for (int i = 0; i < numPoints; i++)
+    values[i] = CalculateFunctionFloat(y + (size_t)i * stride, fNumber);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline double RastriginProblem::CoordinateTerm(double x) const
+{
+  return x * x - 10. * cos(2.0 * M_PI * x) + 10.0;
+}
+
+// ------------------------------------------------------------------------------------------------
+void RastriginProblem::SumIncrementalState(TIncrementalState& state) const
 {
   double sum = 0.;
   for (int j = 0; j < mDimension; j++)
+    sum += CoordinateTerm(state.point[j]);
+  state.data.assign(1, sum);
+  state.values.assign(1, sum);
+  state.numberOfUpdates = 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginProblem::InitializeIncrementalState(const double* y, int yCount, TIncrementalState& state)
+{
+  if (yCount < mDimension)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  state.point.assign(y, y + mDimension);
+  SumIncrementalState(state);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginProblem::UpdateIncrementalState(TIncrementalState& state, int coordinate, double value)
+{
+  if (coordinate < 0 || coordinate >= mDimension || (int)state.point.size() != mDimension ||
+    state.data.size() != 1 || state.values.size() != 1)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  double previous = state.point[coordinate];
+  state.point[coordinate] = value;
+  if (++state.numberOfUpdates >= mDimension)
+  {
+    SumIncrementalState(state);
+    return IGlobalOptimizationProblem::PROBLEM_OK;
+  }
+  state.data[0] += CoordinateTerm(value) - CoordinateTerm(previous);
+  state.values[0] = state.data[0];
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginProblem::GetFunctionalStructure(int fNumber, TFunctionalStructure& structure) const
+{
+  if (fNumber < 0 || fNumber >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  structure = TFunctionalStructure();
+  structure.isSeparable = true;
+  structure.variables.resize(mDimension);
+  structure.blocks.resize(mDimension);
+  for (int j = 0; j < mDimension; j++)
+  {
+    structure.variables[j] = j;
+    structure.blocks[j].assign(1, j);
+  }
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginProblem::CalculateFunctionalElements(const double* y, int yCount, int fNumber, const int* blocks,
+  int count, double* elements)
+{
+  if (yCount < mDimension || fNumber < 0 || fNumber >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  for (int k = 0; k < count; k++)
+  {
+    if (blocks[k] < 0 || blocks[k] >= mDimension)
+      return IGlobalOptimizationProblem::PROBLEM_ERROR;
+    elements[k] = CoordinateTerm(y[blocks[k]]);
+  }
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginProblem::CalculateFunctionalGradient(const double* y, int yCount, int fNumber, double& value, double* gradient)
+{
+  if (yCount < mDimension || fNumber < 0 || fNumber >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  value = CalculateGradient(y, fNumber, gradient);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginProblem::CalculateFunctionalGradientBatch(const double* y, int numPoints, int stride, int fNumber,
+  double* values, double* gradients)
+{
+  if (stride == 0)
+    stride = mDimension;
+  if (stride < mDimension || numPoints < 0 || fNumber < 0 || fNumber >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  for (int i = 0; i < numPoints; i++)
+    values[i] = CalculateGradient(y + (size_t)i * stride, fNumber, gradients + (size_t)i * mDimension);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginProblem::CalculateFunctionalBounds(const double* lower, const double* upper, int yCount, int fNumber,
+  double& fLower, double& fUpper)
+{
+  if (yCount < mDimension || fNumber < 0 || fNumber >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+  for (int j = 0; j < mDimension; j++)
+    if (!(lower[j] <= upper[j]))
+      return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  TInterval bounds = CalculateFunctionBounds(lower, upper, fNumber);
+  fLower = bounds.lower;
+  fUpper = bounds.upper;
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline TInterval RastriginProblem::CalculateFunctionBounds(const double* lower, const double* upper, int fNumber) const
+{
+  // функция сепарабельна, поэтому оценка строится по каждой координате отдельно
+  TInterval sum = 0.;
+  for (int j = 0; j < mDimension; j++)
+  {
+    TInterval x(lower[j], upper[j]);
+    sum = sum + (Sqr(x) - 10. * Cos(2.0 * M_PI * x) + 10.0);
+  }
+  return sum;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline double RastriginProblem::CalculateGradient(const double* x, int fNumber, double* gradient) const
+{
+  double sum = 0.;
+  for (int j = 0; j < mDimension; j++)
+  {
     sum += x[j] * x[j] - 10. * cos(2.0 * M_PI * x[j]) + 10.0;
+    gradient[j] = 2.0 * x[j] + 20.0 * M_PI * sin(2.0 * M_PI * x[j]);
+  }
   return sum;
 }
 
@@ -132,26 +370,32 @@ RastriginProblem::~RastriginProblem()
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API IGlobalOptimizationProblem* create()
+LIB_EXPORT_API IGlobalOptimizationProblem* PROBLEM_EXPORT_NAME(create)()
 {
   return new RastriginProblem();
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API void destroy(IGlobalOptimizationProblem* ptr)
+LIB_EXPORT_API void PROBLEM_EXPORT_NAME(destroy)(IGlobalOptimizationProblem* ptr)
 {
   delete ptr;
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API double Calculation1D(double x, int fType, int fNum)
+LIB_EXPORT_API int PROBLEM_EXPORT_NAME(getKernelTable)(void* problem, int version, TProblemKernelTable* table)
+{
+  return TProblemKernels<RastriginProblem>::Fill(problem, version, table);
+}
+
+// ------------------------------------------------------------------------------------------------
+LIB_EXPORT_API double PROBLEM_EXPORT_NAME(Calculation1D)(double x, int fType, int fNum)
 {
   std::cout << "Calculation\n" << std::endl;
   return x + fType + fNum;
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API double Calculation(double x, double y)
+LIB_EXPORT_API double PROBLEM_EXPORT_NAME(Calculation)(double x, double y)
 {
   double result = 0;
 
@@ -167,7 +411,7 @@ LIB_EXPORT_API double Calculation(double x, double y)
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API double GetUpperBounds()
+LIB_EXPORT_API double PROBLEM_EXPORT_NAME(GetUpperBounds)()
 {
   double result = 0;
 
@@ -184,7 +428,7 @@ LIB_EXPORT_API double GetUpperBounds()
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API double GetLowerBounds()
+LIB_EXPORT_API double PROBLEM_EXPORT_NAME(GetLowerBounds)()
 {
   double result = 0;
 
@@ -198,4 +442,7 @@ LIB_EXPORT_API double GetLowerBounds()
   result = Lower[0];
   return result;
 }
+
+// ------------------------------------------------------------------------------------------------
+REGISTER_STATIC_PROBLEM(PROBLEM_EXPORT_NAME(getKernelTable))
 // - end of file ----------------------------------------------------------------------------------
@@ -1,4 +1,5 @@
 ﻿#include "rastriginC1_problem.h"
+#include "StaticProblemRegistry.h"
 
 #define _USE_MATH_DEFINES
 #include <math.h>
@@ -98,21 +99,281 @@ int RastriginC1Problem::GetNumberOfCriterions() const
   return 1;
 }
 
+// ------------------------------------------------------------------------------------------------
+int RastriginC1Problem::GetCapabilities(TProblemCapabilities& capabilities) const
+{
+  capabilities = TProblemCapabilities();
+  capabilities.threadSafety = TProblemCapabilities::THREAD_REENTRANT;
+  capabilities.hasNativeBatch = true;
+  capabilities.hasIncrementalEvaluation = true;
+  capabilities.isDeterministic = true;
+  // не более одного косинуса на координату
+  capabilities.functionCost = 2e-8 * mDimension;
+  capabilities.preferredBatchSize = 256;
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginC1Problem::GetLipschitzConstant(int fNumber, double& constant) const
+{
+  if (!mIsInitialized || fNumber < 0 || fNumber >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_UNDEFINED;
+
+  // область поиска [-2.2, 1.8], max|x| = 2.2
+  if (fNumber == 0)
+    constant = sqrt((double)mDimension) * 2.0 * 2.2;
+  else
+    constant = sqrt((double)mDimension) * (2.0 * 2.2 + 20.0 * M_PI);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+IGlobalOptimizationProblem* RastriginC1Problem::Clone() const
+{
+  return new RastriginC1Problem(*this);
+}
+
+// ------------------------------------------------------------------------------------------------
+inline double RastriginC1Problem::CalculateFunction(const double* x, int fNumber) const
+{
+  double sum = 0.;
+  if (fNumber == 0)
+  {
+    for (int j = 0; j < mDimension; j++)
+      sum += x[j] * x[j];
+
+    sum += -1.5;
+  }
+  else if (fNumber == 1)
+  {
+    for (int j = 0; j < mDimension; j++)
+      sum += x[j] * x[j] - 10. * cos(2.0 * M_PI * x[j]) + 10.0;
+  }
+  return sum;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline float RastriginC1Problem::CalculateFunctionFloat(const float* x, int fNumber) const
+{
+  const float twoPi = (float)(2.0 * M_PI);
+  float sum = 0.f;
+  if (fNumber == 0)
+  {
+    for (int j = 0; j < mDimension; j++)
+      sum += x[j] * x[j];
+
+    sum += -1.5f;
+  }
+  else if (fNumber == 1)
+  {
+    for (int j = 0; j < mDimension; j++)
+      sum += x[j] * x[j] - 10.f * cosf(twoPi * x[j]) + 10.f;
+  }
+  return sum;
+}
+
 // ------------------------------------------------------------------------------------------------
 double RastriginC1Problem::CalculateFunctionals(const std::vector<double>& x, std::vector<std::string>& u, int fNumber)
+{
+  return CalculateFunction(x.data(), fNumber);
+}
+
+// ------------------------------------------------------------------------------------------------
+double RastriginC1Problem::CalculateFunctionals(const double* y, int yCount, const std::string* u, int uCount, int fNumber)
+{
+  return CalculateFunction(y, fNumber);
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginC1Problem::CalculateAllFunctionals(const double* y, int yCount, const std::string* u, int uCount, double* values)
+{
+  if (yCount < mDimension)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  int numberOfFunctions = GetNumberOfFunctions();
+  for (int i = 0; i < numberOfFunctions; i++)
+    values[i] = CalculateFunction(y, i);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginC1Problem::CalculateFunctionalsUpTo(const double* y, int yCount, const std::string* u, int uCount,
+  int lastIndex, double* values)
+{
+  if (yCount < mDimension || lastIndex < 0 || lastIndex >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  int numberOfConstraints = GetNumberOfConstraints();
+  for (int i = 0; i <= lastIndex; i++)
+  {
+    values[i] = CalculateFunction(y, i);
+    if (i < numberOfConstraints && values[i] > 0)
+      return i;
+  }
+  return lastIndex;
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginC1Problem::CalculateFunctionalsBatch(const double* y, int numPoints, int stride, int fNumber, double* values)
+{
+  if (stride == 0)
+    stride = mDimension;
+  if (stride < mDimension || numPoints < 0)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  for (int i = 0; i < numPoints; i++)
+    values[i] = CalculateFunction(y + (size_t)i * stride, fNumber);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginC1Problem::CalculateFunctionalsBatchFloat(const float* y, int numPoints, int stride, int fNumber, float* values)
+{
+  if (stride == 0)
+    stride = mDimension;
+  if (stride < mDimension || numPoints < 0)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  for (int i = 0; i < numPoints; i++)
+    values[i] = CalculateFunctionFloat(y + (size_t)i * stride, fNumber);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline double RastriginC1Problem::CoordinateTerm(double x, int fNumber) const
+{
+  if (fNumber == 0)
+    return x * x;
+  return x * x - 10. * cos(2.0 * M_PI * x) + 10.0;
+}
+
+// ------------------------------------------------------------------------------------------------
+void RastriginC1Problem::SumIncrementalState(TIncrementalState& state) const
+{
+  state.data.assign(2, 0.);
+  for (int j = 0; j < mDimension; j++)
+  {
+    state.data[0] += CoordinateTerm(state.point[j], 0);
+    state.data[1] += CoordinateTerm(state.point[j], 1);
+  }
+  state.values.resize(2);
+  state.values[0] = state.data[0] - 1.5;
+  state.values[1] = state.data[1];
+  state.numberOfUpdates = 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginC1Problem::InitializeIncrementalState(const double* y, int yCount, TIncrementalState& state)
+{
+  if (yCount < mDimension)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  state.point.assign(y, y + mDimension);
+  SumIncrementalState(state);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginC1Problem::UpdateIncrementalState(TIncrementalState& state, int coordinate, double value)
+{
+  if (coordinate < 0 || coordinate >= mDimension || (int)state.point.size() != mDimension ||
+    state.data.size() != 2 || state.values.size() != 2)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  double previous = state.point[coordinate];
+  state.point[coordinate] = value;
+  if (++state.numberOfUpdates >= mDimension)
+  {
+    SumIncrementalState(state);
+    return IGlobalOptimizationProblem::PROBLEM_OK;
+  }
+  state.data[0] += CoordinateTerm(value, 0) - CoordinateTerm(previous, 0);
+  state.data[1] += CoordinateTerm(value, 1) - CoordinateTerm(previous, 1);
+  state.values[0] = state.data[0] - 1.5;
+  state.values[1] = state.data[1];
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginC1Problem::GetFunctionalStructure(int fNumber, TFunctionalStructure& structure) const
+{
+  if (fNumber < 0 || fNumber >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  structure = TFunctionalStructure();
+  structure.isSeparable = true;
+  structure.constant = fNumber == 0 ? -1.5 : 0.0;
+  structure.variables.resize(mDimension);
+  structure.blocks.resize(mDimension);
+  for (int j = 0; j < mDimension; j++)
+  {
+    structure.variables[j] = j;
+    structure.blocks[j].assign(1, j);
+  }
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginC1Problem::CalculateFunctionalElements(const double* y, int yCount, int fNumber, const int* blocks,
+  int count, double* elements)
+{
+  if (yCount < mDimension || fNumber < 0 || fNumber >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  for (int k = 0; k < count; k++)
+  {
+    if (blocks[k] < 0 || blocks[k] >= mDimension)
+      return IGlobalOptimizationProblem::PROBLEM_ERROR;
+    elements[k] = CoordinateTerm(y[blocks[k]], fNumber);
+  }
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginC1Problem::CalculateFunctionalGradient(const double* y, int yCount, int fNumber, double& value, double* gradient)
+{
+  if (yCount < mDimension || fNumber < 0 || fNumber >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  value = CalculateGradient(y, fNumber, gradient);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginC1Problem::CalculateFunctionalGradientBatch(const double* y, int numPoints, int stride, int fNumber,
+  double* values, double* gradients)
+{
+  if (stride == 0)
+    stride = mDimension;
+  if (stride < mDimension || numPoints < 0 || fNumber < 0 || fNumber >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  for (int i = 0; i < numPoints; i++)
+    values[i] = CalculateGradient(y + (size_t)i * stride, fNumber, gradients + (size_t)i * mDimension);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline double RastriginC1Problem::CalculateGradient(const double* x, int fNumber, double* gradient) const
 {
   double sum = 0.;
   if (fNumber == 0)
   {
     for (int j = 0; j < mDimension; j++)
+    {
       sum += x[j] * x[j];
+      gradient[j] = 2.0 * x[j];
+    }
 
     sum += -1.5;
   }
   else if (fNumber == 1)
   {
     for (int j = 0; j < mDimension; j++)
+    {
       sum += x[j] * x[j] - 10. * cos(2.0 * M_PI * x[j]) + 10.0;
+      gradient[j] = 2.0 * x[j] + 20.0 * M_PI * sin(2.0 * M_PI * x[j]);
+    }
   }
   return sum;
 }
@@ -143,15 +404,23 @@ inline int RastriginC1Problem::GetStartTrial(std::vector<double>& y, std::vector
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API IGlobalOptimizationProblem* create()
+LIB_EXPORT_API IGlobalOptimizationProblem* PROBLEM_EXPORT_NAME(create)()
 {
   return new RastriginC1Problem();
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API void destroy(IGlobalOptimizationProblem* ptr)
+LIB_EXPORT_API void PROBLEM_EXPORT_NAME(destroy)(IGlobalOptimizationProblem* ptr)
 {
   delete ptr;
 }
 
+// ------------------------------------------------------------------------------------------------
+LIB_EXPORT_API int PROBLEM_EXPORT_NAME(getKernelTable)(void* problem, int version, TProblemKernelTable* table)
+{
+  return TProblemKernels<RastriginC1Problem>::Fill(problem, version, table);
+}
+
+// ------------------------------------------------------------------------------------------------
+REGISTER_STATIC_PROBLEM(PROBLEM_EXPORT_NAME(getKernelTable))
 // - end of file ----------------------------------------------------------------------------------
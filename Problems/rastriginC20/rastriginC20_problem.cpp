@@ -1,4 +1,5 @@
 ﻿#include "rastriginC20_problem.h"
+#include "StaticProblemRegistry.h"
 
 #define _USE_MATH_DEFINES
 #include <math.h>
@@ -99,9 +100,100 @@ int rastriginC20Problem::GetNumberOfCriterions() const
 }
 
 // ------------------------------------------------------------------------------------------------
-double rastriginC20Problem::CalculateFunctionals(const std::vector<double>& x, std::vector<std::string>& u, int fNumber)
+int rastriginC20Problem::GetCapabilities(TProblemCapabilities& capabilities) const
+{
+  capabilities = TProblemCapabilities();
+  capabilities.threadSafety = TProblemCapabilities::THREAD_REENTRANT;
+  capabilities.hasNativeBatch = true;
+  capabilities.hasIncrementalEvaluation = true;
+  capabilities.isDeterministic = true;
+  // не более одной трансцендентной функции на координату
+  capabilities.functionCost = 2e-8 * mDimension;
+  capabilities.preferredBatchSize = 256;
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int rastriginC20Problem::GetLipschitzConstant(int fNumber, double& constant) const
+{
+  if (!mIsInitialized || fNumber < 0 || fNumber >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_UNDEFINED;
+
+  // для сепарабельных функций L = sqrt(n) * max|g'(x)|, где g -- слагаемое от одной координаты;
+  // область поиска [-2.2, 1.8], max|x| = 2.2
+  const double m = 2.2;
+  double n = mDimension;
+  double rootN = sqrt(n);
+  switch (fNumber)
+  {
+  case 0:
+  case 1:
+    constant = rootN * 2.0 * m;
+    break;
+  case 2:
+  case 3:
+  case 4:
+  case 6:
+  case 9:
+  case 11:
+    constant = rootN;
+    break;
+  case 5:
+    constant = rootN * exp(m);
+    break;
+  case 7:
+    constant = rootN * 4.0 * m * m * m;
+    break;
+  case 8:
+    constant = rootN * (3.0 * m * m + 2.0 * m);
+    break;
+  case 10:
+    constant = rootN * (1.0 + m);
+    break;
+  case 12:
+    // max|2x (1 - tanh^2(x^2))| ~ 1.1131
+    constant = rootN * 1.12;
+    break;
+  case 13:
+    // градиент 2 * sum(x) по каждой координате
+    constant = rootN * 2.0 * n * m;
+    break;
+  case 14:
+    // градиент 2 D^T D x, где D -- матрица разностей соседних координат, ||D|| <= 2
+    constant = 8.0 * rootN * m;
+    break;
+  case 15:
+    constant = rootN * (4.0 * m + m * m);
+    break;
+  case 16:
+    constant = rootN * 1.5 * sqrt(m);
+    break;
+  case 17:
+    // max|2x / (1 + x^2)^2| = 3 sqrt(3) / 8
+    constant = rootN * 3.0 * sqrt(3.0) / 8.0;
+    break;
+  case 18:
+    constant = rootN * sinh(2.0 * m);
+    break;
+  case 19:
+    constant = rootN * 2.0 * m * pow(1.0 + m * m, n - 1.0);
+    break;
+  case 20:
+    constant = rootN * (2.0 * m + 20.0 * M_PI);
+    break;
+  }
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+IGlobalOptimizationProblem* rastriginC20Problem::Clone() const
+{
+  return new rastriginC20Problem(*this);
+}
+
+// ------------------------------------------------------------------------------------------------
+inline double rastriginC20Problem::CalculateFunction(const double* x, int fNumber) const
 {
-  
   if (fNumber == 20)
   {
     double sum = 0.;
@@ -274,6 +366,698 @@ double rastriginC20Problem::CalculateFunctionals(const std::vector<double>& x, s
     }
     return prod - 1.0 - 1.1;
   }
+  return 0.0;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline float rastriginC20Problem::CalculateFunctionFloat(const float* x, int fNumber) const
+{
+  float sum = 0.f;
+  if (fNumber == 20)
+  {
+    const float twoPi = (float)(2.0 * M_PI);
+    for (int j = 0; j < mDimension; j++)
+      sum += x[j] * x[j] - 10.f * cosf(twoPi * x[j]) + 10.f;
+    return sum;
+  }
+  else if (fNumber == 0 || fNumber == 1)
+  {
+    for (int j = 0; j < mDimension; j++)
+      sum += x[j] * x[j];
+    return (float)(sum - pow(fNumber == 0 ? 1.25 : 1.2, mDimension));
+  }
+  else if (fNumber == 2 || fNumber == 3)
+  {
+    for (int j = 0; j < mDimension; j++)
+      sum += x[j];
+    return (fNumber == 2 ? sum : -sum) - 1.5f;
+  }
+
+  // остальные ограничения вычисляются в double, выигрыш от float для них невелик
+  double point[mMaxDimension];
+  for (int j = 0; j < mDimension; j++)
+    point[j] = x[j];
+  return (float)CalculateFunction(point, fNumber);
+}
+
+// ------------------------------------------------------------------------------------------------
+inline double rastriginC20Problem::CoordinateTerm(double x, int fNumber) const
+{
+  switch (fNumber)
+  {
+  case 0:
+  case 1:
+    return x * x;
+  case 2:
+  case 13:
+    return x;
+  case 3:
+    return -x;
+  case 4:
+    return fabs(x);
+  case 5:
+    return exp(fabs(x)) - 1.0;
+  case 6:
+    return sin(x) * sin(x);
+  case 7:
+    return x * x * x * x;
+  case 8:
+    return x * x * x + x * x;
+  case 9:
+    return cos(x);
+  case 10:
+    return x * sin(x);
+  case 11:
+    return log(1.0 + x * x);
+  case 12:
+    return tanh(x * x);
+  case 15:
+    return x * x * (1.0 + cos(x));
+  case 16:
+    return pow(fabs(x), 1.5);
+  case 17:
+    return (x * x) / (1.0 + x * x);
+  case 18:
+    return sinh(x) * sinh(x);
+  case 19:
+    return 1.0 + x * x;
+  case 20:
+    return x * x - 10. * cos(2.0 * M_PI * x) + 10.0;
+  }
+  return 0.0;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline double rastriginC20Problem::NeighbourTerm(const double* x, int j) const
+{
+  double sum = 0.;
+  if (j > 0)
+    sum += (x[j] - x[j - 1]) * (x[j] - x[j - 1]);
+  if (j + 1 < mDimension)
+    sum += (x[j + 1] - x[j]) * (x[j + 1] - x[j]);
+  return sum;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline double rastriginC20Problem::FunctionFromSum(double sum, int fNumber) const
+{
+  switch (fNumber)
+  {
+  case 0:
+    return sum - pow(1.25, mDimension);
+  case 1:
+    return sum - pow(1.2, mDimension);
+  case 2:
+  case 3:
+  case 4:
+    return sum - 1.5;
+  case 7:
+  case 8:
+    return sum - 1.01;
+  case 9:
+    return mDimension - sum - 1.1;
+  case 13:
+    return sum * sum - 1.01;
+  case 14:
+    return mDimension < 2 ? -0.1 : sum - 1.1;
+  case 19:
+    return sum - 1.0 - 1.1;
+  case 20:
+    return sum;
+  }
+  return sum - 1.1;
+}
+
+// ------------------------------------------------------------------------------------------------
+void rastriginC20Problem::SumIncrementalState(TIncrementalState& state) const
+{
+  const double* x = state.point.data();
+  int numberOfFunctions = GetNumberOfFunctions();
+  state.data.assign(numberOfFunctions, 0.);
+  state.data[19] = 1.0;
+  for (int j = 0; j < mDimension; j++)
+  {
+    for (int i = 0; i < numberOfFunctions; i++)
+    {
+      if (i == 19)
+        state.data[i] *= CoordinateTerm(x[j], i);
+      else if (i != 14)
+        state.data[i] += CoordinateTerm(x[j], i);
+    }
+    if (j + 1 < mDimension)
+      state.data[14] += (x[j + 1] - x[j]) * (x[j + 1] - x[j]);
+  }
+
+  state.values.resize(numberOfFunctions);
+  for (int i = 0; i < numberOfFunctions; i++)
+    state.values[i] = FunctionFromSum(state.data[i], i);
+  state.numberOfUpdates = 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+int rastriginC20Problem::InitializeIncrementalState(const double* y, int yCount, TIncrementalState& state)
+{
+  if (yCount < mDimension)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  state.point.assign(y, y + mDimension);
+  SumIncrementalState(state);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int rastriginC20Problem::UpdateIncrementalState(TIncrementalState& state, int coordinate, double value)
+{
+  int numberOfFunctions = GetNumberOfFunctions();
+  if (coordinate < 0 || coordinate >= mDimension || (int)state.point.size() != mDimension ||
+    (int)state.data.size() != numberOfFunctions || (int)state.values.size() != numberOfFunctions)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  double previous = state.point[coordinate];
+  double previousNeighbours = NeighbourTerm(state.point.data(), coordinate);
+  state.point[coordinate] = value;
+  if (++state.numberOfUpdates >= mDimension)
+  {
+    SumIncrementalState(state);
+    return IGlobalOptimizationProblem::PROBLEM_OK;
+  }
+
+  for (int i = 0; i < numberOfFunctions; i++)
+  {
+    if (i == 14)
+      state.data[i] += NeighbourTerm(state.point.data(), coordinate) - previousNeighbours;
+    else if (i == 19)
+      state.data[i] *= CoordinateTerm(value, i) / CoordinateTerm(previous, i);
+    else
+      state.data[i] += CoordinateTerm(value, i) - CoordinateTerm(previous, i);
+    state.values[i] = FunctionFromSum(state.data[i], i);
+  }
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int rastriginC20Problem::GetFunctionalStructure(int fNumber, TFunctionalStructure& structure) const
+{
+  if (fNumber < 0 || fNumber >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  structure = TFunctionalStructure();
+  structure.variables.resize(mDimension);
+  for (int j = 0; j < mDimension; j++)
+    structure.variables[j] = j;
+
+  if (fNumber == 13 || fNumber == 19)
+    return IGlobalOptimizationProblem::PROBLEM_OK;
+
+  structure.isSeparable = true;
+  structure.constant = FunctionFromSum(0.0, fNumber);
+  if (fNumber == 14)
+  {
+    // при n = 1 функция постоянна
+    if (mDimension < 2)
+      structure.variables.clear();
+    for (int j = 0; j + 1 < mDimension; j++)
+      structure.blocks.push_back({ j, j + 1 });
+  }
+  else
+  {
+    structure.blocks.resize(mDimension);
+    for (int j = 0; j < mDimension; j++)
+      structure.blocks[j].assign(1, j);
+  }
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int rastriginC20Problem::CalculateFunctionalElements(const double* y, int yCount, int fNumber, const int* blocks,
+  int count, double* elements)
+{
+  if (yCount < mDimension || fNumber < 0 || fNumber >= GetNumberOfFunctions() || fNumber == 13 || fNumber == 19)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  int numberOfBlocks = fNumber == 14 ? mDimension - 1 : mDimension;
+  for (int k = 0; k < count; k++)
+  {
+    int j = blocks[k];
+    if (j < 0 || j >= numberOfBlocks)
+      return IGlobalOptimizationProblem::PROBLEM_ERROR;
+    if (fNumber == 14)
+      elements[k] = (y[j + 1] - y[j]) * (y[j + 1] - y[j]);
+    else if (fNumber == 9)
+      // функция 9 вычитает сумму косинусов
+      elements[k] = -CoordinateTerm(y[j], fNumber);
+    else
+      elements[k] = CoordinateTerm(y[j], fNumber);
+  }
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+double rastriginC20Problem::CalculateFunctionals(const std::vector<double>& x, std::vector<std::string>& u, int fNumber)
+{
+  return CalculateFunction(x.data(), fNumber);
+}
+
+// ------------------------------------------------------------------------------------------------
+double rastriginC20Problem::CalculateFunctionals(const double* y, int yCount, const std::string* u, int uCount, int fNumber)
+{
+  return CalculateFunction(y, fNumber);
+}
+
+// ------------------------------------------------------------------------------------------------
+int rastriginC20Problem::CalculateAllFunctionals(const double* y, int yCount, const std::string* u, int uCount, double* values)
+{
+  if (yCount < mDimension)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  int numberOfFunctions = GetNumberOfFunctions();
+  for (int i = 0; i < numberOfFunctions; i++)
+    values[i] = CalculateFunction(y, i);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline void rastriginC20Problem::CalculateSharedSums(const double* x, TSharedSums& sums) const
+{
+  sums.sum = 0.;
+  sums.sumSquares = 0.;
+  sums.sumAbs = 0.;
+  sums.sumFourth = 0.;
+  sums.sumCubesSquares = 0.;
+  for (int j = 0; j < mDimension; j++)
+  {
+    sums.sum += x[j];
+    sums.sumSquares += x[j] * x[j];
+    sums.sumAbs += fabs(x[j]);
+    sums.sumFourth += x[j] * x[j] * x[j] * x[j];
+    sums.sumCubesSquares += x[j] * x[j] * x[j] + x[j] * x[j];
+  }
+}
+
+// ------------------------------------------------------------------------------------------------
+int rastriginC20Problem::CalculateFunctionalsUpTo(const double* y, int yCount, const std::string* u, int uCount,
+  int lastIndex, double* values)
+{
+  if (yCount < mDimension || lastIndex < 0 || lastIndex >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  // суммы, общие для ограничений 0-4, 7, 8 и 13, считаются один раз при первом обращении
+  TSharedSums sums;
+  bool isSumsComputed = false;
+  auto shared = [&]() -> const TSharedSums&
+  {
+    if (!isSumsComputed)
+    {
+      CalculateSharedSums(y, sums);
+      isSumsComputed = true;
+    }
+    return sums;
+  };
+
+  int numberOfConstraints = GetNumberOfConstraints();
+  for (int i = 0; i <= lastIndex; i++)
+  {
+    switch (i)
+    {
+    case 0:
+      values[i] = shared().sumSquares - pow(1.25, mDimension);
+      break;
+    case 1:
+      values[i] = shared().sumSquares - pow(1.2, mDimension);
+      break;
+    case 2:
+      values[i] = shared().sum - 1.5;
+      break;
+    case 3:
+      values[i] = -shared().sum - 1.5;
+      break;
+    case 4:
+      values[i] = shared().sumAbs - 1.5;
+      break;
+    case 7:
+      values[i] = shared().sumFourth - 1.01;
+      break;
+    case 8:
+      values[i] = shared().sumCubesSquares - 1.01;
+      break;
+    case 13:
+      values[i] = shared().sum * shared().sum - 1.01;
+      break;
+    default:
+      values[i] = CalculateFunction(y, i);
+    }
+    if (i < numberOfConstraints && values[i] > 0)
+      return i;
+  }
+  return lastIndex;
+}
+
+// ------------------------------------------------------------------------------------------------
+int rastriginC20Problem::CalculateFunctionalsBatch(const double* y, int numPoints, int stride, int fNumber, double* values)
+{
+  if (stride == 0)
+    stride = mDimension;
+  if (stride < mDimension || numPoints < 0)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  for (int i = 0; i < numPoints; i++)
+    values[i] = CalculateFunction(y + (size_t)i * stride, fNumber);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int rastriginC20Problem::CalculateFunctionalsBatchFloat(const float* y, int numPoints, int stride, int fNumber, float* values)
+{
+  if (stride == 0)
+    stride = mDimension;
+  if (stride < mDimension || numPoints < 0)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  for (int i = 0; i < numPoints; i++)
+    values[i] = CalculateFunctionFloat(y + (size_t)i * stride, fNumber);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int rastriginC20Problem::CalculateFunctionalGradient(const double* y, int yCount, int fNumber, double& value, double* gradient)
+{
+  if (yCount < mDimension || fNumber < 0 || fNumber >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  value = CalculateGradient(y, fNumber, gradient);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int rastriginC20Problem::CalculateFunctionalGradientBatch(const double* y, int numPoints, int stride, int fNumber,
+  double* values, double* gradients)
+{
+  if (stride == 0)
+    stride = mDimension;
+  if (stride < mDimension || numPoints < 0 || fNumber < 0 || fNumber >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  for (int i = 0; i < numPoints; i++)
+    values[i] = CalculateGradient(y + (size_t)i * stride, fNumber, gradients + (size_t)i * mDimension);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int rastriginC20Problem::CalculateFunctionalBounds(const double* lower, const double* upper, int yCount, int fNumber,
+  double& fLower, double& fUpper)
+{
+  if (yCount < mDimension || fNumber < 0 || fNumber >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+  for (int j = 0; j < mDimension; j++)
+    if (!(lower[j] <= upper[j]))
+      return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  TInterval bounds = CalculateFunctionBounds(lower, upper, fNumber);
+  fLower = bounds.lower;
+  fUpper = bounds.upper;
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline TInterval rastriginC20Problem::CalculateFunctionBounds(const double* lower, const double* upper, int fNumber) const
+{
+  // все функции, кроме 13, 14 и 19, -- суммы слагаемых от одной координаты
+  TInterval sum = 0.;
+  switch (fNumber)
+  {
+  case 20:
+    for (int j = 0; j < mDimension; j++)
+    {
+      TInterval x(lower[j], upper[j]);
+      sum = sum + (Sqr(x) - 10. * Cos(2.0 * M_PI * x) + 10.0);
+    }
+    return sum;
+  case 0:
+  case 1:
+  {
+    for (int j = 0; j < mDimension; j++)
+      sum = sum + Sqr(TInterval(lower[j], upper[j]));
+    double p = pow(fNumber == 0 ? 1.25 : 1.2, mDimension);
+    return sum - TInterval::Outward(p, p, INTERVAL_LIBM_ULPS);
+  }
+  case 2:
+    for (int j = 0; j < mDimension; j++)
+      sum = sum + TInterval(lower[j], upper[j]);
+    return sum - 1.5;
+  case 3:
+    for (int j = 0; j < mDimension; j++)
+      sum = sum - TInterval(lower[j], upper[j]);
+    return sum - 1.5;
+  case 4:
+    for (int j = 0; j < mDimension; j++)
+      sum = sum + Abs(TInterval(lower[j], upper[j]));
+    return sum - 1.5;
+  case 5:
+    for (int j = 0; j < mDimension; j++)
+      sum = sum + (Exp(Abs(TInterval(lower[j], upper[j]))) - 1.0);
+    return sum - 1.1;
+  case 6:
+    for (int j = 0; j < mDimension; j++)
+      sum = sum + Sqr(Sin(TInterval(lower[j], upper[j])));
+    return sum - 1.1;
+  case 7:
+    for (int j = 0; j < mDimension; j++)
+      sum = sum + Pow(TInterval(lower[j], upper[j]), 4);
+    return sum - 1.01;
+  case 8:
+    for (int j = 0; j < mDimension; j++)
+    {
+      TInterval x(lower[j], upper[j]);
+      sum = sum + (Pow(x, 3) + Sqr(x));
+    }
+    return sum - 1.01;
+  case 9:
+    for (int j = 0; j < mDimension; j++)
+      sum = sum + Cos(TInterval(lower[j], upper[j]));
+    return (double)mDimension - sum - 1.1;
+  case 10:
+    for (int j = 0; j < mDimension; j++)
+    {
+      TInterval x(lower[j], upper[j]);
+      sum = sum + x * Sin(x);
+    }
+    return sum - 1.1;
+  case 11:
+    for (int j = 0; j < mDimension; j++)
+      sum = sum + Log(1.0 + Sqr(TInterval(lower[j], upper[j])));
+    return sum - 1.1;
+  case 12:
+    for (int j = 0; j < mDimension; j++)
+      sum = sum + Tanh(Sqr(TInterval(lower[j], upper[j])));
+    return sum - 1.1;
+  case 13:
+    for (int j = 0; j < mDimension; j++)
+      sum = sum + TInterval(lower[j], upper[j]);
+    return Sqr(sum) - 1.01;
+  case 14:
+    if (mDimension < 2) return -0.1; // Всегда выполняется для n=1
+
+    for (int j = 0; j < mDimension - 1; j++)
+      sum = sum + Sqr(TInterval(lower[j + 1], upper[j + 1]) - TInterval(lower[j], upper[j]));
+    return sum - 1.1;
+  case 15:
+    for (int j = 0; j < mDimension; j++)
+    {
+      TInterval x(lower[j], upper[j]);
+      sum = sum + Sqr(x) * (1.0 + Cos(x));
+    }
+    return sum - 1.1;
+  case 16:
+    for (int j = 0; j < mDimension; j++)
+      sum = sum + Pow(Abs(TInterval(lower[j], upper[j])), 1.5);
+    return sum - 1.1;
+  case 17:
+    // t / (1 + t) монотонно возрастает по t = x^2 >= 0
+    for (int j = 0; j < mDimension; j++)
+    {
+      TInterval t = Sqr(TInterval(lower[j], upper[j]));
+      sum = sum + TInterval::Outward(t.lower / (1.0 + t.lower), t.upper / (1.0 + t.upper), 2);
+    }
+    return sum - 1.1;
+  case 18:
+    for (int j = 0; j < mDimension; j++)
+      sum = sum + Sqr(Sinh(TInterval(lower[j], upper[j])));
+    return sum - 1.1;
+  case 19:
+  {
+    TInterval prod = 1.0;
+    for (int j = 0; j < mDimension; j++)
+      prod = prod * (1.0 + Sqr(TInterval(lower[j], upper[j])));
+    return prod - 1.0 - 1.1;
+  }
+  }
+  return 0.0;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline double rastriginC20Problem::CalculateGradient(const double* x, int fNumber, double* gradient) const
+{
+  double sum = 0.;
+  switch (fNumber)
+  {
+  case 20:
+    for (int j = 0; j < mDimension; j++)
+    {
+      sum += x[j] * x[j] - 10. * cos(2.0 * M_PI * x[j]) + 10.0;
+      gradient[j] = 2.0 * x[j] + 20.0 * M_PI * sin(2.0 * M_PI * x[j]);
+    }
+    return sum;
+  case 0:
+  case 1:
+    for (int j = 0; j < mDimension; j++)
+    {
+      sum += x[j] * x[j];
+      gradient[j] = 2.0 * x[j];
+    }
+    return sum - pow(fNumber == 0 ? 1.25 : 1.2, mDimension);
+  case 2:
+    for (int j = 0; j < mDimension; j++)
+    {
+      sum += x[j];
+      gradient[j] = 1.0;
+    }
+    return sum - 1.5;
+  case 3:
+    for (int j = 0; j < mDimension; j++)
+    {
+      sum += -x[j];
+      gradient[j] = -1.0;
+    }
+    return sum - 1.5;
+  case 4:
+    // в нуле используется субградиент 0
+    for (int j = 0; j < mDimension; j++)
+    {
+      sum += fabs(x[j]);
+      gradient[j] = (x[j] > 0) - (x[j] < 0);
+    }
+    return sum - 1.5;
+  case 5:
+    for (int j = 0; j < mDimension; j++)
+    {
+      double e = exp(fabs(x[j]));
+      sum += e - 1.0;
+      gradient[j] = ((x[j] > 0) - (x[j] < 0)) * e;
+    }
+    return sum - 1.1;
+  case 6:
+    for (int j = 0; j < mDimension; j++)
+    {
+      sum += sin(x[j]) * sin(x[j]);
+      gradient[j] = sin(2.0 * x[j]);
+    }
+    return sum - 1.1;
+  case 7:
+    for (int j = 0; j < mDimension; j++)
+    {
+      sum += x[j] * x[j] * x[j] * x[j];
+      gradient[j] = 4.0 * x[j] * x[j] * x[j];
+    }
+    return sum - 1.01;
+  case 8:
+    for (int j = 0; j < mDimension; j++)
+    {
+      sum += x[j] * x[j] * x[j] + x[j] * x[j];
+      gradient[j] = 3.0 * x[j] * x[j] + 2.0 * x[j];
+    }
+    return sum - 1.01;
+  case 9:
+    for (int j = 0; j < mDimension; j++)
+    {
+      sum += cos(x[j]);
+      gradient[j] = sin(x[j]);
+    }
+    return mDimension - sum - 1.1;
+  case 10:
+    for (int j = 0; j < mDimension; j++)
+    {
+      double s = sin(x[j]);
+      sum += x[j] * s;
+      gradient[j] = s + x[j] * cos(x[j]);
+    }
+    return sum - 1.1;
+  case 11:
+    for (int j = 0; j < mDimension; j++)
+    {
+      sum += log(1.0 + x[j] * x[j]);
+      gradient[j] = 2.0 * x[j] / (1.0 + x[j] * x[j]);
+    }
+    return sum - 1.1;
+  case 12:
+    for (int j = 0; j < mDimension; j++)
+    {
+      double t = tanh(x[j] * x[j]);
+      sum += t;
+      gradient[j] = 2.0 * x[j] * (1.0 - t * t);
+    }
+    return sum - 1.1;
+  case 13:
+    for (int j = 0; j < mDimension; j++)
+      sum += x[j];
+    for (int j = 0; j < mDimension; j++)
+      gradient[j] = 2.0 * sum;
+    return sum * sum - 1.01;
+  case 14:
+    for (int j = 0; j < mDimension; j++)
+      gradient[j] = 0.0;
+    if (mDimension < 2) return -0.1; // Всегда выполняется для n=1
+
+    for (int j = 0; j < mDimension - 1; j++)
+    {
+      double diff = x[j + 1] - x[j];
+      sum += diff * diff;
+      gradient[j] -= 2.0 * diff;
+      gradient[j + 1] += 2.0 * diff;
+    }
+    return sum - 1.1;
+  case 15:
+    for (int j = 0; j < mDimension; j++)
+    {
+      double c = cos(x[j]);
+      sum += x[j] * x[j] * (1.0 + c);
+      gradient[j] = 2.0 * x[j] * (1.0 + c) - x[j] * x[j] * sin(x[j]);
+    }
+    return sum - 1.1;
+  case 16:
+    for (int j = 0; j < mDimension; j++)
+    {
+      sum += pow(fabs(x[j]), 1.5);
+      gradient[j] = 1.5 * ((x[j] > 0) - (x[j] < 0)) * sqrt(fabs(x[j]));
+    }
+    return sum - 1.1;
+  case 17:
+    for (int j = 0; j < mDimension; j++)
+    {
+      double d = 1.0 + x[j] * x[j];
+      sum += (x[j] * x[j]) / d;
+      gradient[j] = 2.0 * x[j] / (d * d);
+    }
+    return sum - 1.1;
+  case 18:
+    for (int j = 0; j < mDimension; j++)
+    {
+      double sh = sinh(x[j]);
+      sum += sh * sh;
+      gradient[j] = sinh(2.0 * x[j]);
+    }
+    return sum - 1.1;
+  case 19:
+  {
+    // 1 + x^2 >= 1, поэтому деление на сомножитель безопасно
+    double prod = 1.0;
+    for (int j = 0; j < mDimension; j++)
+      prod *= (1.0 + x[j] * x[j]);
+    for (int j = 0; j < mDimension; j++)
+      gradient[j] = prod / (1.0 + x[j] * x[j]) * 2.0 * x[j];
+    return prod - 1.0 - 1.1;
+  }
+  }
+  return 0.0;
 }
 
 inline int rastriginC20Problem::GetStartTrial(std::vector<double>& y, std::vector<std::string>& u, std::vector<double>& values)
@@ -301,26 +1085,32 @@ rastriginC20Problem::~rastriginC20Problem()
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API IGlobalOptimizationProblem* create()
+LIB_EXPORT_API IGlobalOptimizationProblem* PROBLEM_EXPORT_NAME(create)()
 {
   return new rastriginC20Problem();
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API void destroy(IGlobalOptimizationProblem* ptr)
+LIB_EXPORT_API void PROBLEM_EXPORT_NAME(destroy)(IGlobalOptimizationProblem* ptr)
 {
   delete ptr;
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API double Calculation1D(double x, int fType, int fNum)
+LIB_EXPORT_API int PROBLEM_EXPORT_NAME(getKernelTable)(void* problem, int version, TProblemKernelTable* table)
+{
+  return TProblemKernels<rastriginC20Problem>::Fill(problem, version, table);
+}
+
+// ------------------------------------------------------------------------------------------------
+LIB_EXPORT_API double PROBLEM_EXPORT_NAME(Calculation1D)(double x, int fType, int fNum)
 {
   std::cout << "Calculation\n" << std::endl;
   return x + fType + fNum;
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API double Calculation(double x, double y)
+LIB_EXPORT_API double PROBLEM_EXPORT_NAME(Calculation)(double x, double y)
 {
   double result = 0;
 
@@ -336,7 +1126,7 @@ LIB_EXPORT_API double Calculation(double x, double y)
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API double GetUpperBounds()
+LIB_EXPORT_API double PROBLEM_EXPORT_NAME(GetUpperBounds)()
 {
   double result = 0;
 
@@ -353,7 +1143,7 @@ LIB_EXPORT_API double GetUpperBounds()
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API double GetLowerBounds()
+LIB_EXPORT_API double PROBLEM_EXPORT_NAME(GetLowerBounds)()
 {
   double result = 0;
 
@@ -367,4 +1157,7 @@ LIB_EXPORT_API double GetLowerBounds()
   result = Lower[0];
   return result;
 }
+
+// ------------------------------------------------------------------------------------------------
+REGISTER_STATIC_PROBLEM(PROBLEM_EXPORT_NAME(getKernelTable))
 // - end of file ----------------------------------------------------------------------------------
@@ -6,6 +6,8 @@
 #endif
 
 #include "IGlobalOptimizationProblem.h"
+#include "ProblemKernelTable.h"
+#include "Interval.h"
 
 /// Задача Растригина
 class rastriginC20Problem : public IGlobalOptimizationProblem
@@ -19,6 +21,50 @@ protected:
   /// Максималбная допустимая размерность
   static const int mMaxDimension = 100;
 
+  /// Вычисляет значение функции с номером fNumber в точке x без виртуальных вызовов
+  double CalculateFunction(const double* x, int fNumber) const;
+  /// Вычисляет значение функции с номером fNumber в точке x в одинарной точности
+  float CalculateFunctionFloat(const float* x, int fNumber) const;
+  /// Вычисляет значение функции с номером fNumber и записывает ее градиент в gradient
+  double CalculateGradient(const double* x, int fNumber, double* gradient) const;
+  /// Вычисляет интервальную оценку функции с номером fNumber на параллелепипеде [lower, upper]
+  TInterval CalculateFunctionBounds(const double* lower, const double* upper, int fNumber) const;
+
+  /** Вычисляет слагаемое суммы функции с номером fNumber, зависящее от координаты x
+
+  Функция 14 зависит от пар соседних координат (см. #NeighbourTerm), функция 19 --
+  произведение по координатам, для нее возвращается сомножитель
+  */
+  double CoordinateTerm(double x, int fNumber) const;
+  /// Вычисляет слагаемые функции 14, содержащие координату j
+  double NeighbourTerm(const double* x, int j) const;
+  /// Вычисляет значение функции с номером fNumber по ее сумме (для функции 19 -- произведению) по координатам
+  double FunctionFromSum(double sum, int fNumber) const;
+  /// Заново вычисляет суммы и значения функций по точке из state
+  void SumIncrementalState(TIncrementalState& state) const;
+
+  /// Суммы по координатам, общие для нескольких ограничений
+  struct TSharedSums
+  {
+    /// Сумма x[j]
+    double sum;
+    /// Сумма x[j]^2
+    double sumSquares;
+    /// Сумма |x[j]|
+    double sumAbs;
+    /// Сумма x[j]^4
+    double sumFourth;
+    /// Сумма x[j]^3 + x[j]^2
+    double sumCubesSquares;
+  };
+
+  /** Вычисляет общие суммы за один проход по координатам
+
+  Порядок суммирования тот же, что и в #CalculateFunction, поэтому значения ограничений
+  совпадают побитово
+  */
+  void CalculateSharedSums(const double* x, TSharedSums& sums) const;
+
 public:
 
   rastriginC20Problem();
@@ -63,6 +109,24 @@ public:
   */
   virtual int GetNumberOfCriterions() const;
 
+  /** Метод возвращает вычислительные свойства задачи
+  \param[out] capabilities свойства задачи
+  \return Код ошибки (#PROBLEM_OK)
+  */
+  virtual int GetCapabilities(TProblemCapabilities& capabilities) const;
+
+  /** Метод возвращает верхнюю оценку константы Липшица функции в области поиска
+  \param[in] fNumber Номер функции
+  \param[out] constant оценка константы Липшица
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_UNDEFINED)
+  */
+  virtual int GetLipschitzConstant(int fNumber, double& constant) const;
+
+  /** Метод создает независимую копию задачи
+  \return Указатель на копию
+  */
+  virtual IGlobalOptimizationProblem* Clone() const;
+
   /** Метод, вычисляющий функции задачи
 
   \param[in] y непрерывные координаты точки, в которой необходимо вычислить значение
@@ -73,6 +137,152 @@ public:
   */
   virtual double CalculateFunctionals(const std::vector<double>& x, std::vector<std::string>& u, int fNumber);
 
+  /** Метод, вычисляющий функции задачи без создания временных векторов
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки
+  \param[in] uCount число дискретных координат
+  \param[in] fNumber Номер вычисляемой функции
+  \return Значение функции с указанным номером
+  */
+  virtual double CalculateFunctionals(const double* y, int yCount, const std::string* u, int uCount, int fNumber);
+
+  /** Метод, вычисляющий все функции задачи в буфер вызывающей стороны
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки
+  \param[in] uCount число дискретных координат
+  \param[out] values массив из #GetNumberOfFunctions() элементов для значений функций
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int CalculateAllFunctionals(const double* y, int yCount, const std::string* u, int uCount, double* values);
+
+  /** Метод, последовательно вычисляющий функции 0..lastIndex до первого нарушенного ограничения
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки
+  \param[in] uCount число дискретных координат
+  \param[in] lastIndex номер последней функции, которую нужно вычислить
+  \param[out] values массив не менее чем из lastIndex + 1 элементов для значений функций
+  \return Номер последней вычисленной функции или #PROBLEM_ERROR
+  */
+  virtual int CalculateFunctionalsUpTo(const double* y, int yCount, const std::string* u, int uCount,
+    int lastIndex, double* values);
+
+  /** Метод, вычисляющий функцию задачи сразу в нескольких точках
+
+  \param[in] y массив непрерывных координат точек, координаты точки i начинаются с y[i * stride]
+  \param[in] numPoints количество точек
+  \param[in] stride расстояние между началами соседних точек, 0 -- плотная упаковка
+  \param[in] fNumber Номер вычисляемой функции
+  \param[out] values массив из numPoints элементов для значений функции
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int CalculateFunctionalsBatch(const double* y, int numPoints, int stride, int fNumber, double* values);
+
+  /** Метод, вычисляющий функцию задачи сразу в нескольких точках в одинарной точности
+
+  В одинарной точности вычисляются функция Растригина (fNumber = 20) и ограничения 0, 1, 2, 3;
+  остальные ограничения вычисляются в double с округлением результата.
+  Отклонение от #CalculateFunctionalsBatch в тех же точках области поиска, n -- размерность:
+  для функции Растригина не превышает 2.5e-5 * n + 1.5e-6 * n^2,
+  для ограничений 0 и 1 -- 3e-7 * n^2 + 6e-8 * |f|, для ограничений 2 и 3 -- 1.3e-7 * n^2 + 1e-6,
+  для остальных ограничений -- 6e-8 * |f|. Оценки верны, пока |f| не превышает FLT_MAX (около 3.4e38);
+  большие значения в float непредставимы и возвращаются как бесконечность. В области поиска это возможно
+  только для ограничения 19 (произведение (1 + x_j^2) достигает 5.84^n) при n > 50
+  \param[in] y массив непрерывных координат точек, координаты точки i начинаются с y[i * stride]
+  \param[in] numPoints количество точек
+  \param[in] stride расстояние между началами соседних точек, 0 -- плотная упаковка
+  \param[in] fNumber Номер вычисляемой функции
+  \param[out] values массив из numPoints элементов для значений функции
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int CalculateFunctionalsBatchFloat(const float* y, int numPoints, int stride, int fNumber, float* values);
+
+  /** Метод, начинающий инкрементное вычисление функций задачи в точке y
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[out] state состояние точки
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int InitializeIncrementalState(const double* y, int yCount, TIncrementalState& state);
+
+  /** Метод, изменяющий одну координату точки и пересчитывающий значения функций за O(1)
+
+  Суммы обновляются на разность слагаемых изменяемой координаты, произведение функции 19 --
+  на отношение сомножителей. После #GetDimension() изменений они вычисляются заново,
+  поэтому ошибка округления не накапливается
+  \param[in,out] state состояние точки, созданное #InitializeIncrementalState
+  \param[in] coordinate номер изменяемой координаты
+  \param[in] value новое значение координаты
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int UpdateIncrementalState(TIncrementalState& state, int coordinate, double value);
+
+  /** Метод возвращает структуру зависимости функции от непрерывных переменных
+
+  Функции 13 (квадрат суммы) и 19 (произведение) неразделимы. Слагаемое j функции 14
+  зависит от координат j и j + 1, слагаемое j остальных функций -- от координаты j
+  \param[in] fNumber Номер функции
+  \param[out] structure структура функции
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int GetFunctionalStructure(int fNumber, TFunctionalStructure& structure) const;
+
+  /** Метод, вычисляющий отдельные слагаемые разделимой функции
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] fNumber Номер функции
+  \param[in] blocks номера вычисляемых слагаемых
+  \param[in] count число вычисляемых слагаемых
+  \param[out] elements массив из count элементов для значений слагаемых
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int CalculateFunctionalElements(const double* y, int yCount, int fNumber, const int* blocks, int count,
+    double* elements);
+
+  /** Метод, вычисляющий значение и градиент функции задачи за один проход
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] fNumber Номер вычисляемой функции
+  \param[out] value значение функции
+  \param[out] gradient массив из #GetDimension() элементов для градиента
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int CalculateFunctionalGradient(const double* y, int yCount, int fNumber, double& value, double* gradient);
+
+  /** Метод, вычисляющий значения и градиенты функции задачи сразу в нескольких точках
+
+  \param[in] y массив непрерывных координат точек, координаты точки i начинаются с y[i * stride]
+  \param[in] numPoints количество точек
+  \param[in] stride расстояние между началами соседних точек, 0 -- плотная упаковка
+  \param[in] fNumber Номер вычисляемой функции
+  \param[out] values массив из numPoints элементов для значений функции
+  \param[out] gradients массив из numPoints * #GetDimension() элементов для градиентов
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int CalculateFunctionalGradientBatch(const double* y, int numPoints, int stride, int fNumber,
+    double* values, double* gradients);
+
+  /** Метод, вычисляющий гарантированную оценку значений функции на параллелепипеде
+
+  \param[in] lower нижние границы параллелепипеда
+  \param[in] upper верхние границы параллелепипеда
+  \param[in] yCount число непрерывных координат
+  \param[in] fNumber Номер функции
+  \param[out] fLower нижняя оценка значений функции
+  \param[out] fUpper верхняя оценка значений функции
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int CalculateFunctionalBounds(const double* lower, const double* upper, int yCount, int fNumber,
+    double& fLower, double& fUpper);
+
   /** ћетод возвращает точку из допустимой области
   \param[out] y непрерывные координаты точки
   \param[out] u целочисленые координаты точки
@@ -84,11 +294,12 @@ public:
   ~rastriginC20Problem();
 };
 
-extern "C" LIB_EXPORT_API IGlobalOptimizationProblem* create();
-extern "C" LIB_EXPORT_API void destroy(IGlobalOptimizationProblem* ptr);
-extern "C" LIB_EXPORT_API double Calculation1D(double x, int fType, int fNum);
-extern "C" LIB_EXPORT_API double Calculation(double x, double y);
-extern "C" LIB_EXPORT_API double GetUpperBounds();
-extern "C" LIB_EXPORT_API double GetLowerBounds();
+extern "C" LIB_EXPORT_API IGlobalOptimizationProblem* PROBLEM_EXPORT_NAME(create)();
+extern "C" LIB_EXPORT_API void PROBLEM_EXPORT_NAME(destroy)(IGlobalOptimizationProblem* ptr);
+extern "C" LIB_EXPORT_API int PROBLEM_EXPORT_NAME(getKernelTable)(void* problem, int version, TProblemKernelTable* table);
+extern "C" LIB_EXPORT_API double PROBLEM_EXPORT_NAME(Calculation1D)(double x, int fType, int fNum);
+extern "C" LIB_EXPORT_API double PROBLEM_EXPORT_NAME(Calculation)(double x, double y);
+extern "C" LIB_EXPORT_API double PROBLEM_EXPORT_NAME(GetUpperBounds)();
+extern "C" LIB_EXPORT_API double PROBLEM_EXPORT_NAME(GetLowerBounds)();
 #endif
 // - end of file ----------------------------------------------------------------------------------
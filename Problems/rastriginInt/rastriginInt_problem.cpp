@@ -1,4 +1,5 @@
 ﻿#include "rastriginInt_problem.h"
+#include "StaticProblemRegistry.h"
 
 #define _USE_MATH_DEFINES
 #include <math.h>
@@ -54,35 +55,95 @@ int RastriginIntProblem::GetOptimumPoint(std::vector<double>& point, std::vector
 
   u.resize(ndv);
 
-  std::vector< std::vector<std::string>> values;
-  GetDiscreteVariableValues(values);
-
   for (int i = 0; i < ndv; i++)
-    u[i] = values[i][values[i].size() - 1];
+    u[i] = mDiscreteVariableValues[i][mDiscreteVariableValues[i].size() - 1];
   return IGlobalOptimizationProblem::PROBLEM_OK;
 }
 
 // ------------------------------------------------------------------------------------------------
-double RastriginIntProblem::CalculateFunctionals(const std::vector<double>& x, std::vector<std::string>& u, int fNumber)
+template <class TDiscreteIndex>
+inline double RastriginIntProblem::CalculateFunction(const double* x, TDiscreteIndex discreteIndex) const
 {
   double sum = 0.;
-  int j = 0;
-  int i = 0;
-  std::vector<double> y(mDimension);
-  for (; i < countContinuousVariables; i++)
-    y[i] = x[i];
-  for (; i < mDimension; i++)
-    y[i] = discreteValues[u[i - countContinuousVariables][0] - 'A'];
-  for (; j < (mDimension - GetNumberOfDiscreteVariable()); j++)
-    sum += y[j] * y[j] - 10. * cos(2.0 * M_PI * y[j]) + 10.0;
-  for (; j < mDimension; j++)
+  double mult = 0.;
+  for (int j = 0; j < mDimension; j++)
   {
-    sum = sum - y[j];
+    double y;
+    if (j < countContinuousVariables)
+    {
+      y = x[j];
+      sum += y * y - 10. * cos(2.0 * M_PI * y) + 10.0;
+    }
+    else
+    {
+      y = discreteValues[discreteIndex(j - countContinuousVariables)];
+      sum = sum - y;
+    }
+
+    // то же, что и MultFunc, но без промежуточного вектора
+    double a = (y - optPoint[j]) / ((B[j] - A[j]) / 2);
+    mult = mult + a * a;
   }
 
-  sum = sum * (MultFunc(y) + multKoef);
+  if (IsMultInt == true)
+    mult = -mult;
+  else
+    mult = 1.0;
+
+  return sum * (mult + multKoef);
+}
+
+// ------------------------------------------------------------------------------------------------
+double RastriginIntProblem::CalculateFunctionals(const std::vector<double>& x, std::vector<std::string>& u, int fNumber)
+{
+  return CalculateFunctionals(x.data(), (int)x.size(), u.data(), (int)u.size(), fNumber);
+}
+
+// ------------------------------------------------------------------------------------------------
+double RastriginIntProblem::CalculateFunctionals(const double* y, int yCount, const std::string* u, int uCount, int fNumber)
+{
+  // значения дискретных параметров -- однобуквенные метки 'A', 'B', ...
+  return CalculateFunction(y, [u](int k) { return u[k][0] - 'A'; });
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginIntProblem::CalculateAllFunctionals(const double* y, int yCount, const std::string* u, int uCount, double* values)
+{
+  if (yCount < countContinuousVariables || uCount < GetNumberOfDiscreteVariable())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  values[0] = CalculateFunctionals(y, yCount, u, uCount, 0);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool RastriginIntProblem::CheckDiscreteIndices(int yCount, const int* u, int uCount) const
+{
+  if (yCount < countContinuousVariables || uCount < GetNumberOfDiscreteVariable())
+    return false;
+
+  for (int i = 0; i < uCount; i++)
+    if (u[i] < 0 || u[i] >= (int)discreteValues.size())
+      return false;
+  return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+double RastriginIntProblem::CalculateFunctionalsByIndex(const double* y, int yCount, const int* u, int uCount, int fNumber)
+{
+  if (!CheckDiscreteIndices(yCount, u, uCount))
+    throw std::out_of_range("Discrete value index is out of range");
+  return CalculateFunction(y, [u](int k) { return u[k]; });
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginIntProblem::CalculateAllFunctionalsByIndex(const double* y, int yCount, const int* u, int uCount, double* values)
+{
+  if (!CheckDiscreteIndices(yCount, u, uCount))
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
 
-  return sum;
+  values[0] = CalculateFunction(y, [u](int k) { return u[k]; });
+  return IGlobalOptimizationProblem::PROBLEM_OK;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -138,6 +199,25 @@ int RastriginIntProblem::GetNumberOfCriterions() const
   return mNumberOfCriterions;
 }
 
+// ------------------------------------------------------------------------------------------------
+int RastriginIntProblem::GetCapabilities(TProblemCapabilities& capabilities) const
+{
+  capabilities = TProblemCapabilities();
+  capabilities.threadSafety = TProblemCapabilities::THREAD_REENTRANT;
+  capabilities.hasNativeBatch = false;
+  capabilities.isDeterministic = true;
+  // один косинус на непрерывную координату
+  capabilities.functionCost = 2e-8 * mDimension;
+  capabilities.preferredBatchSize = 256;
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+IGlobalOptimizationProblem* RastriginIntProblem::Clone() const
+{
+  return new RastriginIntProblem(*this);
+}
+
 // ------------------------------------------------------------------------------------------------
 RastriginIntProblem::~RastriginIntProblem()
 {
@@ -189,6 +269,14 @@ int RastriginIntProblem::Initialize()
     mNumberOfValues[i] = mDefNumberOfValues;
   }
 
+  mDiscreteVariableValues.resize(GetNumberOfDiscreteVariable());
+  for (int i = 0; i < GetNumberOfDiscreteVariable(); i++)
+  {
+    mDiscreteVariableValues[i].resize(mNumberOfValues[i]);
+    for (int j = 0; j < mNumberOfValues[i]; j++)
+      mDiscreteVariableValues[i][j] = std::string(1, 'A' + j);
+  }
+
   this->GetOptimumPoint(optPoint, u);
 
   for (auto ui : u)
@@ -241,15 +329,38 @@ int RastriginIntProblem::SetNumberOfDiscreteVariable(int numberOfDiscreteVariabl
 // ------------------------------------------------------------------------------------------------
 inline int RastriginIntProblem::GetDiscreteVariableValues(std::vector< std::vector<std::string>>& values) const
 {
-  values.resize(GetNumberOfDiscreteVariable());
+  values = mDiscreteVariableValues;
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
 
-  for (int i = 0; i < GetNumberOfDiscreteVariable(); i++)
+// ------------------------------------------------------------------------------------------------
+int RastriginIntProblem::GetDiscreteValueIndices(const std::string* u, int count, int* indices) const
+{
+  if (count > (int)mDiscreteVariableValues.size())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  for (int i = 0; i < count; i++)
   {
-    values[i].resize(mNumberOfValues[i]);
-    for (int j = 0; j < mNumberOfValues[i]; j++)
-    {
-      values[i][j] = std::string(1, 'A' + j);
-    }
+    int index = (u[i].size() == 1) ? u[i][0] - 'A' : -1;
+    if (index < 0 || index >= (int)mDiscreteVariableValues[i].size())
+      return IGlobalOptimizationProblem::PROBLEM_ERROR;
+    indices[i] = index;
+  }
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginIntProblem::GetDiscreteValueLabels(const int* indices, int count, std::vector<std::string>& u) const
+{
+  if (count > (int)mDiscreteVariableValues.size())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  u.resize(count);
+  for (int i = 0; i < count; i++)
+  {
+    if (indices[i] < 0 || indices[i] >= (int)mDiscreteVariableValues[i].size())
+      return IGlobalOptimizationProblem::PROBLEM_ERROR;
+    u[i] = mDiscreteVariableValues[i][indices[i]];
   }
   return IGlobalOptimizationProblem::PROBLEM_OK;
 }
@@ -257,14 +368,17 @@ inline int RastriginIntProblem::GetDiscreteVariableValues(std::vector< std::vect
 
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API IGlobalOptimizationProblem* create()
+LIB_EXPORT_API IGlobalOptimizationProblem* PROBLEM_EXPORT_NAME(create)()
 {
   return new RastriginIntProblem();
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API void destroy(IGlobalOptimizationProblem* ptr)
+LIB_EXPORT_API void PROBLEM_EXPORT_NAME(destroy)(IGlobalOptimizationProblem* ptr)
 {
   delete ptr;
 }
+
+// ------------------------------------------------------------------------------------------------
+REGISTER_STATIC_PROBLEM(NULL)
 // - end of file ----------------------------------------------------------------------------------
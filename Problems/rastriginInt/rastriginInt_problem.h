@@ -47,6 +47,18 @@ protected:
   bool IsMultInt;
   /// Число значений дискретных параметров по каждой размерности
   std::vector<int> mNumberOfValues;
+  /// Таблица строковых значений дискретных параметров, строится в #Initialize
+  std::vector< std::vector<std::string>> mDiscreteVariableValues;
+
+  /** Вычисляет значение целевой функции в точке (x, u) без создания временных векторов
+  \param[in] x непрерывные координаты точки
+  \param[in] discreteIndex функтор, возвращающий номер значения k-го дискретного параметра
+  */
+  template <class TDiscreteIndex>
+  double CalculateFunction(const double* x, TDiscreteIndex discreteIndex) const;
+
+  /// Проверяет, что координат достаточно, а номера значений дискретных параметров есть в таблице
+  bool CheckDiscreteIndices(int yCount, const int* u, int uCount) const;
 
   /// Очищает номер текущего значения для дискретного параметра
   virtual void ClearCurrentDiscreteValueIndex(int** mCurrentDiscreteValueIndex)
@@ -85,6 +97,51 @@ public:
   */
   virtual double CalculateFunctionals(const std::vector<double>& x, std::vector<std::string>& u, int fNumber);
 
+  /** Метод, вычисляющий функции задачи без создания временных векторов
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки
+  \param[in] uCount число дискретных координат
+  \param[in] fNumber Номер вычисляемой функции
+  \return Значение функции с указанным номером
+  */
+  virtual double CalculateFunctionals(const double* y, int yCount, const std::string* u, int uCount, int fNumber);
+
+  /** Метод, вычисляющий все функции задачи в буфер вызывающей стороны
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки
+  \param[in] uCount число дискретных координат
+  \param[out] values массив из #GetNumberOfFunctions() элементов для значений функций
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int CalculateAllFunctionals(const double* y, int yCount, const std::string* u, int uCount, double* values);
+
+  /** Метод, вычисляющий функции задачи, дискретные параметры которой заданы номерами значений
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u номера значений дискретных параметров
+  \param[in] uCount число дискретных координат
+  \param[in] fNumber Номер вычисляемой функции
+  \return Значение функции с указанным номером
+  \throw std::out_of_range если номер значения вне таблицы или координат меньше, чем переменных задачи
+  */
+  virtual double CalculateFunctionalsByIndex(const double* y, int yCount, const int* u, int uCount, int fNumber);
+
+  /** Метод, вычисляющий все функции задачи, дискретные параметры которой заданы номерами значений
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u номера значений дискретных параметров
+  \param[in] uCount число дискретных координат
+  \param[out] values массив из #GetNumberOfFunctions() элементов для значений функций
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int CalculateAllFunctionalsByIndex(const double* y, int yCount, const int* u, int uCount, double* values);
+
   /** Метод задаёт размерность задачи
 
   Данный метод должен вызываться перед #Initialize. Размерность должна быть в
@@ -113,6 +170,17 @@ public:
   */
   virtual int GetNumberOfCriterions() const;
 
+  /** Метод возвращает вычислительные свойства задачи
+  \param[out] capabilities свойства задачи
+  \return Код ошибки (#PROBLEM_OK)
+  */
+  virtual int GetCapabilities(TProblemCapabilities& capabilities) const;
+
+  /** Метод создает независимую копию задачи
+  \return Указатель на копию
+  */
+  virtual IGlobalOptimizationProblem* Clone() const;
+
   ~RastriginIntProblem();
 
 
@@ -142,10 +210,16 @@ public:
   */
   virtual int GetDiscreteVariableValues(std::vector< std::vector<std::string>>& values) const;
 
+  /// Преобразует строковые значения дискретных параметров в их номера
+  virtual int GetDiscreteValueIndices(const std::string* u, int count, int* indices) const;
+
+  /// Преобразует номера значений дискретных параметров в строковые значения
+  virtual int GetDiscreteValueLabels(const int* indices, int count, std::vector<std::string>& u) const;
+
 };
 
-extern "C" LIB_EXPORT_API IGlobalOptimizationProblem* create();
-extern "C" LIB_EXPORT_API void destroy(IGlobalOptimizationProblem* ptr);
+extern "C" LIB_EXPORT_API IGlobalOptimizationProblem* PROBLEM_EXPORT_NAME(create)();
+extern "C" LIB_EXPORT_API void PROBLEM_EXPORT_NAME(destroy)(IGlobalOptimizationProblem* ptr);
 
 #endif
 // - end of file ----------------------------------------------------------------------------------
@@ -1,15 +1,26 @@
 ﻿#include "rastriginUC_problem.h"
+#include "StaticProblemRegistry.h"
 #include "Common.h"
 
 #define _USE_MATH_DEFINES
 #include <math.h>
+#include <atomic>
 #include <iostream>
 
+// ------------------------------------------------------------------------------------------------
+/// Возвращает начальное значение генератора, различное для всех экземпляров задачи
+static unsigned int NextGeneratorSeed()
+{
+  static std::atomic<unsigned int> seed(1);
+  return seed++;
+}
+
 // ------------------------------------------------------------------------------------------------
 RastriginUCProblem::RastriginUCProblem()
 {
   mIsInitialized = false;
   mDimension = 50;
+  mGenerator.seed(NextGeneratorSeed());
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -100,26 +111,55 @@ int RastriginUCProblem::GetNumberOfCriterions() const
 }
 
 // ------------------------------------------------------------------------------------------------
-double RastriginUCProblem::CalculateFunctionals(const std::vector<double>& x, std::vector<std::string>& u, int fNumber)
+int RastriginUCProblem::GetCapabilities(TProblemCapabilities& capabilities) const
 {
-  double sum = 0.;
-  bool is_uncalc = false;
+  capabilities = TProblemCapabilities();
+  // в невычислимых точках результат определяется генератором задачи, у каждой копии (#Clone) он свой
+  capabilities.threadSafety = TProblemCapabilities::THREAD_UNSAFE;
+  capabilities.hasNativeBatch = false;
+  capabilities.isDeterministic = false;
+  capabilities.functionCost = 2e-8 * mDimension;
+  capabilities.preferredBatchSize = 1;
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
 
-  // невычислимые точки
+// ------------------------------------------------------------------------------------------------
+IGlobalOptimizationProblem* RastriginUCProblem::Clone() const
+{
+  RastriginUCProblem* clone = new RastriginUCProblem(*this);
+  // копия получает собственную последовательность случайных чисел
+  clone->mGenerator.seed(NextGeneratorSeed());
+  return clone;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline bool RastriginUCProblem::IsUncomputablePoint(const double* x) const
+{
   for (int i = 0; i < mDimension; i++) {
-      if (std::fabs(x[i] - 0.23) < 0.15 && std::fabs(x[i] - 0.23) < 0.15) {
-          is_uncalc = true;
-          break;
-      }
+      if (std::fabs(x[i] - 0.23) < 0.15 && std::fabs(x[i] - 0.23) < 0.15)
+          return true;
   }
+  return false;
+}
 
-  if (is_uncalc) {
-      if (rand() % 2)
-          sum = MaxDouble;
+// ------------------------------------------------------------------------------------------------
+inline double RastriginUCProblem::CalculateFunction(const double* x, int fNumber)
+{
+  // невычислимые точки
+  if (IsUncomputablePoint(x)) {
+      if (mGenerator() % 2)
+          return MaxDouble;
       else
           throw std::logic_error("Error of calculations");
   }
-  else if (fNumber == 0)
+  return CalculateComputableFunction(x, fNumber);
+}
+
+// ------------------------------------------------------------------------------------------------
+inline double RastriginUCProblem::CalculateComputableFunction(const double* x, int fNumber) const
+{
+  double sum = 0.;
+  if (fNumber == 0)
   {
     for (int j = 0; j < mDimension; j++)
       sum += x[j] * x[j];
@@ -134,6 +174,115 @@ double RastriginUCProblem::CalculateFunctionals(const std::vector<double>& x, st
   return sum;
 }
 
+// ------------------------------------------------------------------------------------------------
+double RastriginUCProblem::CalculateFunctionals(const std::vector<double>& x, std::vector<std::string>& u, int fNumber)
+{
+  return CalculateFunction(x.data(), fNumber);
+}
+
+// ------------------------------------------------------------------------------------------------
+double RastriginUCProblem::CalculateFunctionals(const double* y, int yCount, const std::string* u, int uCount, int fNumber)
+{
+  return CalculateFunction(y, fNumber);
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginUCProblem::CalculateAllFunctionals(const double* y, int yCount, const std::string* u, int uCount, double* values)
+{
+  if (yCount < mDimension)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  int numberOfFunctions = GetNumberOfFunctions();
+  for (int i = 0; i < numberOfFunctions; i++)
+    values[i] = CalculateFunction(y, i);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginUCProblem::CalculateFunctionalsUpTo(const double* y, int yCount, const std::string* u, int uCount,
+  int lastIndex, double* values)
+{
+  if (yCount < mDimension || lastIndex < 0 || lastIndex >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  // проверка на невычислимость выполняется один раз на точку; в невычислимой точке
+  // первое же ограничение либо нарушено (MaxDouble), либо бросает исключение
+  if (IsUncomputablePoint(y))
+  {
+    values[0] = CalculateFunction(y, 0);
+    return 0;
+  }
+
+  int numberOfConstraints = GetNumberOfConstraints();
+  for (int i = 0; i <= lastIndex; i++)
+  {
+    values[i] = CalculateComputableFunction(y, i);
+    if (i < numberOfConstraints && values[i] > 0)
+      return i;
+  }
+  return lastIndex;
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginUCProblem::TryCalculateFunctionals(const double* y, int yCount, const std::string* u, int uCount,
+  int fNumber, double& value)
+{
+  if (yCount < mDimension || fNumber < 0 || fNumber >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::FUNCTIONAL_ERROR;
+
+  if (IsUncomputablePoint(y))
+  {
+    value = MaxDouble;
+    return IGlobalOptimizationProblem::FUNCTIONAL_NOT_COMPUTABLE;
+  }
+  value = CalculateComputableFunction(y, fNumber);
+  return IGlobalOptimizationProblem::FUNCTIONAL_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginUCProblem::TryCalculateAllFunctionals(const double* y, int yCount, const std::string* u, int uCount,
+  double* values, int* statuses)
+{
+  if (yCount < mDimension)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  bool isUncomputable = IsUncomputablePoint(y);
+  int numberOfFunctions = GetNumberOfFunctions();
+  for (int i = 0; i < numberOfFunctions; i++)
+  {
+    values[i] = isUncomputable ? MaxDouble : CalculateComputableFunction(y, i);
+    statuses[i] = isUncomputable ? IGlobalOptimizationProblem::FUNCTIONAL_NOT_COMPUTABLE :
+      IGlobalOptimizationProblem::FUNCTIONAL_OK;
+  }
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int RastriginUCProblem::TryCalculateFunctionalsBatch(const double* y, int numPoints, int stride, int fNumber,
+  double* values, int* statuses)
+{
+  if (stride == 0)
+    stride = mDimension;
+  if (stride < mDimension || numPoints < 0 || fNumber < 0 || fNumber >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  for (int i = 0; i < numPoints; i++)
+  {
+    const double* x = y + (size_t)i * stride;
+    if (IsUncomputablePoint(x))
+    {
+      values[i] = MaxDouble;
+      statuses[i] = IGlobalOptimizationProblem::FUNCTIONAL_NOT_COMPUTABLE;
+    }
+    else
+    {
+      values[i] = CalculateComputableFunction(x, fNumber);
+      statuses[i] = IGlobalOptimizationProblem::FUNCTIONAL_OK;
+    }
+  }
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
 // ------------------------------------------------------------------------------------------------
 RastriginUCProblem::~RastriginUCProblem()
 {
@@ -153,28 +302,24 @@ inline int RastriginUCProblem::GetStartTrial(std::vector<double>& y, std::vector
 
   values.resize(GetNumberOfFunctions());
 
-  for (int j = 0; j < GetNumberOfFunctions(); j++) {
-      try {
-          values[j] = CalculateFunctionals(y, u, j);
-      }
-      catch (...) {
-          values[j] = MaxDouble;
-      }
-  }
+  std::vector<int> statuses(GetNumberOfFunctions());
+  TryCalculateAllFunctionals(y.data(), mDimension, nullptr, 0, values.data(), statuses.data());
 
   return IGlobalOptimizationProblem::PROBLEM_OK;
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API IGlobalOptimizationProblem* create()
+LIB_EXPORT_API IGlobalOptimizationProblem* PROBLEM_EXPORT_NAME(create)()
 {
   return new RastriginUCProblem();
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API void destroy(IGlobalOptimizationProblem* ptr)
+LIB_EXPORT_API void PROBLEM_EXPORT_NAME(destroy)(IGlobalOptimizationProblem* ptr)
 {
   delete ptr;
 }
 
+// ------------------------------------------------------------------------------------------------
+REGISTER_STATIC_PROBLEM(NULL)
 // - end of file ----------------------------------------------------------------------------------
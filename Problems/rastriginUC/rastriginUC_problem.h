@@ -7,6 +7,8 @@
 
 #include "IGlobalOptimizationProblem.h"
 
+#include <random>
+
 /// Задача Растригина
 class RastriginUCProblem : public IGlobalOptimizationProblem
 {
@@ -18,6 +20,15 @@ protected:
   bool mIsInitialized;
   /// Максимальная допустимая размерность
   static const int mMaxDimension = 50;
+  /// Генератор, выбирающий результат вычисления в невычислимых точках
+  std::minstd_rand mGenerator;
+
+  /// Вычисляет значение функции с номером fNumber в точке x без виртуальных вызовов
+  double CalculateFunction(const double* x, int fNumber);
+  /// Проверяет, попадает ли точка x в область, где функции невычислимы
+  bool IsUncomputablePoint(const double* x) const;
+  /// Вычисляет значение функции с номером fNumber в точке x из области, где она вычислима
+  double CalculateComputableFunction(const double* x, int fNumber) const;
 
 public:
 
@@ -63,6 +74,17 @@ public:
   */
   virtual int GetNumberOfCriterions() const;
 
+  /** Метод возвращает вычислительные свойства задачи
+  \param[out] capabilities свойства задачи
+  \return Код ошибки (#PROBLEM_OK)
+  */
+  virtual int GetCapabilities(TProblemCapabilities& capabilities) const;
+
+  /** Метод создает независимую копию задачи
+  \return Указатель на копию
+  */
+  virtual IGlobalOptimizationProblem* Clone() const;
+
   /** Метод, вычисляющий функции задачи
 
   \param[in] y непрерывные координаты точки, в которой необходимо вычислить значение
@@ -73,6 +95,83 @@ public:
   */
   virtual double CalculateFunctionals(const std::vector<double>& x, std::vector<std::string>& u, int fNumber);
 
+  /** Метод, вычисляющий функции задачи без создания временных векторов
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки
+  \param[in] uCount число дискретных координат
+  \param[in] fNumber Номер вычисляемой функции
+  \return Значение функции с указанным номером
+  */
+  virtual double CalculateFunctionals(const double* y, int yCount, const std::string* u, int uCount, int fNumber);
+
+  /** Метод, вычисляющий все функции задачи в буфер вызывающей стороны
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки
+  \param[in] uCount число дискретных координат
+  \param[out] values массив из #GetNumberOfFunctions() элементов для значений функций
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int CalculateAllFunctionals(const double* y, int yCount, const std::string* u, int uCount, double* values);
+
+  /** Метод, последовательно вычисляющий функции 0..lastIndex до первого нарушенного ограничения
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки
+  \param[in] uCount число дискретных координат
+  \param[in] lastIndex номер последней функции, которую нужно вычислить
+  \param[out] values массив не менее чем из lastIndex + 1 элементов для значений функций
+  \return Номер последней вычисленной функции или #PROBLEM_ERROR
+  */
+  virtual int CalculateFunctionalsUpTo(const double* y, int yCount, const std::string* u, int uCount,
+    int lastIndex, double* values);
+
+  /** Метод, вычисляющий функцию задачи с возвратом статуса
+
+  В невычислимой точке возвращает #FUNCTIONAL_NOT_COMPUTABLE без исключения,
+  значение функции при этом равно MaxDouble
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки
+  \param[in] uCount число дискретных координат
+  \param[in] fNumber Номер вычисляемой функции
+  \param[out] value значение функции
+  \return Статус значения (#FUNCTIONAL_OK, #FUNCTIONAL_NOT_COMPUTABLE или #FUNCTIONAL_ERROR)
+  */
+  virtual int TryCalculateFunctionals(const double* y, int yCount, const std::string* u, int uCount, int fNumber,
+    double& value);
+
+  /** Метод, вычисляющий все функции задачи со статусом для каждой функции
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки
+  \param[in] uCount число дискретных координат
+  \param[out] values массив из #GetNumberOfFunctions() элементов для значений функций
+  \param[out] statuses массив из #GetNumberOfFunctions() элементов для статусов значений
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int TryCalculateAllFunctionals(const double* y, int yCount, const std::string* u, int uCount,
+    double* values, int* statuses);
+
+  /** Метод, вычисляющий функцию задачи в нескольких точках со статусом для каждой точки
+
+  Невычислимые точки не прерывают пакет и не бросают исключений
+  \param[in] y массив непрерывных координат точек
+  \param[in] numPoints количество точек
+  \param[in] stride расстояние между началами соседних точек, 0 -- плотная упаковка
+  \param[in] fNumber Номер вычисляемой функции
+  \param[out] values массив из numPoints элементов для значений функции
+  \param[out] statuses массив из numPoints элементов для статусов значений
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int TryCalculateFunctionalsBatch(const double* y, int numPoints, int stride, int fNumber,
+    double* values, int* statuses);
+
   /** Метод возвращает точку из допустимой области
   \param[out] y непрерывные координаты точки
   \param[out] u целочисленые координаты точки
@@ -84,7 +183,7 @@ public:
   ~RastriginUCProblem();
 };
 
-extern "C" LIB_EXPORT_API IGlobalOptimizationProblem* create();
-extern "C" LIB_EXPORT_API void destroy(IGlobalOptimizationProblem* ptr);
+extern "C" LIB_EXPORT_API IGlobalOptimizationProblem* PROBLEM_EXPORT_NAME(create)();
+extern "C" LIB_EXPORT_API void PROBLEM_EXPORT_NAME(destroy)(IGlobalOptimizationProblem* ptr);
 #endif
 // - end of file ----------------------------------------------------------------------------------
@@ -1,4 +1,5 @@
 ﻿#include "stronginc3_problem.h"
+#include "StaticProblemRegistry.h"
 
 #define _USE_MATH_DEFINES
 #include <math.h>
@@ -95,7 +96,86 @@ int StronginC3::GetNumberOfCriterions() const
 }
 
 // ------------------------------------------------------------------------------------------------
-double StronginC3::CalculateFunctionals(const std::vector<double>& x, std::vector<std::string>& u, int fNumber)
+int StronginC3::GetCapabilities(TProblemCapabilities& capabilities) const
+{
+  capabilities = TProblemCapabilities();
+  capabilities.threadSafety = TProblemCapabilities::THREAD_REENTRANT;
+  capabilities.hasNativeBatch = true;
+  capabilities.isDeterministic = true;
+  // несколько трансцендентных функций на точку
+  capabilities.functionCost = 1e-7;
+  capabilities.preferredBatchSize = 256;
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int StronginC3::GetLipschitzConstant(int fNumber, double& constant) const
+{
+  if (!mIsInitialized || fNumber < 0 || fNumber >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_UNDEFINED;
+
+  // норма градиента оценивается интервальной арифметикой на сетке подобластей,
+  // что гораздо точнее оценки сразу на всей области
+  const int gridSize = 64;
+  double lower[2] = { 0., -1. };
+  double upper[2] = { 4., 3. };
+  double h1 = (upper[0] - lower[0]) / gridSize;
+  double h2 = (upper[1] - lower[1]) / gridSize;
+  constant = 0.;
+  for (int i = 0; i < gridSize; i++)
+    for (int j = 0; j < gridSize; j++)
+    {
+      TInterval x1(lower[0] + i * h1, i + 1 == gridSize ? upper[0] : lower[0] + (i + 1) * h1);
+      TInterval x2(lower[1] + j * h2, j + 1 == gridSize ? upper[1] : lower[1] + (j + 1) * h2);
+      TInterval d1, d2;
+      CalculateGradientBounds(x1, x2, fNumber, d1, d2);
+      double g1 = std::max(fabs(d1.lower), fabs(d1.upper));
+      double g2 = std::max(fabs(d2.lower), fabs(d2.upper));
+      constant = std::max(constant, sqrt(g1 * g1 + g2 * g2));
+    }
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+IGlobalOptimizationProblem* StronginC3::Clone() const
+{
+  return new StronginC3(*this);
+}
+
+// ------------------------------------------------------------------------------------------------
+void StronginC3::CalculateGradientBounds(const TInterval& x1, const TInterval& x2, int fNumber,
+  TInterval& d1, TInterval& d2) const
+{
+  switch (fNumber)
+  {
+  case 0:
+    d1 = 0.02 * (x1 - 2.2);
+    d2 = 0.02 * (x2 - 1.2);
+    break;
+  case 1:
+    d1 = -200.0 * (x1 - 2.0) / (1.2 * 1.2);
+    d2 = -50.0 * x2;
+    break;
+  case 2:
+    d1 = -15.0 * 6.283 * Cos(6.283 * (x1 - 1.75));
+    d2 = 10.0;
+    break;
+  case 3:
+  {
+    TInterval t1 = Pow(0.5 * x1 - 0.5, 4);
+    TInterval t2 = Pow(x2 - 1.0, 4);
+    TInterval e1 = Exp(1.0 - Sqr(x1) - 20.25 * Sqr(x1 - x2));
+    TInterval e2 = Exp(2.0 - t1 - t2);
+    d1 = 1.5 * e1 * (2.0 * x1 + Sqr(x1) * (-2.0 * x1 - 40.5 * (x1 - x2))) +
+      t2 * e2 * (1.0 - t1) * 2.0 * Pow(0.5 * x1 - 0.5, 3);
+    d2 = 1.5 * Sqr(x1) * e1 * 40.5 * (x1 - x2) + t1 * e2 * (1.0 - t2) * 4.0 * Pow(x2 - 1.0, 3);
+  }
+  break;
+  }
+}
+
+// ------------------------------------------------------------------------------------------------
+inline double StronginC3::CalculateFunction(const double* x, int fNumber) const
 {
   double res = 0.0;
   double x1 = x[0], x2 = x[1];
@@ -125,6 +205,177 @@ double StronginC3::CalculateFunctionals(const std::vector<double>& x, std::vecto
   return res;
 }
 
+// ------------------------------------------------------------------------------------------------
+double StronginC3::CalculateFunctionals(const std::vector<double>& x, std::vector<std::string>& u, int fNumber)
+{
+  return CalculateFunction(x.data(), fNumber);
+}
+
+// ------------------------------------------------------------------------------------------------
+double StronginC3::CalculateFunctionals(const double* y, int yCount, const std::string* u, int uCount, int fNumber)
+{
+  return CalculateFunction(y, fNumber);
+}
+
+// ------------------------------------------------------------------------------------------------
+int StronginC3::CalculateAllFunctionals(const double* y, int yCount, const std::string* u, int uCount, double* values)
+{
+  if (yCount < mDimension)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  int numberOfFunctions = GetNumberOfFunctions();
+  for (int i = 0; i < numberOfFunctions; i++)
+    values[i] = CalculateFunction(y, i);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int StronginC3::CalculateFunctionalsUpTo(const double* y, int yCount, const std::string* u, int uCount,
+  int lastIndex, double* values)
+{
+  if (yCount < mDimension || lastIndex < 0 || lastIndex >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  int numberOfConstraints = GetNumberOfConstraints();
+  for (int i = 0; i <= lastIndex; i++)
+  {
+    values[i] = CalculateFunction(y, i);
+    if (i < numberOfConstraints && values[i] > 0)
+      return i;
+  }
+  return lastIndex;
+}
+
+// ------------------------------------------------------------------------------------------------
+int StronginC3::CalculateFunctionalsBatch(const double* y, int numPoints, int stride, int fNumber, double* values)
+{
+  if (stride == 0)
+    stride = mDimension;
+  if (stride < mDimension || numPoints < 0)
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  for (int i = 0; i < numPoints; i++)
+    values[i] = CalculateFunction(y + (size_t)i * stride, fNumber);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int StronginC3::CalculateFunctionalGradient(const double* y, int yCount, int fNumber, double& value, double* gradient)
+{
+  if (yCount < mDimension || fNumber < 0 || fNumber >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  value = CalculateGradient(y, fNumber, gradient);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int StronginC3::CalculateFunctionalGradientBatch(const double* y, int numPoints, int stride, int fNumber,
+  double* values, double* gradients)
+{
+  if (stride == 0)
+    stride = mDimension;
+  if (stride < mDimension || numPoints < 0 || fNumber < 0 || fNumber >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  for (int i = 0; i < numPoints; i++)
+    values[i] = CalculateGradient(y + (size_t)i * stride, fNumber, gradients + (size_t)i * mDimension);
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+int StronginC3::CalculateFunctionalBounds(const double* lower, const double* upper, int yCount, int fNumber,
+  double& fLower, double& fUpper)
+{
+  if (yCount < mDimension || fNumber < 0 || fNumber >= GetNumberOfFunctions())
+    return IGlobalOptimizationProblem::PROBLEM_ERROR;
+  for (int j = 0; j < mDimension; j++)
+    if (!(lower[j] <= upper[j]))
+      return IGlobalOptimizationProblem::PROBLEM_ERROR;
+
+  TInterval bounds = CalculateFunctionBounds(lower, upper, fNumber);
+  fLower = bounds.lower;
+  fUpper = bounds.upper;
+  return IGlobalOptimizationProblem::PROBLEM_OK;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline TInterval StronginC3::CalculateFunctionBounds(const double* lower, const double* upper, int fNumber) const
+{
+  TInterval res = 0.0;
+  TInterval x1(lower[0], upper[0]), x2(lower[1], upper[1]);
+  switch (fNumber)
+  {
+  case 0: // constraint 1
+    res = 0.01 * (Sqr(x1 - 2.2) + Sqr(x2 - 1.2) - 2.25);
+    break;
+  case 1: // constraint 2
+    res = 100.0 * (1.0 - Sqr((x1 - 2.0) / 1.2) - Sqr(x2 / 2.0));
+    break;
+  case 2: // constraint 3
+    res = 10.0 * (x2 - 1.5 - 1.5 * Sin(6.283 * (x1 - 1.75)));
+    break;
+  case 3: // criterion
+  {
+    TInterval t1 = Pow(0.5 * x1 - 0.5, 4);
+    TInterval t2 = Pow(x2 - 1.0, 4);
+    res = 1.5 * Sqr(x1) * Exp(1.0 - Sqr(x1) - 20.25 * Sqr(x1 - x2));
+    res = res + t1 * t2 * Exp(2.0 - t1 - t2);
+    res = -res;
+  }
+  break;
+  }
+
+  return res;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline double StronginC3::CalculateGradient(const double* x, int fNumber, double* gradient) const
+{
+  double res = 0.0;
+  double x1 = x[0], x2 = x[1];
+  switch (fNumber)
+  {
+  case 0: // constraint 1
+    res = 0.01 * ((x1 - 2.2) * (x1 - 2.2) + (x2 - 1.2) * (x2 - 1.2) - 2.25);
+    gradient[0] = 0.02 * (x1 - 2.2);
+    gradient[1] = 0.02 * (x2 - 1.2);
+    break;
+  case 1: // constraint 2
+    res = 100.0 * (1.0 - ((x1 - 2.0) / 1.2) * ((x1 - 2.0) / 1.2) -
+      (x2 / 2.0) * (x2 / 2.0));
+    gradient[0] = -200.0 * (x1 - 2.0) / (1.2 * 1.2);
+    gradient[1] = -50.0 * x2;
+    break;
+  case 2: // constraint 3
+    res = 10.0 * (x2 - 1.5 - 1.5 * sin(6.283 * (x1 - 1.75)));
+    gradient[0] = -15.0 * 6.283 * cos(6.283 * (x1 - 1.75));
+    gradient[1] = 10.0;
+    break;
+  case 3: // criterion
+  {
+    double t1 = pow(0.5 * x1 - 0.5, 4.0);
+    double t2 = pow(x2 - 1.0, 4.0);
+    double e1 = exp(1.0 - x1 * x1 - 20.25 * (x1 - x2) * (x1 - x2));
+    double e2 = exp(2.0 - t1 - t2);
+    res = 1.5 * x1 * x1 * e1;
+    res = res + t1 * t2 * e2;
+    res = -res;
+
+    // производные показателя первой экспоненты и слагаемых t1, t2
+    double dE1 = -2.0 * x1 - 40.5 * (x1 - x2);
+    double dE2 = 40.5 * (x1 - x2);
+    double dt1 = 2.0 * pow(0.5 * x1 - 0.5, 3.0);
+    double dt2 = 4.0 * pow(x2 - 1.0, 3.0);
+    gradient[0] = -(1.5 * e1 * (2.0 * x1 + x1 * x1 * dE1) + t2 * e2 * (1.0 - t1) * dt1);
+    gradient[1] = -(1.5 * x1 * x1 * e1 * dE2 + t1 * e2 * (1.0 - t2) * dt2);
+  }
+  break;
+  }
+
+  return res;
+}
+
 // ------------------------------------------------------------------------------------------------
 StronginC3::~StronginC3()
 {
@@ -132,26 +383,32 @@ StronginC3::~StronginC3()
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API IGlobalOptimizationProblem* create()
+LIB_EXPORT_API IGlobalOptimizationProblem* PROBLEM_EXPORT_NAME(create)()
 {
   return new StronginC3();
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API void destroy(IGlobalOptimizationProblem* ptr)
+LIB_EXPORT_API void PROBLEM_EXPORT_NAME(destroy)(IGlobalOptimizationProblem* ptr)
 {
   delete ptr;
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API double Calculation1D(double x, int fType, int fNum)
+LIB_EXPORT_API int PROBLEM_EXPORT_NAME(getKernelTable)(void* problem, int version, TProblemKernelTable* table)
+{
+  return TProblemKernels<StronginC3>::Fill(problem, version, table);
+}
+
+// ------------------------------------------------------------------------------------------------
+LIB_EXPORT_API double PROBLEM_EXPORT_NAME(Calculation1D)(double x, int fType, int fNum)
 {
   std::cout << "Calculation\n" << std::endl;
   return x + fType + fNum;
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API double Calculation(double x, double y)
+LIB_EXPORT_API double PROBLEM_EXPORT_NAME(Calculation)(double x, double y)
 {
   double result = 0;
 
@@ -166,7 +423,7 @@ LIB_EXPORT_API double Calculation(double x, double y)
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API double GetUpperBounds()
+LIB_EXPORT_API double PROBLEM_EXPORT_NAME(GetUpperBounds)()
 {
   double result = 0;
 
@@ -183,7 +440,7 @@ LIB_EXPORT_API double GetUpperBounds()
 }
 
 // ------------------------------------------------------------------------------------------------
-LIB_EXPORT_API double GetLowerBounds()
+LIB_EXPORT_API double PROBLEM_EXPORT_NAME(GetLowerBounds)()
 {
   double result = 0;
 
@@ -197,4 +454,7 @@ LIB_EXPORT_API double GetLowerBounds()
   result = Lower[0];
   return result;
 }
+
+// ------------------------------------------------------------------------------------------------
+REGISTER_STATIC_PROBLEM(PROBLEM_EXPORT_NAME(getKernelTable))
 // - end of file ----------------------------------------------------------------------------------
@@ -6,6 +6,8 @@
 #endif
 
 #include "IGlobalOptimizationProblem.h"
+#include "ProblemKernelTable.h"
+#include "Interval.h"
 
 /// Задача Стронгина с тримя ограничениями
 class StronginC3 : public IGlobalOptimizationProblem
@@ -19,6 +21,15 @@ protected:
   /// Максималбная допустимая размерность
   static const int mMaxDimension = 100;
 
+  /// Вычисляет значение функции с номером fNumber в точке x без виртуальных вызовов
+  double CalculateFunction(const double* x, int fNumber) const;
+  /// Вычисляет значение функции с номером fNumber и записывает ее градиент в gradient
+  double CalculateGradient(const double* x, int fNumber, double* gradient) const;
+  /// Вычисляет интервальную оценку функции с номером fNumber на параллелепипеде [lower, upper]
+  TInterval CalculateFunctionBounds(const double* lower, const double* upper, int fNumber) const;
+  /// Вычисляет интервальные оценки частных производных функции с номером fNumber на прямоугольнике x1 x x2
+  void CalculateGradientBounds(const TInterval& x1, const TInterval& x2, int fNumber, TInterval& d1, TInterval& d2) const;
+
 public:
 
   StronginC3();
@@ -60,6 +71,24 @@ public:
   \return Число критериев
   */
   virtual int GetNumberOfCriterions() const;
+
+  /** Метод возвращает вычислительные свойства задачи
+  \param[out] capabilities свойства задачи
+  \return Код ошибки (#PROBLEM_OK)
+  */
+  virtual int GetCapabilities(TProblemCapabilities& capabilities) const;
+
+  /** Метод возвращает верхнюю оценку константы Липшица функции в области поиска
+  \param[in] fNumber Номер функции
+  \param[out] constant оценка константы Липшица
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_UNDEFINED)
+  */
+  virtual int GetLipschitzConstant(int fNumber, double& constant) const;
+
+  /** Метод создает независимую копию задачи
+  \return Указатель на копию
+  */
+  virtual IGlobalOptimizationProblem* Clone() const;
   /** Метод, вычисляющий функции задачи
 
   \param[in] y непрерывные координаты точки, в которой необходимо вычислить значение
@@ -70,14 +99,98 @@ public:
   */
   virtual double CalculateFunctionals(const std::vector<double>& x, std::vector<std::string>& u, int fNumber);
 
+  /** Метод, вычисляющий функции задачи без создания временных векторов
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки
+  \param[in] uCount число дискретных координат
+  \param[in] fNumber Номер вычисляемой функции
+  \return Значение функции с указанным номером
+  */
+  virtual double CalculateFunctionals(const double* y, int yCount, const std::string* u, int uCount, int fNumber);
+
+  /** Метод, вычисляющий все функции задачи в буфер вызывающей стороны
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки
+  \param[in] uCount число дискретных координат
+  \param[out] values массив из #GetNumberOfFunctions() элементов для значений функций
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int CalculateAllFunctionals(const double* y, int yCount, const std::string* u, int uCount, double* values);
+
+  /** Метод, последовательно вычисляющий функции 0..lastIndex до первого нарушенного ограничения
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] u дискретные координаты точки
+  \param[in] uCount число дискретных координат
+  \param[in] lastIndex номер последней функции, которую нужно вычислить
+  \param[out] values массив не менее чем из lastIndex + 1 элементов для значений функций
+  \return Номер последней вычисленной функции или #PROBLEM_ERROR
+  */
+  virtual int CalculateFunctionalsUpTo(const double* y, int yCount, const std::string* u, int uCount,
+    int lastIndex, double* values);
+
+  /** Метод, вычисляющий функцию задачи сразу в нескольких точках
+
+  \param[in] y массив непрерывных координат точек, координаты точки i начинаются с y[i * stride]
+  \param[in] numPoints количество точек
+  \param[in] stride расстояние между началами соседних точек, 0 -- плотная упаковка
+  \param[in] fNumber Номер вычисляемой функции
+  \param[out] values массив из numPoints элементов для значений функции
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int CalculateFunctionalsBatch(const double* y, int numPoints, int stride, int fNumber, double* values);
+
+  /** Метод, вычисляющий значение и градиент функции задачи за один проход
+
+  \param[in] y непрерывные координаты точки
+  \param[in] yCount число непрерывных координат
+  \param[in] fNumber Номер вычисляемой функции
+  \param[out] value значение функции
+  \param[out] gradient массив из #GetDimension() элементов для градиента
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int CalculateFunctionalGradient(const double* y, int yCount, int fNumber, double& value, double* gradient);
+
+  /** Метод, вычисляющий значения и градиенты функции задачи сразу в нескольких точках
+
+  \param[in] y массив непрерывных координат точек, координаты точки i начинаются с y[i * stride]
+  \param[in] numPoints количество точек
+  \param[in] stride расстояние между началами соседних точек, 0 -- плотная упаковка
+  \param[in] fNumber Номер вычисляемой функции
+  \param[out] values массив из numPoints элементов для значений функции
+  \param[out] gradients массив из numPoints * #GetDimension() элементов для градиентов
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int CalculateFunctionalGradientBatch(const double* y, int numPoints, int stride, int fNumber,
+    double* values, double* gradients);
+
+  /** Метод, вычисляющий гарантированную оценку значений функции на параллелепипеде
+
+  \param[in] lower нижние границы параллелепипеда
+  \param[in] upper верхние границы параллелепипеда
+  \param[in] yCount число непрерывных координат
+  \param[in] fNumber Номер функции
+  \param[out] fLower нижняя оценка значений функции
+  \param[out] fUpper верхняя оценка значений функции
+  \return Код ошибки (#PROBLEM_OK или #PROBLEM_ERROR)
+  */
+  virtual int CalculateFunctionalBounds(const double* lower, const double* upper, int yCount, int fNumber,
+    double& fLower, double& fUpper);
+
   ~StronginC3();
 };
 
-extern "C" LIB_EXPORT_API IGlobalOptimizationProblem* create();
-extern "C" LIB_EXPORT_API void destroy(IGlobalOptimizationProblem* ptr);
-extern "C" LIB_EXPORT_API double Calculation1D(double x, int fType, int fNum);
-extern "C" LIB_EXPORT_API double Calculation(double x, double y);
-extern "C" LIB_EXPORT_API double GetUpperBounds();
-extern "C" LIB_EXPORT_API double GetLowerBounds();
+extern "C" LIB_EXPORT_API IGlobalOptimizationProblem* PROBLEM_EXPORT_NAME(create)();
+extern "C" LIB_EXPORT_API void PROBLEM_EXPORT_NAME(destroy)(IGlobalOptimizationProblem* ptr);
+extern "C" LIB_EXPORT_API int PROBLEM_EXPORT_NAME(getKernelTable)(void* problem, int version, TProblemKernelTable* table);
+extern "C" LIB_EXPORT_API double PROBLEM_EXPORT_NAME(Calculation1D)(double x, int fType, int fNum);
+extern "C" LIB_EXPORT_API double PROBLEM_EXPORT_NAME(Calculation)(double x, double y);
+extern "C" LIB_EXPORT_API double PROBLEM_EXPORT_NAME(GetUpperBounds)();
+extern "C" LIB_EXPORT_API double PROBLEM_EXPORT_NAME(GetLowerBounds)();
 #endif
 // - end of file ----------------------------------------------------------------------------------
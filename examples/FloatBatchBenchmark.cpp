@@ -0,0 +1,146 @@
+﻿/////////////////////////////////////////////////////////////////////////////
+//                                                                         //
+//             LOBACHEVSKY STATE UNIVERSITY OF NIZHNY NOVGOROD             //
+//                                                                         //
+//                       Copyright (c) 2025 by UNN.                        //
+//                          All Rights Reserved.                           //
+//                                                                         //
+//  File:      FloatBatchBenchmark.cpp                                     //
+//                                                                         //
+//  Purpose:   Throughput of single and double precision batch evaluation  //
+//                                                                         //
+//  Author(s): Lebedev I.G.                                                //
+//                                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "GlobalOptimizationProblemManager.h"
+
+/// Число точек в одном пакете
+static const int NUMBER_OF_POINTS = 1 << 14;
+/// Наименьшее время измерения одного режима в секундах
+static const double MIN_MEASURE_TIME = 0.2;
+
+// ------------------------------------------------------------------------------------------------
+/// Возвращает путь к библиотеке с задачей name в каталоге directory
+static std::string LibraryPath(const std::string& directory, const std::string& name)
+{
+#ifdef WIN32
+  return directory + "/" + name + ".dll";
+#else
+  return directory + "/lib" + name + ".so";
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+/// Повторяет вычисление пакета, пока не пройдет #MIN_MEASURE_TIME, и возвращает число точек в секунду
+template <class TEvaluate>
+static double MeasureThroughput(TEvaluate evaluate)
+{
+  long long points = 0;
+  auto start = std::chrono::steady_clock::now();
+  double elapsed = 0.0;
+  do
+  {
+    evaluate();
+    points += NUMBER_OF_POINTS;
+    elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  } while (elapsed < MIN_MEASURE_TIME);
+  return points / elapsed;
+}
+
+// ------------------------------------------------------------------------------------------------
+/// Измеряет пропускную способность и отклонение float от double для функции fNumber задачи в размерности dimension
+static void RunBenchmark(const std::string& directory, const std::string& name, int dimension, int fNumber)
+{
+  GlobalOptimizationProblemManager manager;
+  if (manager.LoadProblemLibrary(LibraryPath(directory, name)) != GlobalOptimizationProblemManager::OK_)
+    return;
+  IGlobalOptimizationProblem* problem = manager.GetProblem();
+  if (problem->SetDimension(dimension) != IGlobalOptimizationProblem::PROBLEM_OK ||
+    problem->Initialize() != IGlobalOptimizationProblem::PROBLEM_OK)
+  {
+    printf("%-14s %5d   dimension is not supported\n", name.c_str(), dimension);
+    return;
+  }
+  if (fNumber < 0)
+    fNumber = problem->GetNumberOfFunctions() - 1;
+
+  std::vector<double> lower(dimension);
+  std::vector<double> upper(dimension);
+  problem->GetBounds(lower, upper);
+
+  // точки задаются в float, чтобы оба режима вычисляли функцию в одних и тех же точках
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  std::vector<float> pointsFloat((size_t)NUMBER_OF_POINTS * dimension);
+  std::vector<double> points(pointsFloat.size());
+  for (size_t i = 0; i < pointsFloat.size(); i++)
+  {
+    int j = (int)(i % dimension);
+    pointsFloat[i] = (float)(lower[j] + (upper[j] - lower[j]) * uniform(generator));
+    points[i] = pointsFloat[i];
+  }
+  std::vector<double> values(NUMBER_OF_POINTS);
+  std::vector<float> valuesFloat(NUMBER_OF_POINTS);
+
+  double doubleThroughput = MeasureThroughput([&]()
+  {
+    problem->CalculateFunctionalsBatch(points.data(), NUMBER_OF_POINTS, dimension, fNumber, values.data());
+  });
+  double floatThroughput = MeasureThroughput([&]()
+  {
+    problem->CalculateFunctionalsBatchFloat(pointsFloat.data(), NUMBER_OF_POINTS, dimension, fNumber,
+      valuesFloat.data());
+  });
+
+  double maxError = 0.0;
+  double maxRelativeError = 0.0;
+  for (int i = 0; i < NUMBER_OF_POINTS; i++)
+  {
+    double error = std::fabs((double)valuesFloat[i] - values[i]);
+    maxError = std::max(maxError, error);
+    if (values[i] != 0.0)
+      maxRelativeError = std::max(maxRelativeError, error / std::fabs(values[i]));
+  }
+
+  printf("%-14s %5d %3d %14.4g %14.4g %8.2f %12.3g %12.3g\n", name.c_str(), dimension, fNumber,
+    doubleThroughput, floatThroughput, floatThroughput / doubleThroughput, maxError, maxRelativeError);
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Сравнивает CalculateFunctionalsBatch и CalculateFunctionalsBatchFloat
+
+Первый аргумент -- каталог с библиотеками задач (по умолчанию текущий)
+*/
+int main(int argc, char* argv[])
+{
+  std::string directory = argc > 1 ? argv[1] : ".";
+  const int dimensions[] = { 2, 5, 10, 20, 50, 100 };
+
+  printf("%-14s %5s %3s %14s %14s %8s %12s %12s\n", "problem", "dim", "f", "double pt/s", "float pt/s",
+    "speedup", "max error", "rel error");
+  for (int dimension : dimensions)
+    RunBenchmark(directory, "rastrigin", dimension, -1);
+  RunBenchmark(directory, "rastriginC1", 50, 0);
+  RunBenchmark(directory, "rastriginC1", 50, 1);
+  for (int dimension : dimensions)
+  {
+    RunBenchmark(directory, "rastriginC20", dimension, 0);
+    RunBenchmark(directory, "rastriginC20", dimension, 2);
+    RunBenchmark(directory, "rastriginC20", dimension, 20);
+  }
+  return 0;
+}
+// - end of file ----------------------------------------------------------------------------------
@@ -58,6 +58,13 @@ int main(int argc, char* argv[])
     std::vector<double> y = { 0.5, 0.5 };
     std::vector <std::string> u;
     double value = problemX2->CalculateFunctionals(y, u, 0);
+
+    // все функции семейства вычисляются одним объектом без повторной загрузки
+    for (int i = 0; i < problemX2->GetNumberOfInstances(); i++)
+    {
+      problemX2->SelectInstance(i);
+      value = problemX2->CalculateFunctionals(y, u, 0);
+    }
   }
 
   IGlobalOptimizationProblem* problemRastrigin = 0;
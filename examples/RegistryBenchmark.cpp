@@ -0,0 +1,150 @@
+﻿/////////////////////////////////////////////////////////////////////////////
+//                                                                         //
+//             LOBACHEVSKY STATE UNIVERSITY OF NIZHNY NOVGOROD             //
+//                                                                         //
+//                       Copyright (c) 2025 by UNN.                        //
+//                          All Rights Reserved.                           //
+//                                                                         //
+//  File:      RegistryBenchmark.cpp                                       //
+//                                                                         //
+//  Purpose:   Throughput of concurrent problem lookup in the registry     //
+//                                                                         //
+//  Author(s): Lebedev I.G.                                                //
+//                                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ProblemRegistry.h"
+
+/// Число задач в реестре
+static const int NUMBER_OF_PROBLEMS = 64;
+/// Время измерения одного режима в секундах
+static const double MEASURE_TIME = 0.5;
+
+// ------------------------------------------------------------------------------------------------
+/// Возвращает путь к библиотеке с задачей name в каталоге directory
+static std::string LibraryPath(const std::string& directory, const std::string& name)
+{
+#ifdef WIN32
+  return directory + "/" + name + ".dll";
+#else
+  return directory + "/lib" + name + ".so";
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Вызывает find в numberOfThreads потоках в течение #MEASURE_TIME и возвращает число поисков в секунду
+
+Если задана функция write, отдельный поток вызывает ее все это время
+*/
+template <class TFind, class TWrite>
+static double MeasureThroughput(int numberOfThreads, TFind find, TWrite write)
+{
+  std::atomic<bool> isStopped(false);
+  std::atomic<long long> numberOfFinds(0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < numberOfThreads; t++)
+    threads.emplace_back([&, t]()
+    {
+      long long count = 0;
+      for (int i = t; !isStopped.load(std::memory_order_relaxed); i++, count++)
+        find(i % NUMBER_OF_PROBLEMS);
+      numberOfFinds += count;
+    });
+  std::thread writer([&]()
+  {
+    for (int i = 0; !isStopped.load(std::memory_order_relaxed); i++)
+      write(i);
+  });
+
+  auto start = std::chrono::steady_clock::now();
+  std::this_thread::sleep_for(std::chrono::duration<double>(MEASURE_TIME));
+  isStopped = true;
+  double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  for (auto& thread : threads)
+    thread.join();
+  writer.join();
+  return numberOfFinds.load() / elapsed;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Сравнивает TProblemRegistry::Find с поиском в таблице под общим мьютексом
+
+Поиск измеряется без изменений реестра и при одновременных Register и Remove в отдельном потоке.
+Первый аргумент -- каталог с библиотеками задач (по умолчанию текущий), второй -- наибольшее
+число потоков поиска (по умолчанию число ядер)
+*/
+int main(int argc, char* argv[])
+{
+  std::string directory = argc > 1 ? argv[1] : ".";
+  TProblemRegistry registry;
+  TProblemPtr problem = registry.GetManager().CreateProblem(LibraryPath(directory, "rastrigin"));
+  if (!problem)
+    return 1;
+
+  std::vector<std::string> names;
+  std::map<std::string, TProblemPtr> table;
+  for (int i = 0; i < NUMBER_OF_PROBLEMS; i++)
+  {
+    names.push_back("problem" + std::to_string(i));
+    registry.Register(names.back(), problem);
+    table[names.back()] = problem;
+  }
+  std::mutex tableMutex;
+
+  auto findRegistry = [&](int i)
+  {
+    if (!registry.Find(names[i]))
+      std::abort();
+  };
+  auto findTable = [&](int i)
+  {
+    TProblemPtr found;
+    {
+      std::lock_guard<std::mutex> lock(tableMutex);
+      found = table.find(names[i])->second;
+    }
+    if (!found)
+      std::abort();
+  };
+  auto noWrite = [](int i) { std::this_thread::yield(); };
+  auto writeRegistry = [&](int i)
+  {
+    registry.Register("extra", problem);
+    registry.Remove("extra");
+  };
+  auto writeTable = [&](int i)
+  {
+    std::lock_guard<std::mutex> lock(tableMutex);
+    table["extra"] = problem;
+    table.erase("extra");
+  };
+
+  unsigned int maxThreads = argc > 2 ? (unsigned int)atoi(argv[2]) : std::thread::hardware_concurrency();
+  maxThreads = std::max(1u, maxThreads);
+  printf("%7s %16s %16s %16s %16s\n", "threads", "registry f/s", "mutex f/s", "registry+w f/s",
+    "mutex+w f/s");
+  for (unsigned int numberOfThreads = 1; numberOfThreads <= maxThreads; numberOfThreads *= 2)
+  {
+    int n = (int)numberOfThreads;
+    printf("%7d %16.4g %16.4g %16.4g %16.4g\n", n,
+      MeasureThroughput(n, findRegistry, noWrite), MeasureThroughput(n, findTable, noWrite),
+      MeasureThroughput(n, findRegistry, writeRegistry), MeasureThroughput(n, findTable, writeTable));
+  }
+  return 0;
+}
+// - end of file ----------------------------------------------------------------------------------
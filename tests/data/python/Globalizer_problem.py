@@ -0,0 +1,52 @@
+from pruning_objective import PruningObjective
+
+
+def get_problem_parameters_names(name):
+    return []
+
+
+class GlobalizerProblem:
+    """Minimal adapter used by the tests of the Python problem wrapper"""
+
+    def __init__(self, target_problem: PruningObjective):
+        self.problem = target_problem
+        self.report = None
+
+    def set_pruning_callback(self, report):
+        self.report = report
+
+    def set_shared_data(self, name, buffer, dtype, shape):
+        self.problem.set_shared_data(name, buffer, dtype, shape)
+
+    def calculate(self, coordinate, discrete_coordinate, fNumber=0, fidelity=-1):
+        return self.problem.calculate(coordinate, self.report)
+
+    def calculate_all_functionals(self, coordinate, discrete_coordinate):
+        return [self.calculate(coordinate, discrete_coordinate)]
+
+    def get_dimension(self):
+        return 1
+
+    def get_number_of_functions(self):
+        return 1
+
+    def get_number_of_constraints(self):
+        return 0
+
+    def get_number_of_criterions(self):
+        return 1
+
+    def get_start_y(self):
+        return [0.5]
+
+    def get_start_value(self):
+        return [5.0]
+
+    def get_lower_bounds(self):
+        return [0.0]
+
+    def get_upper_bounds(self):
+        return [1.0]
+
+    def get_discrete_params(self):
+        return []
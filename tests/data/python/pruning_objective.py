@@ -0,0 +1,13 @@
+class PruningObjective:
+    """Sum of the first coordinate over ten steps, each partial sum is reported"""
+
+    def __init__(self):
+        self.steps = 10
+
+    def calculate(self, coordinate, report):
+        total = 0.0
+        for step in range(self.steps):
+            total += coordinate[0]
+            if report is not None and report(step, total):
+                break
+        return total
@@ -0,0 +1,14 @@
+class SharedObjective:
+    """Product of the first coordinate and the sum of the shared "coefficients" buffer"""
+
+    def __init__(self):
+        self.coefficients = None
+
+    def set_shared_data(self, name, buffer, dtype, shape):
+        if name != "coefficients" or dtype != "float64" or len(shape) != 1 or shape[0] < 2:
+            raise ValueError("coefficients must be at least two float64 values")
+        # the view reads the caller's buffer, nothing is copied
+        self.coefficients = buffer.cast("d")
+
+    def calculate(self, coordinate, report):
+        return coordinate[0] * sum(self.coefficients)
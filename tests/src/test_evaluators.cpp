@@ -0,0 +1,338 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AsyncEvaluator.h"
+#include "BlockEvaluator.h"
+#include "test_utils.h"
+
+// ------------------------------------------------------------------------------------------------
+/// Одномерная задача, вычисление которой ждет разрешения теста
+class TBlockingProblem : public IGlobalOptimizationProblem
+{
+protected:
+  std::shared_future<void> mRelease;
+
+public:
+  TBlockingProblem(const std::shared_future<void>& release) : mRelease(release)
+  {}
+
+  virtual double CalculateFunctionals(const std::vector<double>& y, std::vector<std::string>& u, int fNumber)
+  {
+    mRelease.wait();
+    return y[0];
+  }
+
+  virtual int SetDimension(int dimension) { return IGlobalOptimizationProblem::PROBLEM_OK; }
+  virtual int GetDimension() const { return 1; }
+  virtual int Initialize() { return IGlobalOptimizationProblem::PROBLEM_OK; }
+  virtual void GetBounds(std::vector<double>& lower, std::vector<double>& upper)
+  {
+    lower.assign(1, 0.0);
+    upper.assign(1, 1.0);
+  }
+  virtual int GetOptimumValue(double& value) const { return IGlobalOptimizationProblem::PROBLEM_UNDEFINED; }
+  virtual int GetOptimumPoint(std::vector<double>& y, std::vector<std::string>& u) const
+  {
+    return IGlobalOptimizationProblem::PROBLEM_UNDEFINED;
+  }
+  virtual int GetNumberOfFunctions() const { return 1; }
+  virtual int GetNumberOfConstraints() const { return 0; }
+  virtual int GetNumberOfCriterions() const { return 1; }
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST(CompletionQueue, test_completion_queue)
+{
+    TCompletionQueue queue(3);
+    ASSERT_EQ(queue.GetCapacity(), 4u);
+
+    std::vector<TAsyncResult> results(5);
+    for (int i = 0; i < 4; i++)
+        ASSERT_TRUE(queue.Push(&results[i]));
+    EXPECT_FALSE(queue.Push(&results[4]));
+
+    TAsyncResult* result = nullptr;
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT_TRUE(queue.Pop(result));
+        EXPECT_EQ(result, &results[i]);
+    }
+    EXPECT_FALSE(queue.Pop(result));
+
+    // несколько потоков добавляют и извлекают элементы одновременно, каждый элемент извлекается один раз
+    const int numThreads = 4;
+    const int numItems = 10000;
+    std::vector<TAsyncResult> items(numThreads * numItems);
+    std::vector<std::atomic<int>> counts(items.size());
+    std::atomic<int> popped(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; t++)
+    {
+        threads.emplace_back([&, t]()
+        {
+            for (int i = 0; i < numItems; i++)
+                while (!queue.Push(&items[t * numItems + i]))
+                    std::this_thread::yield();
+        });
+        threads.emplace_back([&]()
+        {
+            TAsyncResult* item = nullptr;
+            while (popped.load() < (int)items.size())
+            {
+                if (queue.Pop(item))
+                {
+                    counts[item - items.data()]++;
+                    popped++;
+                }
+                else
+                    std::this_thread::yield();
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    for (size_t i = 0; i < counts.size(); i++)
+        ASSERT_EQ(counts[i].load(), 1) << "item " << i;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(AsyncEvaluator, test_async_evaluator_states)
+{
+    const int ok = TAsyncEvaluator::OK_;
+    const int notReady = TAsyncEvaluator::NOT_READY_;
+    const int error = TAsyncEvaluator::ERROR_;
+    std::promise<void> release;
+    TBlockingProblem problem(release.get_future().share());
+    TAsyncEvaluator evaluator(&problem, 2, 4);
+    // задача не поддерживает копирование и параллельные вызовы, поэтому поток один
+    ASSERT_EQ(evaluator.GetNumberOfThreads(), 1);
+
+    TAsyncResult result;
+    EXPECT_EQ(evaluator.Poll(result), notReady);
+    EXPECT_EQ(evaluator.WaitAny(result, 0.01), error);
+
+    double y[4] = { 0.1, 0.2, 0.3, 0.4 };
+    std::vector<long long> tickets;
+    for (int i = 0; i < 4; i++)
+    {
+        tickets.push_back(evaluator.Submit(&y[i], 1, nullptr, 0, 0));
+        ASSERT_GE(tickets.back(), 0);
+    }
+    EXPECT_EQ(evaluator.Submit(&y[0], 1, nullptr, 0, 0), -1);
+    EXPECT_EQ(evaluator.GetNumberOfInFlight(), 4);
+
+    // вычисление заблокировано, поэтому результатов нет
+    EXPECT_EQ(evaluator.Poll(result), notReady);
+    EXPECT_EQ(evaluator.WaitAny(result, 0.01), notReady);
+
+    release.set_value();
+    std::map<long long, double> values;
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT_EQ(evaluator.WaitAny(result, 10.0), ok);
+        EXPECT_EQ(result.status, ok);
+        ASSERT_EQ(result.values.size(), 1u);
+        values[result.ticket] = result.values[0];
+    }
+    for (int i = 0; i < 4; i++)
+        EXPECT_DOUBLE_EQ(values.at(tickets[i]), y[i]);
+
+    EXPECT_EQ(evaluator.GetNumberOfInFlight(), 0);
+    EXPECT_EQ(evaluator.Poll(result), notReady);
+    EXPECT_EQ(evaluator.WaitAny(result, 0.01), error);
+    EXPECT_GE(evaluator.Submit(&y[0], 1, nullptr, 0, 0), 0);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(AsyncEvaluator, test_async_evaluator_competing_waiters)
+{
+    const int ok = TAsyncEvaluator::OK_;
+    const int error = TAsyncEvaluator::ERROR_;
+    std::promise<void> release;
+    TBlockingProblem problem(release.get_future().share());
+    // емкость не степень двойки: очередь результатов больше, но заявок принимается ровно 3
+    TAsyncEvaluator evaluator(&problem, 1, 3);
+
+    double y[3] = { 0.1, 0.2, 0.3 };
+    for (int i = 0; i < 3; i++)
+        ASSERT_GE(evaluator.Submit(&y[i], 1, nullptr, 0, 0), 0);
+    EXPECT_EQ(evaluator.Submit(&y[0], 1, nullptr, 0, 0), -1);
+
+    // ожидающих потоков больше, чем заявок: лишние завершаются, когда другой поток забрал последний результат
+    const int numWaiters = 5;
+    std::vector<int> results(numWaiters);
+    std::vector<std::thread> waiters;
+    for (int t = 0; t < numWaiters; t++)
+        waiters.emplace_back([&, t]()
+        {
+            TAsyncResult result;
+            results[t] = evaluator.WaitAny(result, 10.0);
+        });
+    release.set_value();
+    for (auto& waiter : waiters)
+        waiter.join();
+
+    EXPECT_EQ(std::count(results.begin(), results.end(), ok), 3);
+    EXPECT_EQ(std::count(results.begin(), results.end(), error), numWaiters - 3);
+    EXPECT_EQ(evaluator.GetNumberOfInFlight(), 0);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(AsyncEvaluator, test_async_evaluator_concurrent_submit)
+{
+    const int ok = TAsyncEvaluator::OK_;
+    const int problemOk = IGlobalOptimizationProblem::PROBLEM_OK;
+    const int functionalOk = IGlobalOptimizationProblem::FUNCTIONAL_OK;
+    int dimension = 4;
+    GlobalOptimizationProblemManager manager;
+    IGlobalOptimizationProblem* problem = LoadTestProblem(manager, "rastriginC20", dimension);
+    ASSERT_NE(problem, nullptr);
+    int numberOfFunctions = problem->GetNumberOfFunctions();
+
+    const int numThreads = 4;
+    const int numSubmits = 500;
+    TAsyncEvaluator evaluator(problem, 4, 64);
+
+    // точка и номер функции заявки определяются ее порядковым номером i
+    auto getPoint = [&](int i)
+    {
+        std::vector<double> y(dimension);
+        for (int j = 0; j < dimension; j++)
+            y[j] = 0.01 * ((i * 7 + j * 13) % 100) - 0.5;
+        return y;
+    };
+    auto getFunction = [&](int i) { return i % (numberOfFunctions + 1) - 1; };
+
+    std::mutex mutex;
+    std::map<long long, int> submitted;
+    std::vector<TAsyncResult> received;
+    std::atomic<int> numberOfReceived(0);
+    auto receive = [&](double timeout)
+    {
+        TAsyncResult result;
+        if (evaluator.WaitAny(result, timeout) != ok)
+            return;
+        numberOfReceived++;
+        std::lock_guard<std::mutex> lock(mutex);
+        received.push_back(result);
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; t++)
+    {
+        threads.emplace_back([&, t]()
+        {
+            for (int i = t * numSubmits; i < (t + 1) * numSubmits; i++)
+            {
+                std::vector<double> y = getPoint(i);
+                long long ticket;
+                // при заполненной очереди поток сам забирает результаты
+                while ((ticket = evaluator.Submit(y.data(), dimension, nullptr, 0, getFunction(i))) < 0)
+                    receive(0.01);
+                std::lock_guard<std::mutex> lock(mutex);
+                submitted[ticket] = i;
+            }
+            while (numberOfReceived.load() < numThreads * numSubmits)
+                receive(0.01);
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    ASSERT_EQ(submitted.size(), (size_t)numThreads * numSubmits);
+    ASSERT_EQ(received.size(), submitted.size());
+    std::map<long long, int> counts;
+    for (auto& result : received)
+    {
+        ASSERT_EQ(submitted.count(result.ticket), 1u);
+        ASSERT_EQ(++counts[result.ticket], 1) << "ticket " << result.ticket;
+        ASSERT_EQ(result.status, ok);
+
+        int i = submitted[result.ticket];
+        std::vector<double> y = getPoint(i);
+        int fNumber = getFunction(i);
+        ASSERT_EQ(result.fNumber, fNumber);
+        if (fNumber < 0)
+        {
+            std::vector<double> values(numberOfFunctions);
+            ASSERT_EQ(problem->CalculateAllFunctionals(y.data(), dimension, nullptr, 0, values.data()),
+                problemOk);
+            ASSERT_EQ(result.values.size(), values.size());
+            for (int f = 0; f < numberOfFunctions; f++)
+            {
+                EXPECT_EQ(result.statuses[f], functionalOk);
+                EXPECT_DOUBLE_EQ(result.values[f], values[f]);
+            }
+        }
+        else
+        {
+            ASSERT_EQ(result.values.size(), 1u);
+            EXPECT_EQ(result.statuses[0], functionalOk);
+            EXPECT_DOUBLE_EQ(result.values[0], problem->CalculateFunctionals(y.data(), dimension, nullptr, 0, fNumber));
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(BlockEvaluator, test_block_evaluator_single_variable)
+{
+    const int ok = TBlockEvaluator::OK_;
+    const int problemOk = IGlobalOptimizationProblem::PROBLEM_OK;
+    int dimension = 8;
+    GlobalOptimizationProblemManager manager;
+    IGlobalOptimizationProblem* problem = LoadTestProblem(manager, "rastriginC20", dimension);
+    ASSERT_NE(problem, nullptr);
+    int numberOfFunctions = problem->GetNumberOfFunctions();
+    ASSERT_EQ(numberOfFunctions, 21);
+
+    TBlockEvaluator evaluator(problem);
+    std::vector<double> point(dimension);
+    for (int j = 0; j < dimension; j++)
+        point[j] = 0.3 * j - 1.0;
+    ASSERT_EQ(evaluator.SetPoint(point.data(), dimension), ok);
+    // 18 функций -- суммы слагаемых от одной переменной, ограничение 14 -- сумма по парам соседних
+    // переменных, ограничения 13 и 19 неразделимы
+    EXPECT_EQ(evaluator.GetNumberOfEvaluations(), 18 * dimension + (dimension - 1) + 2);
+
+    std::vector<double> expected(numberOfFunctions);
+    auto checkValues = [&]()
+    {
+        ASSERT_EQ(evaluator.GetPoint(), point);
+        ASSERT_EQ(problem->CalculateAllFunctionals(point.data(), dimension, nullptr, 0, expected.data()), problemOk);
+        for (int f = 0; f < numberOfFunctions; f++)
+            EXPECT_NEAR(evaluator.GetValues()[f], expected[f], 1e-12 * (1.0 + std::fabs(expected[f])))
+                << "function " << f;
+    };
+    checkValues();
+
+    for (int step = 0; step < 3 * dimension; step++)
+    {
+        int variable = (step * 5) % dimension;
+        double value = std::sin(1.0 + step);
+        point[variable] = value;
+        ASSERT_EQ(evaluator.Update(&variable, &value, 1), ok);
+
+        // пересчитываются по одному слагаемому разделимых функций, одно или два слагаемых ограничения 14
+        // и неразделимые ограничения целиком
+        int neighbourBlocks = (variable > 0 ? 1 : 0) + (variable + 1 < dimension ? 1 : 0);
+        EXPECT_EQ(evaluator.GetNumberOfEvaluations(), 18 + neighbourBlocks + 2) << "variable " << variable;
+        checkValues();
+    }
+
+    // изменение двух соседних переменных затрагивает общее слагаемое ограничения 14 один раз
+    int variables[2] = { 2, 3 };
+    double values[2] = { 0.25, -0.75 };
+    point[2] = values[0];
+    point[3] = values[1];
+    ASSERT_EQ(evaluator.Update(variables, values, 2), ok);
+    EXPECT_EQ(evaluator.GetNumberOfEvaluations(), 2 * 18 + 3 + 2);
+    checkValues();
+}
@@ -0,0 +1,802 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "test_utils.h"
+
+// ------------------------------------------------------------------------------------------------
+TEST(Problem_batch, test_batch_stride)
+{
+    const int ok = IGlobalOptimizationProblem::PROBLEM_OK;
+    const int error = IGlobalOptimizationProblem::PROBLEM_ERROR;
+    int dimension = 3;
+    int numPoints = 4;
+    GlobalOptimizationProblemManager manager;
+    IGlobalOptimizationProblem* problem = LoadTestProblem(manager, "rastrigin", dimension);
+    ASSERT_NE(problem, nullptr);
+
+    std::vector<std::vector<double>> points(numPoints, std::vector<double>(dimension));
+    std::vector<double> expected(numPoints);
+    std::vector<std::string> u;
+    for (int i = 0; i < numPoints; i++)
+    {
+        for (int j = 0; j < dimension; j++)
+            points[i][j] = 0.1 * (i + j) - 0.2;
+        expected[i] = problem->CalculateFunctionals(points[i], u, 0);
+    }
+
+    // шаг 0 -- точки записаны подряд, шаг больше размерности -- хвост каждой строки не используется
+    for (int stride : { 0, dimension, dimension + 1, 2 * dimension + 3 })
+    {
+        SCOPED_TRACE(stride);
+        int rowLength = stride == 0 ? dimension : stride;
+        std::vector<double> y((size_t)numPoints * rowLength, 1e300);
+        for (int i = 0; i < numPoints; i++)
+            std::copy(points[i].begin(), points[i].end(), y.begin() + (size_t)i * rowLength);
+
+        std::vector<double> values(numPoints);
+        ASSERT_EQ(problem->CalculateFunctionalsBatch(y.data(), numPoints, stride, 0, values.data()), ok);
+        for (int i = 0; i < numPoints; i++)
+            EXPECT_DOUBLE_EQ(values[i], expected[i]) << "point " << i;
+    }
+
+    std::vector<double> y((size_t)numPoints * dimension);
+    std::vector<double> values(numPoints);
+    EXPECT_EQ(problem->CalculateFunctionalsBatch(y.data(), numPoints, dimension - 1, 0, values.data()), error);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(Problem_discrete_index, test_discrete_index_matches_labels)
+{
+    const int ok = IGlobalOptimizationProblem::PROBLEM_OK;
+    const int error = IGlobalOptimizationProblem::PROBLEM_ERROR;
+    GlobalOptimizationProblemManager manager;
+    IGlobalOptimizationProblem* problem = LoadTestProblem(manager, "rastriginInt", 4);
+    ASSERT_NE(problem, nullptr);
+    ASSERT_EQ(problem->SetNumberOfDiscreteVariable(3), ok);
+    int yCount = problem->GetNumberOfContinuousVariable();
+    int uCount = problem->GetNumberOfDiscreteVariable();
+    ASSERT_EQ(yCount, 1);
+    ASSERT_EQ(uCount, 3);
+
+    std::vector<std::vector<std::string>> labels;
+    ASSERT_EQ(problem->GetDiscreteVariableValues(labels), ok);
+    ASSERT_EQ((int)labels.size(), uCount);
+    int numberOfValues = (int)labels[0].size();
+    ASSERT_GE(numberOfValues, 2);
+
+    // все сочетания значений дискретных параметров
+    std::vector<double> y = { 0.3 };
+    int numberOfCombinations = (int)std::pow(numberOfValues, uCount);
+    for (int combination = 0; combination < numberOfCombinations; combination++)
+    {
+        std::vector<int> indices(uCount);
+        for (int k = 0, rest = combination; k < uCount; k++, rest /= numberOfValues)
+            indices[k] = rest % numberOfValues;
+
+        std::vector<std::string> u;
+        ASSERT_EQ(problem->GetDiscreteValueLabels(indices.data(), uCount, u), ok);
+        ASSERT_EQ((int)u.size(), uCount);
+        for (int k = 0; k < uCount; k++)
+            EXPECT_EQ(u[k], labels[k][indices[k]]);
+        std::vector<int> roundTrip(uCount, -1);
+        ASSERT_EQ(problem->GetDiscreteValueIndices(u.data(), uCount, roundTrip.data()), ok);
+        EXPECT_EQ(roundTrip, indices);
+
+        double expected = problem->CalculateFunctionals(y, u, 0);
+        EXPECT_EQ(problem->CalculateFunctionalsByIndex(y.data(), yCount, indices.data(), uCount, 0), expected)
+            << "combination " << combination;
+        double value = 0.0;
+        ASSERT_EQ(problem->CalculateAllFunctionalsByIndex(y.data(), yCount, indices.data(), uCount, &value), ok);
+        EXPECT_EQ(value, expected);
+    }
+
+    // номер вне таблицы значений и неизвестная метка
+    for (int wrong : { -1, numberOfValues })
+    {
+        std::vector<int> indices(uCount, 0);
+        indices[1] = wrong;
+        double value = 0.0;
+        std::vector<std::string> u;
+        EXPECT_THROW(problem->CalculateFunctionalsByIndex(y.data(), yCount, indices.data(), uCount, 0),
+            std::out_of_range);
+        EXPECT_EQ(problem->CalculateAllFunctionalsByIndex(y.data(), yCount, indices.data(), uCount, &value), error);
+        EXPECT_EQ(problem->GetDiscreteValueLabels(indices.data(), uCount, u), error);
+    }
+    std::vector<std::string> unknown(uCount, labels[0][0]);
+    unknown[2] = "unknown";
+    std::vector<int> indices(uCount);
+    EXPECT_EQ(problem->GetDiscreteValueIndices(unknown.data(), uCount, indices.data()), error);
+}
+
+// ------------------------------------------------------------------------------------------------
+/// Одномерная задача с ограничениями g_k(y) = 0.25 (k + 1) - y, использующая реализации интерфейса по умолчанию
+class TSegmentProblem : public IGlobalOptimizationProblem
+{
+public:
+  virtual double CalculateFunctionals(const std::vector<double>& y, std::vector<std::string>& u, int fNumber)
+  {
+    return fNumber < GetNumberOfConstraints() ? 0.25 * (fNumber + 1) - y[0] : y[0] * y[0];
+  }
+
+  virtual int SetDimension(int dimension) { return IGlobalOptimizationProblem::PROBLEM_OK; }
+  virtual int GetDimension() const { return 1; }
+  virtual int Initialize() { return IGlobalOptimizationProblem::PROBLEM_OK; }
+  virtual void GetBounds(std::vector<double>& lower, std::vector<double>& upper)
+  {
+    lower.assign(1, 0.0);
+    upper.assign(1, 1.0);
+  }
+  virtual int GetOptimumValue(double& value) const { return IGlobalOptimizationProblem::PROBLEM_UNDEFINED; }
+  virtual int GetOptimumPoint(std::vector<double>& y, std::vector<std::string>& u) const
+  {
+    return IGlobalOptimizationProblem::PROBLEM_UNDEFINED;
+  }
+  virtual int GetNumberOfFunctions() const { return 4; }
+  virtual int GetNumberOfConstraints() const { return 3; }
+  virtual int GetNumberOfCriterions() const { return 1; }
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Сравнивает CalculateFunctionalsUpTo с вычислением функций по одной в точке y
+
+Возвращает номер последней вычисленной функции
+*/
+static int CheckFunctionalsUpTo(IGlobalOptimizationProblem* problem, const std::vector<double>& y, int lastIndex)
+{
+  int dimension = (int)y.size();
+  int numberOfConstraints = problem->GetNumberOfConstraints();
+  int expectedIndex = lastIndex;
+  std::vector<double> expected(lastIndex + 1);
+  for (int i = 0; i <= lastIndex; i++)
+  {
+    expected[i] = problem->CalculateFunctionals(y.data(), dimension, nullptr, 0, i);
+    if (i < numberOfConstraints && expected[i] > 0)
+    {
+      expectedIndex = i;
+      break;
+    }
+  }
+
+  const double unchanged = -12345.0;
+  std::vector<double> values(problem->GetNumberOfFunctions(), unchanged);
+  int index = problem->CalculateFunctionalsUpTo(y.data(), dimension, nullptr, 0, lastIndex, values.data());
+  EXPECT_EQ(index, expectedIndex);
+  for (int i = 0; i <= expectedIndex; i++)
+    EXPECT_NEAR(values[i], expected[i], 1e-12 * (1.0 + std::fabs(expected[i]))) << "function " << i;
+  for (int i = expectedIndex + 1; i < (int)values.size(); i++)
+    EXPECT_EQ(values[i], unchanged) << "function " << i;
+  return index;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(Problem_up_to, test_functionals_up_to)
+{
+    struct TCase { std::string name; int dimension; };
+    std::vector<TCase> cases = { { "rastriginC20", 5 }, { "rastriginC1", 50 }, { "rastriginUC", 50 } };
+
+    const int ok = IGlobalOptimizationProblem::PROBLEM_OK;
+    const int error = IGlobalOptimizationProblem::PROBLEM_ERROR;
+    std::mt19937 random(4);
+    GlobalOptimizationProblemManager manager;
+    for (auto& test : cases)
+    {
+        SCOPED_TRACE(test.name);
+        IGlobalOptimizationProblem* problem = LoadTestProblem(manager, test.name, test.dimension);
+        ASSERT_NE(problem, nullptr);
+        int numberOfFunctions = problem->GetNumberOfFunctions();
+        std::vector<double> lower, upper, optimum;
+        std::vector<std::string> u;
+        problem->GetBounds(lower, upper);
+        ASSERT_EQ(problem->GetOptimumPoint(optimum, u), ok);
+
+        // точки от оптимума, где ограничения выполнены, до случайных точек области, где они нарушаются;
+        // rastriginUC не вычисляется рядом с 0.23, такие координаты сдвигаются
+        int numberOfFeasible = 0;
+        int numberOfViolated = 0;
+        for (int i = 0; i < 40; i++)
+        {
+            std::vector<double> y(test.dimension);
+            double scale = i < 10 ? 0.0 : std::pow(10.0, -(i % 4));
+            for (int j = 0; j < test.dimension; j++)
+            {
+                double x = std::uniform_real_distribution<double>(lower[j], upper[j])(random);
+                y[j] = optimum[j] + scale * (x - optimum[j]);
+                if (test.name == "rastriginUC" && std::fabs(y[j] - 0.23) < 0.2)
+                    y[j] = 0.23 + (y[j] < 0.23 ? -0.2 : 0.2);
+            }
+            for (int lastIndex : { numberOfFunctions - 1, numberOfFunctions / 2 })
+            {
+                int index = CheckFunctionalsUpTo(problem, y, lastIndex);
+                if (index == lastIndex && lastIndex == numberOfFunctions - 1)
+                    numberOfFeasible++;
+                if (index < lastIndex)
+                    numberOfViolated++;
+            }
+        }
+        EXPECT_GT(numberOfFeasible, 0);
+        EXPECT_GT(numberOfViolated, 0);
+
+        std::vector<double> values(numberOfFunctions);
+        EXPECT_EQ(problem->CalculateFunctionalsUpTo(optimum.data(), test.dimension, nullptr, 0, numberOfFunctions,
+            values.data()), error);
+        EXPECT_EQ(problem->CalculateFunctionalsUpTo(optimum.data(), test.dimension, nullptr, 0, -1,
+            values.data()), error);
+    }
+
+    // реализация по умолчанию: при y = 0.6 нарушено только третье ограничение
+    TSegmentProblem segment;
+    for (double y : { 0.1, 0.3, 0.6, 0.9 })
+    {
+        SCOPED_TRACE(y);
+        for (int lastIndex = 0; lastIndex < segment.GetNumberOfFunctions(); lastIndex++)
+            CheckFunctionalsUpTo(&segment, { y }, lastIndex);
+    }
+    double values[4];
+    double y = 0.6;
+    EXPECT_EQ(segment.CalculateFunctionalsUpTo(&y, 1, nullptr, 0, 3, values), 2);
+}
+
+// ------------------------------------------------------------------------------------------------
+/// Случайная точка из параллелепипеда [lower, upper]
+static std::vector<double> GetRandomPoint(const std::vector<double>& lower, const std::vector<double>& upper,
+  std::mt19937& random)
+{
+  std::vector<double> point(lower.size());
+  for (size_t j = 0; j < point.size(); j++)
+    point[j] = std::uniform_real_distribution<double>(lower[j], upper[j])(random);
+  return point;
+}
+
+// ------------------------------------------------------------------------------------------------
+/// Сравнивает градиент функции fNumber с центральными разностями в случайных точках области поиска
+static void CheckGradient(IGlobalOptimizationProblem* problem, int fNumber, std::mt19937& random)
+{
+    const int ok = IGlobalOptimizationProblem::PROBLEM_OK;
+    const int numPoints = 16;
+    std::vector<double> lower, upper;
+    problem->GetBounds(lower, upper);
+    int dimension = (int)lower.size();
+
+    std::vector<double> y((size_t)numPoints * (dimension + 1));
+    std::vector<double> expectedValues(numPoints);
+    std::vector<double> expectedGradients((size_t)numPoints * dimension);
+    for (int i = 0; i < numPoints; i++)
+    {
+        std::vector<double> point = GetRandomPoint(lower, upper, random);
+        std::copy(point.begin(), point.end(), y.begin() + (size_t)i * (dimension + 1));
+
+        double value = 0.0;
+        std::vector<double> gradient(dimension);
+        ASSERT_EQ(problem->CalculateFunctionalGradient(point.data(), dimension, fNumber, value, gradient.data()), ok);
+        EXPECT_NEAR(value, problem->CalculateFunctionals(point.data(), dimension, nullptr, 0, fNumber),
+            1e-12 * (1.0 + std::fabs(value)));
+
+        for (int j = 0; j < dimension; j++)
+        {
+            double h = 1e-6 * std::max(1.0, std::fabs(point[j]));
+            std::vector<double> shifted = point;
+            shifted[j] = point[j] + h;
+            double right = problem->CalculateFunctionals(shifted.data(), dimension, nullptr, 0, fNumber);
+            shifted[j] = point[j] - h;
+            double left = problem->CalculateFunctionals(shifted.data(), dimension, nullptr, 0, fNumber);
+            double difference = (right - left) / (2.0 * h);
+            // ошибка разностной формулы -- O(h^2) от третьей производной и O(eps |f| / h) от округления
+            EXPECT_NEAR(gradient[j], difference, 1e-4 * (1.0 + std::fabs(difference)) + 1e-8 * std::fabs(value))
+                << "function " << fNumber << ", coordinate " << j;
+        }
+        expectedValues[i] = value;
+        std::copy(gradient.begin(), gradient.end(), expectedGradients.begin() + (size_t)i * dimension);
+    }
+
+    // пакетное вычисление с точками, записанными с шагом dimension + 1
+    std::vector<double> values(numPoints);
+    std::vector<double> gradients((size_t)numPoints * dimension);
+    ASSERT_EQ(problem->CalculateFunctionalGradientBatch(y.data(), numPoints, dimension + 1, fNumber,
+        values.data(), gradients.data()), ok);
+    for (int i = 0; i < numPoints; i++)
+    {
+        EXPECT_NEAR(values[i], expectedValues[i], 1e-12 * (1.0 + std::fabs(expectedValues[i])));
+        for (int j = 0; j < dimension; j++)
+        {
+            double expected = expectedGradients[(size_t)i * dimension + j];
+            EXPECT_NEAR(gradients[(size_t)i * dimension + j], expected, 1e-12 * (1.0 + std::fabs(expected)));
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(Problem_gradient, test_gradient_central_difference)
+{
+    struct TCase { std::string name; int dimension; };
+    std::vector<TCase> cases = { { "rastrigin", 5 }, { "rastriginC1", 50 }, { "rastriginC20", 5 },
+        { "stronginc3", 2 }, { "X2", 2 } };
+
+    const int ok = IGlobalOptimizationProblem::PROBLEM_OK;
+    std::mt19937 random(2025);
+    GlobalOptimizationProblemManager manager;
+    for (auto& test : cases)
+    {
+        SCOPED_TRACE(test.name);
+        IGlobalOptimizationProblem* problem = LoadTestProblem(manager, test.name, test.dimension);
+        ASSERT_NE(problem, nullptr);
+
+        for (int instance = 0; instance < std::min(problem->GetNumberOfInstances(), 3); instance++)
+        {
+            ASSERT_EQ(problem->SelectInstance(instance), ok);
+            for (int fNumber = 0; fNumber < problem->GetNumberOfFunctions(); fNumber++)
+                CheckGradient(problem, fNumber, random);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(Problem_gradient, test_gradient_unsupported)
+{
+    const int undefined = IGlobalOptimizationProblem::PROBLEM_UNDEFINED;
+    int dimension = 50;
+    GlobalOptimizationProblemManager manager;
+    IGlobalOptimizationProblem* problem = LoadTestProblem(manager, "rastriginUC", dimension);
+    ASSERT_NE(problem, nullptr);
+
+    std::vector<double> y(2 * dimension, 0.5);
+    std::vector<double> values(2);
+    std::vector<double> gradients(2 * dimension);
+    double value = 0.0;
+    EXPECT_EQ(problem->CalculateFunctionalGradient(y.data(), dimension, 0, value, gradients.data()), undefined);
+    EXPECT_EQ(problem->CalculateFunctionalGradientBatch(y.data(), 2, 0, 0, values.data(), gradients.data()),
+        undefined);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(Problem_bounds, test_bounds_enclose_function)
+{
+    struct TCase { std::string name; int dimension; };
+    std::vector<TCase> cases = { { "rastrigin", 4 }, { "rastriginC20", 4 }, { "stronginc3", 2 }, { "X2", 2 } };
+
+    const int ok = IGlobalOptimizationProblem::PROBLEM_OK;
+    const int numBoxes = 20;
+    const int numPoints = 50;
+    std::mt19937 random(7);
+    GlobalOptimizationProblemManager manager;
+    for (auto& test : cases)
+    {
+        SCOPED_TRACE(test.name);
+        IGlobalOptimizationProblem* problem = LoadTestProblem(manager, test.name, test.dimension);
+        ASSERT_NE(problem, nullptr);
+        std::vector<double> lower, upper;
+        problem->GetBounds(lower, upper);
+        if (test.name == "rastriginC20")
+        {
+            ASSERT_EQ(problem->GetNumberOfFunctions(), 21);
+        }
+
+        for (int instance = 0; instance < std::min(problem->GetNumberOfInstances(), 3); instance++)
+        {
+            ASSERT_EQ(problem->SelectInstance(instance), ok);
+            for (int fNumber = 0; fNumber < problem->GetNumberOfFunctions(); fNumber++)
+            {
+                for (int box = 0; box < numBoxes; box++)
+                {
+                    // подобласти от почти точечных до всей области поиска
+                    std::vector<double> a = GetRandomPoint(lower, upper, random);
+                    std::vector<double> b = GetRandomPoint(lower, upper, random);
+                    double scale = box == 0 ? 1.0 : std::pow(10.0, -box % 5);
+                    for (int j = 0; j < test.dimension; j++)
+                    {
+                        b[j] = box == 0 ? upper[j] : a[j] + scale * (b[j] - a[j]);
+                        a[j] = box == 0 ? lower[j] : a[j];
+                        if (a[j] > b[j])
+                            std::swap(a[j], b[j]);
+                    }
+
+                    double fLower = 0.0, fUpper = 0.0;
+                    ASSERT_EQ(problem->CalculateFunctionalBounds(a.data(), b.data(), test.dimension, fNumber,
+                        fLower, fUpper), ok);
+                    ASSERT_LE(fLower, fUpper);
+
+                    for (int i = 0; i < numPoints; i++)
+                    {
+                        // кроме случайных точек проверяются вершины подобласти
+                        std::vector<double> point = GetRandomPoint(a, b, random);
+                        if (i < 4)
+                            for (int j = 0; j < test.dimension; j++)
+                                point[j] = ((i >> (j % 2)) & 1) ? b[j] : a[j];
+                        double value = problem->CalculateFunctionals(point.data(), test.dimension, nullptr, 0,
+                            fNumber);
+                        EXPECT_GE(value, fLower) << "function " << fNumber << ", box " << box;
+                        EXPECT_LE(value, fUpper) << "function " << fNumber << ", box " << box;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(Problem_float_batch, test_float_batch_product_constraint_range)
+{
+    const int ok = IGlobalOptimizationProblem::PROBLEM_OK;
+    const int fNumber = 19;
+    GlobalOptimizationProblemManager manager;
+    for (int dimension : { 50, 100 })
+    {
+        SCOPED_TRACE(dimension);
+        IGlobalOptimizationProblem* problem = LoadTestProblem(manager, "rastriginC20", dimension);
+        ASSERT_NE(problem, nullptr);
+
+        // в угле области произведение (1 + x_j^2) равно 5.84^n и при n > 50 не помещается во float
+        // точки представимы во float, поэтому вычисления в double и float идут в одних и тех же точках
+        std::vector<double> corner(dimension, (double)-2.2f);
+        std::vector<double> inner(dimension, (double)0.9f);
+        for (auto& point : { corner, inner })
+        {
+            std::vector<float> pointFloat(point.begin(), point.end());
+            double value = problem->CalculateFunctionals(point.data(), dimension, nullptr, 0, fNumber);
+            float valueFloat = 0.f;
+            ASSERT_EQ(problem->CalculateFunctionalsBatchFloat(pointFloat.data(), 1, 0, fNumber, &valueFloat), ok);
+            if (std::fabs(value) > std::numeric_limits<float>::max())
+                EXPECT_TRUE(std::isinf(valueFloat));
+            else
+                EXPECT_NEAR(valueFloat, value, 6e-8 * std::fabs(value));
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(Problem_not_computable, test_not_computable_batch)
+{
+    const int ok = IGlobalOptimizationProblem::PROBLEM_OK;
+    const int functionalOk = IGlobalOptimizationProblem::FUNCTIONAL_OK;
+    const int notComputable = IGlobalOptimizationProblem::FUNCTIONAL_NOT_COMPUTABLE;
+    int dimension = 50;
+    int numPoints = 8;
+    GlobalOptimizationProblemManager manager;
+    IGlobalOptimizationProblem* problem = LoadTestProblem(manager, "rastriginUC", dimension);
+    ASSERT_NE(problem, nullptr);
+    int numberOfFunctions = problem->GetNumberOfFunctions();
+
+    // rastriginUC не вычисляется, если хотя бы одна координата ближе 0.15 к 0.23;
+    // нечетные точки вычислимы
+    std::vector<double> y((size_t)numPoints * dimension, 0.7);
+    for (int i = 0; i < numPoints; i += 2)
+        y[(size_t)i * dimension + i] = 0.23 + 0.01 * i;
+
+    std::vector<double> values(numPoints);
+    std::vector<int> statuses(numPoints);
+    for (int fNumber = 0; fNumber < numberOfFunctions; fNumber++)
+    {
+        int result = IGlobalOptimizationProblem::PROBLEM_ERROR;
+        ASSERT_NO_THROW(result = problem->TryCalculateFunctionalsBatch(y.data(), numPoints, 0, fNumber,
+            values.data(), statuses.data()));
+        ASSERT_EQ(result, ok);
+        for (int i = 0; i < numPoints; i++)
+        {
+            if (i % 2 == 0)
+                EXPECT_EQ(statuses[i], notComputable) << "point " << i;
+            else
+            {
+                EXPECT_EQ(statuses[i], functionalOk) << "point " << i;
+                EXPECT_DOUBLE_EQ(values[i], problem->CalculateFunctionals(y.data() + (size_t)i * dimension,
+                    dimension, nullptr, 0, fNumber));
+            }
+        }
+    }
+
+    // пакет только из невычислимых точек
+    for (int i = 1; i < numPoints; i += 2)
+        y[(size_t)i * dimension] = 0.2;
+    int result = IGlobalOptimizationProblem::PROBLEM_ERROR;
+    ASSERT_NO_THROW(result = problem->TryCalculateFunctionalsBatch(y.data(), numPoints, 0, numberOfFunctions - 1,
+        values.data(), statuses.data()));
+    ASSERT_EQ(result, ok);
+    for (int i = 0; i < numPoints; i++)
+        EXPECT_EQ(statuses[i], notComputable) << "point " << i;
+
+    std::vector<double> allValues(numberOfFunctions);
+    std::vector<int> allStatuses(numberOfFunctions);
+    ASSERT_NO_THROW(result = problem->TryCalculateAllFunctionals(y.data(), dimension, nullptr, 0, allValues.data(),
+        allStatuses.data()));
+    ASSERT_EQ(result, ok);
+    for (int f = 0; f < numberOfFunctions; f++)
+        EXPECT_EQ(allStatuses[f], notComputable);
+
+    // начальная точка 0.1 невычислима и заполняет статусы всех функций задачи
+    std::vector<double> start;
+    std::vector<std::string> u;
+    std::vector<double> startValues;
+    ASSERT_NO_THROW(problem->GetStartTrial(start, u, startValues));
+    EXPECT_EQ((int)startValues.size(), numberOfFunctions);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(Problem_incremental, test_incremental_state_sweep)
+{
+    struct TCase { std::string name; int dimension; };
+    std::vector<TCase> cases = { { "rastrigin", 10 }, { "rastriginC1", 50 }, { "rastriginC20", 10 } };
+
+    const int ok = IGlobalOptimizationProblem::PROBLEM_OK;
+    std::mt19937 random(14);
+    GlobalOptimizationProblemManager manager;
+    for (auto& test : cases)
+    {
+        SCOPED_TRACE(test.name);
+        int dimension = test.dimension;
+        IGlobalOptimizationProblem* problem = LoadTestProblem(manager, test.name, dimension);
+        ASSERT_NE(problem, nullptr);
+        int numberOfFunctions = problem->GetNumberOfFunctions();
+        // для rastriginC20 проверяются в том числе ограничение 14 (соседние координаты) и 19 (произведение)
+        if (test.name == "rastriginC20")
+        {
+            ASSERT_EQ(numberOfFunctions, 21);
+        }
+
+        std::vector<double> lower, upper;
+        problem->GetBounds(lower, upper);
+        std::vector<double> point = GetRandomPoint(lower, upper, random);
+        TIncrementalState state;
+        ASSERT_EQ(problem->InitializeIncrementalState(point.data(), dimension, state), ok);
+
+        // несколько периодов полного пересчета сумм, который выполняется через dimension изменений
+        std::vector<double> expected(numberOfFunctions);
+        int numberOfRecomputations = 0;
+        for (int step = 0; step < 5 * dimension + 3; step++)
+        {
+            int coordinate = std::uniform_int_distribution<int>(0, dimension - 1)(random);
+            point[coordinate] = std::uniform_real_distribution<double>(lower[coordinate], upper[coordinate])(random);
+            int previousUpdates = state.numberOfUpdates;
+            ASSERT_EQ(problem->UpdateIncrementalState(state, coordinate, point[coordinate]), ok);
+            if (state.numberOfUpdates <= previousUpdates)
+                numberOfRecomputations++;
+
+            ASSERT_EQ(state.point, point);
+            ASSERT_EQ(problem->CalculateAllFunctionals(point.data(), dimension, nullptr, 0, expected.data()), ok);
+            ASSERT_EQ((int)state.values.size(), numberOfFunctions);
+            for (int f = 0; f < numberOfFunctions; f++)
+                ASSERT_NEAR(state.values[f], expected[f], 1e-10 * (1.0 + std::fabs(expected[f])) + 1e-10 * dimension)
+                    << "function " << f << ", step " << step;
+        }
+        EXPECT_GE(numberOfRecomputations, 5);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(Problem_shared_data, test_shared_coefficients)
+{
+    const int ok = GlobalOptimizationProblemManager::OK_;
+    const int error = GlobalOptimizationProblemManager::ERROR_;
+    const int problemError = IGlobalOptimizationProblem::PROBLEM_ERROR;
+    const int problemUndefined = IGlobalOptimizationProblem::PROBLEM_UNDEFINED;
+    int dimension = 2;
+
+    // коэффициенты a_j, b_j функции sum(a_j x_j + b_j x_j^2) в памяти теста: их изменение видно задачам,
+    // только если задачи читают этот буфер, а не копию
+    auto storage = std::make_shared<std::vector<double>>(std::vector<double>({ 1.0, 2.0, -3.0, 0.5 }));
+    TSharedDataPtr data = TSharedData::Wrap(std::shared_ptr<const void>(storage, storage->data()),
+        TSharedDataShape(TSharedDataShape::ELEMENT_DOUBLE, { 1, 4 }));
+    ASSERT_TRUE(data);
+    double y[2] = { 0.5, -1.5 };
+    auto expected = [&]()
+    {
+        const std::vector<double>& c = *storage;
+        return c[0] * y[0] + c[1] * y[0] * y[0] + c[2] * y[1] + c[3] * y[1] * y[1];
+    };
+
+    GlobalOptimizationProblemManager manager;
+    ASSERT_EQ(manager.SetSharedData("coefficients", data), ok);
+    IGlobalOptimizationProblem* problem = LoadTestProblem(manager, "X2", dimension);
+    ASSERT_NE(problem, nullptr);
+    std::unique_ptr<IGlobalOptimizationProblem> clone(problem->Clone());
+    ASSERT_TRUE(clone);
+    // менеджер, задача и ее копия хранят один и тот же буфер
+    EXPECT_EQ(data.use_count(), 4);
+
+    for (int step = 0; step < 2; step++)
+    {
+        EXPECT_EQ(problem->CalculateFunctionals(y, dimension, nullptr, 0, 0), expected());
+        EXPECT_EQ(clone->CalculateFunctionals(y, dimension, nullptr, 0, 0), expected());
+        (*storage)[1] = -4.0;
+    }
+
+    // данные другого типа, слишком короткие и с неизвестным именем отклоняются, прежние остаются
+    std::vector<float> floats = { 1.f, 2.f, -3.f, 0.5f };
+    TSharedDataPtr floatData = TSharedData::Create(floats.data(), { 1, 4 });
+    TSharedDataPtr shortData = TSharedData::Create(storage->data(), { 3 });
+    EXPECT_EQ(problem->SetSharedData("coefficients", floatData), problemError);
+    EXPECT_EQ(problem->SetSharedData("coefficients", shortData), problemError);
+    EXPECT_EQ(problem->SetSharedData("coefficients", TSharedDataPtr()), problemError);
+    EXPECT_EQ(problem->SetSharedData("unknown", data), problemUndefined);
+    EXPECT_EQ(manager.SetSharedData("coefficients", floatData), error);
+    EXPECT_EQ(problem->CalculateFunctionals(y, dimension, nullptr, 0, 0), expected());
+
+    // задача, получившая короткие данные до инициализации, не инициализируется
+    GlobalOptimizationProblemManager shortManager;
+    ASSERT_EQ(shortManager.SetSharedData("coefficients", shortData), ok);
+    EXPECT_EQ(LoadTestProblem(shortManager, "X2", dimension), nullptr);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(Problem_instances, test_select_instance)
+{
+    const int ok = IGlobalOptimizationProblem::PROBLEM_OK;
+    const int error = IGlobalOptimizationProblem::PROBLEM_ERROR;
+    const int managerOk = GlobalOptimizationProblemManager::OK_;
+    int dimension = 2;
+    std::vector<std::vector<double>> points = { { 0.5, -1.5 }, { -2.0, 1.75 }, { 0.0, 0.25 } };
+
+    GlobalOptimizationProblemManager manager;
+    IGlobalOptimizationProblem* problem = LoadTestProblem(manager, "X2", dimension);
+    ASSERT_NE(problem, nullptr);
+    int numberOfInstances = problem->GetNumberOfInstances();
+    ASSERT_GT(numberOfInstances, 1);
+    EXPECT_EQ(problem->GetSelectedInstance(), 0);
+
+    // выбор в обратном порядке на одном объекте совпадает с выбором на только что созданной задаче
+    std::vector<std::string> u;
+    for (int k = numberOfInstances - 1; k >= 0; k--)
+    {
+        SCOPED_TRACE(k);
+        ASSERT_EQ(problem->SelectInstance(k), ok);
+        EXPECT_EQ(problem->GetSelectedInstance(), k);
+        GlobalOptimizationProblemManager freshManager;
+        IGlobalOptimizationProblem* fresh = LoadTestProblem(freshManager, "X2", dimension);
+        ASSERT_NE(fresh, nullptr);
+        ASSERT_EQ(fresh->SelectInstance(k), ok);
+
+        double value = 0.0, freshValue = 0.0;
+        ASSERT_EQ(problem->GetOptimumValue(value), ok);
+        ASSERT_EQ(fresh->GetOptimumValue(freshValue), ok);
+        EXPECT_EQ(value, freshValue);
+        for (auto& point : points)
+            EXPECT_EQ(problem->CalculateFunctionals(point, u, 0), fresh->CalculateFunctionals(point, u, 0));
+    }
+
+    // неверный номер не меняет текущую задачу
+    ASSERT_EQ(problem->SelectInstance(1), ok);
+    EXPECT_EQ(problem->SelectInstance(-1), error);
+    EXPECT_EQ(problem->SelectInstance(numberOfInstances), error);
+    EXPECT_EQ(problem->GetSelectedInstance(), 1);
+
+    // с общей таблицей коэффициентов задача k -- sum(a_j x_j + b_j x_j^2) со строкой k таблицы;
+    // коэффициенты и координаты -- двоичные дроби, поэтому значения точны при любом порядке операций
+    std::vector<double> coefficients = { 1.0, 2.0, -3.0, 0.5, 0.25, -1.0, 4.0, 0.0, -2.0, 1.5, 0.0, 3.0 };
+    GlobalOptimizationProblemManager sharedManager;
+    ASSERT_EQ(sharedManager.SetSharedData("coefficients", TSharedData::Create(coefficients.data(), { 3, 4 })),
+        managerOk);
+    problem = LoadTestProblem(sharedManager, "X2", dimension);
+    ASSERT_NE(problem, nullptr);
+    ASSERT_EQ(problem->GetNumberOfInstances(), 3);
+    for (int k : { 2, 0, 1 })
+    {
+        ASSERT_EQ(problem->SelectInstance(k), ok);
+        const double* c = coefficients.data() + 4 * k;
+        for (auto& point : points)
+            EXPECT_EQ(problem->CalculateFunctionals(point, u, 0), c[0] * point[0] + c[1] * point[0] * point[0] +
+                c[2] * point[1] + c[3] * point[1] * point[1]) << "instance " << k;
+    }
+    EXPECT_EQ(problem->SelectInstance(3), error);
+
+    // задача без семейства
+    TSegmentProblem segment;
+    EXPECT_EQ(segment.GetNumberOfInstances(), 1);
+    EXPECT_EQ(segment.SelectInstance(0), ok);
+    EXPECT_EQ(segment.SelectInstance(1), error);
+    EXPECT_EQ(segment.SelectInstance(-1), error);
+    EXPECT_EQ(segment.GetSelectedInstance(), 0);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(Problem_instances, test_instances_batch)
+{
+    const int ok = IGlobalOptimizationProblem::PROBLEM_OK;
+    const int error = IGlobalOptimizationProblem::PROBLEM_ERROR;
+    const int managerOk = GlobalOptimizationProblemManager::OK_;
+    int dimension = 3;
+    // больше одного блока точек X2 и не кратно четырем
+    int numPoints = 70;
+    std::mt19937 random(20);
+
+    GlobalOptimizationProblemManager manager;
+    IGlobalOptimizationProblem* problem = LoadTestProblem(manager, "X2", dimension);
+    ASSERT_NE(problem, nullptr);
+    int numberOfInstances = problem->GetNumberOfInstances();
+    ASSERT_GT(numberOfInstances, 3);
+    std::vector<int> instances = { 2, 0, numberOfInstances - 1, 2, 1 };
+    int numInstances = (int)instances.size();
+    ASSERT_EQ(problem->SelectInstance(1), ok);
+
+    std::vector<double> lower, upper;
+    problem->GetBounds(lower, upper);
+    for (int stride : { 0, dimension + 2 })
+    {
+        SCOPED_TRACE(stride);
+        int rowLength = stride == 0 ? dimension : stride;
+        std::vector<double> y((size_t)numPoints * rowLength);
+        std::vector<std::vector<double>> points;
+        for (int i = 0; i < numPoints; i++)
+        {
+            points.push_back(GetRandomPoint(lower, upper, random));
+            std::copy(points[i].begin(), points[i].end(), y.begin() + (size_t)i * rowLength);
+        }
+
+        // собственная реализация X2 и реализация интерфейса по умолчанию против вычисления по одной точке;
+        // собственная может отличаться в последнем знаке из-за объединения умножения и сложения
+        std::vector<double> values((size_t)numInstances * numPoints);
+        std::vector<double> defaultValues(values.size());
+        ASSERT_EQ(problem->CalculateInstancesBatch(instances.data(), numInstances, y.data(), numPoints, stride, 0,
+            values.data()), ok);
+        EXPECT_EQ(problem->GetSelectedInstance(), 1);
+        ASSERT_EQ(problem->IGlobalOptimizationProblem::CalculateInstancesBatch(instances.data(), numInstances,
+            y.data(), numPoints, stride, 0, defaultValues.data()), ok);
+        EXPECT_EQ(problem->GetSelectedInstance(), 1);
+
+        std::vector<std::string> u;
+        for (int m = 0; m < numInstances; m++)
+        {
+            ASSERT_EQ(problem->SelectInstance(instances[m]), ok);
+            for (int i = 0; i < numPoints; i++)
+            {
+                double expected = problem->CalculateFunctionals(points[i], u, 0);
+                double tolerance = 1e-14 * (1.0 + std::fabs(expected));
+                EXPECT_NEAR(values[(size_t)m * numPoints + i], expected, tolerance)
+                    << "instance " << m << ", point " << i;
+                EXPECT_NEAR(defaultValues[(size_t)m * numPoints + i], expected, tolerance)
+                    << "instance " << m << ", point " << i;
+            }
+        }
+        ASSERT_EQ(problem->SelectInstance(1), ok);
+    }
+
+    std::vector<double> y((size_t)numPoints * dimension, 0.5);
+    std::vector<double> values((size_t)numInstances * numPoints);
+    int wrong[2] = { 0, numberOfInstances };
+    EXPECT_EQ(problem->CalculateInstancesBatch(wrong, 2, y.data(), numPoints, 0, 0, values.data()), error);
+    EXPECT_EQ(problem->IGlobalOptimizationProblem::CalculateInstancesBatch(wrong, 2, y.data(), numPoints, 0, 0,
+        values.data()), error);
+    EXPECT_EQ(problem->CalculateInstancesBatch(instances.data(), numInstances, y.data(), numPoints, dimension - 1, 0,
+        values.data()), error);
+    EXPECT_EQ(problem->GetSelectedInstance(), 1);
+
+    // двоичные коэффициенты и координаты: значения точны, и все пути совпадают до бита
+    std::vector<double> coefficients = { 1.0, 2.0, -3.0, 0.5, 0.25, -1.0, 4.0, 0.0, -2.0, 1.5, 0.0, 3.0 };
+    GlobalOptimizationProblemManager sharedManager;
+    ASSERT_EQ(sharedManager.SetSharedData("coefficients", TSharedData::Create(coefficients.data(), { 3, 4 })),
+        managerOk);
+    problem = LoadTestProblem(sharedManager, "X2", 2);
+    ASSERT_NE(problem, nullptr);
+    std::vector<int> sharedInstances = { 2, 0, 1 };
+    y.resize((size_t)numPoints * 2);
+    for (size_t k = 0; k < y.size(); k++)
+        y[k] = 0.25 * (double)((k * 7) % 17) - 2.0;
+    values.resize(3 * (size_t)numPoints);
+    ASSERT_EQ(problem->CalculateInstancesBatch(sharedInstances.data(), 3, y.data(), numPoints, 0, 0, values.data()),
+        ok);
+    for (int m = 0; m < 3; m++)
+    {
+        const double* c = coefficients.data() + 4 * sharedInstances[m];
+        for (int i = 0; i < numPoints; i++)
+        {
+            const double* x = y.data() + 2 * i;
+            EXPECT_EQ(values[(size_t)m * numPoints + i], c[0] * x[0] + c[1] * x[0] * x[0] + c[2] * x[1] +
+                c[3] * x[1] * x[1]) << "instance " << m << ", point " << i;
+        }
+    }
+
+    // задача без семейства вычисляет по умолчанию единственную задачу
+    TSegmentProblem segment;
+    double segmentY[3] = { 0.1, 0.6, 0.9 };
+    double segmentValues[6];
+    int segmentInstances[2] = { 0, 0 };
+    ASSERT_EQ(segment.CalculateInstancesBatch(segmentInstances, 2, segmentY, 3, 0, 1, segmentValues), ok);
+    for (int m = 0; m < 2; m++)
+        for (int i = 0; i < 3; i++)
+            EXPECT_EQ(segmentValues[m * 3 + i], 0.5 - segmentY[i]);
+    segmentInstances[1] = 1;
+    EXPECT_EQ(segment.CalculateInstancesBatch(segmentInstances, 2, segmentY, 3, 0, 1, segmentValues), error);
+}
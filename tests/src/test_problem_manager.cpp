@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "test_utils.h"
+
+// ------------------------------------------------------------------------------------------------
+TEST(ProblemManager, test_kernel_table)
+{
+    const int ok = GlobalOptimizationProblemManager::OK_;
+    const int error = GlobalOptimizationProblemManager::ERROR_;
+    const int problemOk = IGlobalOptimizationProblem::PROBLEM_OK;
+    const int kernelOk = PROBLEM_KERNEL_OK;
+    const int kernelError = PROBLEM_KERNEL_ERROR;
+    struct TCase { std::string name; int dimension; bool hasKernelTable; };
+    std::vector<TCase> cases = { { "rastrigin", 3, true }, { "X2", 2, true }, { "rastriginC20", 4, true },
+        { "rastriginC1", 50, true }, { "stronginc3", 2, true }, { "rastriginUC", 50, false } };
+
+    const int numPoints = 5;
+    for (auto& test : cases)
+    {
+        SCOPED_TRACE(test.name);
+        GlobalOptimizationProblemManager manager;
+        IGlobalOptimizationProblem* problem = LoadTestProblem(manager, test.name, test.dimension);
+        ASSERT_NE(problem, nullptr);
+        int dimension = test.dimension;
+        int numberOfFunctions = problem->GetNumberOfFunctions();
+
+        // без таблицы менеджер вычисляет задачу через виртуальные методы
+        const TProblemKernelTable* table = manager.GetKernelTable();
+        ASSERT_EQ(table != nullptr, test.hasKernelTable);
+        if (table)
+        {
+            EXPECT_EQ(table->version, 1);
+            EXPECT_TRUE(table->calculateFunction && table->calculateBatch && table->calculateAllFunctions);
+        }
+
+        // точки вдали от 0.23, где rastriginUC не вычисляется
+        std::vector<double> lower, upper;
+        problem->GetBounds(lower, upper);
+        std::vector<double> y((size_t)numPoints * dimension);
+        for (int i = 0; i < numPoints; i++)
+            for (int j = 0; j < dimension; j++)
+                y[(size_t)i * dimension + j] = lower[j] + (upper[j] - lower[j]) * 0.05 * ((i + j) % 5 + 1);
+
+        std::vector<double> expected(numberOfFunctions);
+        std::vector<double> values(numberOfFunctions);
+        for (int i = 0; i < numPoints; i++)
+        {
+            const double* point = y.data() + (size_t)i * dimension;
+            ASSERT_EQ(problem->CalculateAllFunctionals(point, dimension, nullptr, 0, expected.data()),
+                problemOk);
+            ASSERT_EQ(manager.CalculateAllFunctionals(point, dimension, values.data()), ok);
+            EXPECT_EQ(values, expected);
+            if (table)
+            {
+                ASSERT_EQ(table->calculateAllFunctions(table->state, point, dimension, values.data()), kernelOk);
+                EXPECT_EQ(values, expected);
+            }
+            for (int f = 0; f < numberOfFunctions; f++)
+            {
+                double value = 0.0;
+                ASSERT_EQ(manager.CalculateFunction(point, dimension, f, value), ok);
+                EXPECT_EQ(value, problem->CalculateFunctionals(point, dimension, nullptr, 0, f));
+                if (table)
+                {
+                    ASSERT_EQ(table->calculateFunction(table->state, point, dimension, f, &value), kernelOk);
+                    EXPECT_EQ(value, expected[f]) << "function " << f;
+                }
+            }
+        }
+
+        std::vector<double> batch(numPoints);
+        std::vector<double> expectedBatch(numPoints);
+        for (int f = 0; f < numberOfFunctions; f++)
+        {
+            ASSERT_EQ(problem->CalculateFunctionalsBatch(y.data(), numPoints, 0, f, expectedBatch.data()),
+                problemOk);
+            ASSERT_EQ(manager.CalculateFunctionalsBatch(y.data(), numPoints, 0, f, batch.data()), ok);
+            EXPECT_EQ(batch, expectedBatch) << "function " << f;
+        }
+
+        // координат меньше размерности
+        double value = 0.0;
+        EXPECT_EQ(manager.CalculateFunction(y.data(), dimension - 1, 0, value), error);
+        EXPECT_EQ(manager.CalculateAllFunctionals(y.data(), dimension - 1, values.data()), error);
+        EXPECT_EQ(manager.CalculateFunctionalsBatch(y.data(), numPoints, dimension - 1, 0, batch.data()), error);
+        if (table)
+        {
+            EXPECT_EQ(table->calculateFunction(table->state, y.data(), dimension - 1, 0, &value), kernelError);
+            EXPECT_EQ(table->calculateAllFunctions(table->state, y.data(), dimension - 1, values.data()),
+                kernelError);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+/// Библиотеки задач без встроенного интерпретатора
+static std::vector<std::string> GetNativeLibraryPaths()
+{
+  std::vector<std::string> libPaths;
+  for (const char* name : { "rastrigin", "rastriginC1", "rastriginC20", "rastriginInt", "rastriginUC",
+    "stronginc3", "X2" })
+    libPaths.push_back(GetProblemLibraryPath(name));
+  return libPaths;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(ProblemManager, test_preload_native_problems)
+{
+    const int ok = GlobalOptimizationProblemManager::OK_;
+    const int error = GlobalOptimizationProblemManager::ERROR_;
+    std::vector<std::string> libPaths = GetNativeLibraryPaths();
+    std::string missingPath = GetProblemLibraryPath("nonexistent");
+    std::vector<std::string> allPaths = libPaths;
+    allPaths.push_back(missingPath);
+
+    GlobalOptimizationProblemManager manager;
+    EXPECT_EQ(manager.Preload(allPaths, TProblemSetup(), 4), error);
+    EXPECT_EQ(manager.WaitPreload(), error);
+
+    std::vector<TPreloadTiming> timings = manager.GetPreloadTimings();
+    ASSERT_EQ(timings.size(), allPaths.size());
+    for (size_t i = 0; i < allPaths.size(); i++)
+    {
+        const TPreloadTiming& timing = timings[i];
+        EXPECT_EQ(timing.libPath, allPaths[i]);
+        EXPECT_FALSE(timing.isBackground) << timing.libPath;
+        EXPECT_GE(timing.loadTime, 0.0);
+        if (timing.libPath == missingPath)
+        {
+            // библиотека не загрузилась, до создания и инициализации дело не дошло
+            EXPECT_EQ(timing.status, error);
+            EXPECT_EQ(timing.createTime, 0.0);
+            EXPECT_EQ(timing.initializeTime, 0.0);
+            EXPECT_FALSE(manager.GetPreloadedProblem(missingPath));
+            continue;
+        }
+        EXPECT_EQ(timing.status, ok) << timing.libPath;
+        EXPECT_GE(timing.createTime, 0.0);
+        EXPECT_GE(timing.initializeTime, 0.0);
+
+        // задача уже инициализирована и совпадает с той, что возвращается без ожидания
+        TProblemPtr problem = manager.GetPreloadedProblem(timing.libPath);
+        ASSERT_TRUE(problem) << timing.libPath;
+        EXPECT_EQ(manager.GetPreloadedProblem(timing.libPath, false), problem);
+        EXPECT_GT(problem->GetNumberOfFunctions(), 0);
+        EXPECT_TRUE(manager.FindLibrary(timing.libPath));
+    }
+    EXPECT_FALSE(manager.GetPreloadedProblem(GetProblemLibraryPath("notPreloaded")));
+
+    // повторная загрузка заменяет результаты тех же путей, а не добавляет новые
+    EXPECT_EQ(manager.Preload(libPaths, [](IGlobalOptimizationProblem* problem)
+    {
+        return problem->Initialize();
+    }, 1), ok);
+    timings = manager.GetPreloadTimings();
+    ASSERT_EQ(timings.size(), allPaths.size());
+    EXPECT_EQ(timings[0].libPath, missingPath);
+    EXPECT_EQ(timings[0].status, error);
+    EXPECT_EQ(manager.WaitPreload(), error);
+
+    // ошибка функции настройки -- ошибка загрузки, задача не сохраняется
+    GlobalOptimizationProblemManager failedManager;
+    EXPECT_EQ(failedManager.Preload(libPaths, [](IGlobalOptimizationProblem* problem)
+    {
+        return IGlobalOptimizationProblem::PROBLEM_ERROR;
+    }), error);
+    for (auto& timing : failedManager.GetPreloadTimings())
+    {
+        EXPECT_EQ(timing.status, error);
+        EXPECT_FALSE(failedManager.GetPreloadedProblem(timing.libPath));
+    }
+}
@@ -0,0 +1,246 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ProblemRegistry.h"
+#include "StaticProblemRegistry.h"
+#include "test_utils.h"
+
+// ------------------------------------------------------------------------------------------------
+/// Функция настройки задачи: размерность dimension и инициализация
+static TProblemSetup MakeSetup(int dimension)
+{
+  return [dimension](IGlobalOptimizationProblem* problem)
+  {
+    int result = problem->SetDimension(dimension);
+    return result == IGlobalOptimizationProblem::PROBLEM_OK ? problem->Initialize() : result;
+  };
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Заменяет файл target копией библиотеки source, как это делает пересборка
+
+Файл удаляется, а не перезаписывается: загруженная версия отображена в память и должна остаться
+прежней. Время изменения сдвигается, чтобы замена была видна при грубом разрешении времени файлов
+*/
+static bool ReplaceLibrary(const std::filesystem::path& source, const std::filesystem::path& target)
+{
+  std::error_code error;
+  auto time = std::filesystem::last_write_time(target, error);
+  if (error || !std::filesystem::remove(target, error) || !std::filesystem::copy_file(source, target, error))
+    return false;
+  std::filesystem::last_write_time(target, time + std::chrono::seconds(2), error);
+  return !error;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(ProblemRegistry, test_register_create_find_remove)
+{
+    const int ok = TProblemRegistry::OK_;
+    const int error = TProblemRegistry::ERROR_;
+    TProblemRegistry registry;
+    std::string libPath = GetProblemLibraryPath("rastrigin");
+
+    TProblemRegistry::THandle created = registry.Create("created", libPath, MakeSetup(3));
+    ASSERT_NE(created, 0);
+    TProblemPtr createdProblem = registry.Find("created");
+    ASSERT_TRUE(createdProblem);
+    EXPECT_EQ(createdProblem->GetDimension(), 3);
+    EXPECT_EQ(registry.Get(created), createdProblem);
+    EXPECT_EQ(registry.GetHandle("created"), created);
+
+    // имя занято -- 0 и для Create, и для Register, прежняя задача не меняется
+    EXPECT_EQ(registry.Create("created", libPath, MakeSetup(4)), 0);
+    EXPECT_EQ(registry.Register("created", createdProblem), 0);
+    EXPECT_EQ(registry.Find("created"), createdProblem);
+
+    TProblemPtr problem = registry.GetManager().CreateProblem(libPath);
+    ASSERT_TRUE(problem);
+    TProblemRegistry::THandle registered = registry.Register("registered", problem);
+    ASSERT_NE(registered, 0);
+    EXPECT_NE(registered, created);
+    EXPECT_EQ(registry.Find("registered"), problem);
+    EXPECT_EQ(registry.Register("empty", TProblemPtr()), 0);
+    EXPECT_EQ(registry.Create("missing", GetProblemLibraryPath("nonexistent")), 0);
+    EXPECT_EQ(registry.Create("badDimension", GetProblemLibraryPath("rastriginC1"), MakeSetup(3)), 0);
+
+    std::vector<std::string> names = registry.GetNames();
+    std::sort(names.begin(), names.end());
+    EXPECT_EQ(names, std::vector<std::string>({ "created", "registered" }));
+    EXPECT_EQ(registry.GetNumberOfProblems(), 2);
+    EXPECT_FALSE(registry.Find("missing"));
+    EXPECT_FALSE(registry.Get(0));
+    EXPECT_EQ(registry.GetHandle("missing"), 0);
+
+    EXPECT_EQ(registry.Remove("created"), ok);
+    EXPECT_EQ(registry.Remove("created"), error);
+    EXPECT_EQ(registry.Remove(registered), ok);
+    EXPECT_EQ(registry.Remove(registered), error);
+    EXPECT_FALSE(registry.Find("created"));
+    EXPECT_FALSE(registry.Get(registered));
+    EXPECT_EQ(registry.GetNumberOfProblems(), 0);
+
+    // освободившееся имя можно занять снова, номер при этом новый
+    TProblemRegistry::THandle recreated = registry.Create("created", libPath, MakeSetup(3));
+    ASSERT_NE(recreated, 0);
+    EXPECT_NE(recreated, created);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(ProblemRegistry, test_removed_problem_stays_alive)
+{
+    const int ok = TProblemRegistry::OK_;
+    TProblemRegistry registry;
+    ASSERT_NE(registry.Create("rastrigin", GetProblemLibraryPath("rastrigin"), MakeSetup(2)), 0);
+
+    TProblemPtr problem = registry.Find("rastrigin");
+    ASSERT_TRUE(problem);
+    std::weak_ptr<IGlobalOptimizationProblem> weak = problem;
+    double y[2] = { 0.5, -0.25 };
+    double expected = problem->CalculateFunctionals(y, 2, nullptr, 0, 0);
+
+    ASSERT_EQ(registry.Remove("rastrigin"), ok);
+    EXPECT_FALSE(registry.Find("rastrigin"));
+    EXPECT_FALSE(weak.expired());
+    EXPECT_DOUBLE_EQ(problem->CalculateFunctionals(y, 2, nullptr, 0, 0), expected);
+
+    problem.reset();
+    EXPECT_TRUE(weak.expired());
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(ProblemRegistry, test_concurrent_create_find)
+{
+    const int numThreads = 4;
+    const int numProblems = 8;
+    const int numFinds = 2000;
+    TProblemRegistry registry;
+    std::string libPath = GetProblemLibraryPath("rastrigin");
+    ASSERT_NE(registry.Create("shared", libPath, MakeSetup(2)), 0);
+    TProblemPtr shared = registry.Find("shared");
+
+    // каждый поток создает свои задачи и ищет чужие; одно общее имя пытаются занять все потоки
+    std::atomic<int> numberOfCommon(0);
+    std::atomic<int> numberOfErrors(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; t++)
+    {
+        threads.emplace_back([&, t]()
+        {
+            if (registry.Create("common", libPath, MakeSetup(2)) != 0)
+                numberOfCommon++;
+            for (int i = 0; i < numProblems; i++)
+            {
+                std::string name = "problem" + std::to_string(t) + "_" + std::to_string(i);
+                TProblemRegistry::THandle handle = registry.Create(name, libPath, MakeSetup(2 + i % 3));
+                if (handle == 0 || registry.Get(handle) != registry.Find(name) ||
+                  registry.Find(name)->GetDimension() != 2 + i % 3)
+                    numberOfErrors++;
+            }
+            for (int i = 0; i < numFinds; i++)
+            {
+                if (registry.Find("shared") != shared)
+                    numberOfErrors++;
+                std::string name = "problem" + std::to_string((t + i) % numThreads) + "_" +
+                    std::to_string(i % numProblems);
+                TProblemPtr problem = registry.Find(name);
+                if (problem && problem->GetDimension() != 2 + i % numProblems % 3)
+                    numberOfErrors++;
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(numberOfErrors.load(), 0);
+    EXPECT_EQ(numberOfCommon.load(), 1);
+    EXPECT_EQ(registry.GetNumberOfProblems(), 2 + numThreads * numProblems);
+    std::vector<TProblemRegistry::THandle> handles;
+    for (auto& name : registry.GetNames())
+        handles.push_back(registry.GetHandle(name));
+    std::sort(handles.begin(), handles.end());
+    EXPECT_TRUE(std::adjacent_find(handles.begin(), handles.end()) == handles.end());
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(ProblemRegistry, test_hot_reload)
+{
+    namespace fs = std::filesystem;
+    const int ok = TProblemRegistry::OK_;
+    const int notModified = TProblemRegistry::NOT_MODIFIED_;
+    // перезагружаются только файлы библиотек; статически скомпонованные задачи не перезагружаются
+    for (const char* name : { "rastrigin", "rastriginC20" })
+    {
+        if (TStaticProblemRegistry::Find(name) || !fs::exists(GetProblemLibraryPath(name)))
+            GTEST_SKIP() << name << " is not built as a shared library";
+    }
+    fs::path directory = fs::temp_directory_path() / ("globalizer_reload_" +
+        std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    ASSERT_TRUE(fs::create_directories(directory));
+    fs::path libPath = directory / fs::path(GetProblemLibraryPath("reloaded")).filename();
+    ASSERT_TRUE(fs::copy_file(GetProblemLibraryPath("rastrigin"), libPath));
+
+    double y[2] = { 0.5, -0.25 };
+    std::string copyPath;
+    {
+        TProblemRegistry registry;
+        TProblemRegistry::THandle handle = registry.Create("reloaded", libPath.string(), MakeSetup(2));
+        ASSERT_NE(handle, 0);
+        TProblemPtr old = registry.Find("reloaded");
+        ASSERT_TRUE(old);
+        ASSERT_EQ(old->GetNumberOfFunctions(), 1);
+        double oldValue = old->CalculateFunctionals(y, 2, nullptr, 0, 0);
+        EXPECT_EQ(registry.Reload("reloaded"), notModified);
+        EXPECT_EQ(registry.ReloadModified(), 0);
+
+        // библиотека пересобрана как другая задача: под тем же именем и номером теперь rastriginC20
+        ASSERT_TRUE(ReplaceLibrary(GetProblemLibraryPath("rastriginC20"), libPath));
+        EXPECT_EQ(registry.ReloadModified(), 1);
+        TProblemPtr reloaded = registry.Find("reloaded");
+        ASSERT_TRUE(reloaded);
+        EXPECT_NE(reloaded, old);
+        EXPECT_EQ(registry.GetHandle("reloaded"), handle);
+        EXPECT_EQ(registry.Get(handle), reloaded);
+        EXPECT_EQ(reloaded->GetDimension(), 2);
+        EXPECT_EQ(reloaded->GetNumberOfFunctions(), 21);
+
+        // начатое вычисление продолжается на старой версии, поэтому ее нельзя выгрузить
+        EXPECT_EQ(old->GetNumberOfFunctions(), 1);
+        EXPECT_DOUBLE_EQ(old->CalculateFunctionals(y, 2, nullptr, 0, 0), oldValue);
+        EXPECT_FALSE(registry.WaitForDrain("reloaded", 0.05));
+        old.reset();
+        EXPECT_TRUE(registry.WaitForDrain("reloaded", 10.0));
+
+        // новая версия загружена из временной копии, которая удаляется вместе с этой версией
+        std::shared_ptr<const TProblemLibrary> library = registry.GetManager().FindLibrary(libPath.string());
+        ASSERT_TRUE(library);
+        copyPath = library->GetCopyPath();
+        library.reset();
+        ASSERT_FALSE(copyPath.empty());
+        EXPECT_TRUE(fs::exists(copyPath));
+
+        ASSERT_TRUE(ReplaceLibrary(GetProblemLibraryPath("rastrigin"), libPath));
+        EXPECT_EQ(registry.ReloadModified(), 1);
+        EXPECT_EQ(registry.Find("reloaded")->GetNumberOfFunctions(), 1);
+        EXPECT_DOUBLE_EQ(registry.Find("reloaded")->CalculateFunctionals(y, 2, nullptr, 0, 0), oldValue);
+        EXPECT_FALSE(registry.WaitForDrain("reloaded", 0.05));
+        EXPECT_TRUE(fs::exists(copyPath));
+        reloaded.reset();
+        EXPECT_TRUE(registry.WaitForDrain("reloaded", 10.0));
+        EXPECT_FALSE(fs::exists(copyPath));
+
+        copyPath = registry.GetManager().FindLibrary(libPath.string())->GetCopyPath();
+        EXPECT_TRUE(fs::exists(copyPath));
+        EXPECT_EQ(registry.Remove(handle), ok);
+    }
+    // последняя копия удаляется вместе с реестром
+    EXPECT_FALSE(fs::exists(copyPath));
+    std::error_code error;
+    fs::remove_all(directory, error);
+}
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "test_utils.h"
+
+// ------------------------------------------------------------------------------------------------
+/// Задает задаче iOptProblem скрипт из tests/data/python
+static void SetPythonScript(IGlobalOptimizationProblem* problem)
+{
+  problem->SetConfigPath(std::string(TESTDATA_PATH) + "/python");
+  problem->SetParameter("functionScriptName", std::string("pruning_objective"));
+  problem->SetParameter("functionClassName", std::string("PruningObjective"));
+}
+
+// ------------------------------------------------------------------------------------------------
+/// Загружает в manager задачу iOptProblem со скриптом из tests/data/python; без Python библиотека не собирается
+static IGlobalOptimizationProblem* LoadPythonProblem(GlobalOptimizationProblemManager& manager)
+{
+  std::string libPath = GetProblemLibraryPath("iOptProblem");
+  if (!std::ifstream(libPath).good() ||
+    manager.LoadProblemLibrary(libPath) != GlobalOptimizationProblemManager::OK_)
+    return nullptr;
+  IGlobalOptimizationProblem* problem = manager.GetProblem();
+  SetPythonScript(problem);
+  return problem;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(PythonProblem, test_pruning_only_with_statuses)
+{
+    const int ok = IGlobalOptimizationProblem::PROBLEM_OK;
+    const int functionalOk = IGlobalOptimizationProblem::FUNCTIONAL_OK;
+    const int functionalPruned = IGlobalOptimizationProblem::FUNCTIONAL_PRUNED;
+    GlobalOptimizationProblemManager manager;
+    IGlobalOptimizationProblem* problem = LoadPythonProblem(manager);
+    if (!problem)
+        GTEST_SKIP() << "iOptProblem is not built";
+
+    // скрипт суммирует координату за 10 шагов, функция прерывает вычисление на третьем шаге
+    std::atomic<int> numberOfReports(0);
+    ASSERT_EQ(problem->SetPruningCallback([&](int step, double value)
+    {
+        numberOfReports++;
+        return step >= 2;
+    }), ok);
+    ASSERT_EQ(problem->Initialize(), ok);
+    ASSERT_EQ(problem->GetNumberOfFunctions(), 1);
+
+    double y = 0.5;
+    double value = 0;
+    int status = -1;
+    ASSERT_EQ(problem->TryCalculateAllFunctionals(&y, 1, nullptr, 0, &value, &status), ok);
+    EXPECT_EQ(status, functionalPruned);
+    EXPECT_DOUBLE_EQ(value, 1.5);
+    EXPECT_EQ(numberOfReports.load(), 3);
+
+    // без статусов о прерывании не сообщить, поэтому значение вычисляется полностью
+    numberOfReports = 0;
+    value = 0;
+    ASSERT_EQ(problem->CalculateAllFunctionals(&y, 1, nullptr, 0, &value), ok);
+    EXPECT_DOUBLE_EQ(value, 5.0);
+    EXPECT_DOUBLE_EQ(problem->CalculateFunctionals(&y, 1, nullptr, 0, 0), 5.0);
+    EXPECT_EQ(numberOfReports.load(), 0);
+
+    ASSERT_EQ(problem->TryCalculateFunctionals(&y, 1, nullptr, 0, 0, value), functionalPruned);
+    EXPECT_DOUBLE_EQ(value, 1.5);
+
+    // копия получает ту же функцию прерывания
+    std::unique_ptr<IGlobalOptimizationProblem> clone(problem->Clone());
+    ASSERT_TRUE(clone);
+    numberOfReports = 0;
+    status = -1;
+    ASSERT_EQ(clone->TryCalculateAllFunctionals(&y, 1, nullptr, 0, &value, &status), ok);
+    EXPECT_EQ(status, functionalPruned);
+    EXPECT_EQ(numberOfReports.load(), 3);
+
+    // пустая функция отключает прерывание
+    ASSERT_EQ(problem->SetPruningCallback(TPruningCallback()), ok);
+    ASSERT_EQ(problem->TryCalculateAllFunctionals(&y, 1, nullptr, 0, &value, &status), ok);
+    EXPECT_EQ(status, functionalOk);
+    EXPECT_DOUBLE_EQ(value, 5.0);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(PythonProblem, test_shared_data_without_copies)
+{
+    const int ok = IGlobalOptimizationProblem::PROBLEM_OK;
+    const int undefined = IGlobalOptimizationProblem::PROBLEM_UNDEFINED;
+    const int managerOk = GlobalOptimizationProblemManager::OK_;
+
+    // скрипт читает буфер теста: изменение буфера видно задаче и ее копии, только если он не копируется
+    auto storage = std::make_shared<std::vector<double>>(std::vector<double>({ 1.0, 2.0, 3.0 }));
+    TSharedDataPtr data = TSharedData::Wrap(std::shared_ptr<const void>(storage, storage->data()),
+        TSharedDataShape(TSharedDataShape::ELEMENT_DOUBLE, { 3 }));
+    ASSERT_TRUE(data);
+    GlobalOptimizationProblemManager manager;
+    ASSERT_EQ(manager.SetSharedData("coefficients", data), managerOk);
+    IGlobalOptimizationProblem* problem = LoadPythonProblem(manager);
+    if (!problem)
+        GTEST_SKIP() << "iOptProblem is not built";
+    problem->SetParameter("functionScriptName", std::string("shared_objective"));
+    problem->SetParameter("functionClassName", std::string("SharedObjective"));
+    ASSERT_EQ(problem->Initialize(), ok);
+    std::unique_ptr<IGlobalOptimizationProblem> clone(problem->Clone());
+    ASSERT_TRUE(clone);
+
+    double y = 0.5;
+    EXPECT_DOUBLE_EQ(problem->CalculateFunctionals(&y, 1, nullptr, 0, 0), 3.0);
+    EXPECT_DOUBLE_EQ(clone->CalculateFunctionals(&y, 1, nullptr, 0, 0), 3.0);
+    (*storage)[2] = 7.0;
+    EXPECT_DOUBLE_EQ(problem->CalculateFunctionals(&y, 1, nullptr, 0, 0), 5.0);
+    EXPECT_DOUBLE_EQ(clone->CalculateFunctionals(&y, 1, nullptr, 0, 0), 5.0);
+
+    // скрипт отклоняет данные другого типа и слишком короткие, прежние данные остаются и у новых копий
+    std::vector<float> floats = { 1.f, 2.f, 3.f };
+    EXPECT_EQ(problem->SetSharedData("coefficients", TSharedData::Create(floats.data(), { 3 })), undefined);
+    EXPECT_EQ(problem->SetSharedData("coefficients", TSharedData::Create(storage->data(), { 1 })), undefined);
+    EXPECT_DOUBLE_EQ(problem->CalculateFunctionals(&y, 1, nullptr, 0, 0), 5.0);
+    clone.reset(problem->Clone());
+    ASSERT_TRUE(clone);
+    EXPECT_DOUBLE_EQ(clone->CalculateFunctionals(&y, 1, nullptr, 0, 0), 5.0);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST(PythonProblem, test_concurrent_background_preload)
+{
+    const int ok = GlobalOptimizationProblemManager::OK_;
+    const int notReady = GlobalOptimizationProblemManager::NOT_READY_;
+    GlobalOptimizationProblemManager manager;
+    if (!LoadPythonProblem(manager))
+        GTEST_SKIP() << "iOptProblem is not built";
+
+    // задача с интерпретатором инициализируется в фоне; каждый вызов Preload запускает свой фоновый поток
+    std::string libPath = GetProblemLibraryPath("iOptProblem");
+    auto setup = [](IGlobalOptimizationProblem* problem)
+    {
+        SetPythonScript(problem);
+        return problem->Initialize();
+    };
+    const int numThreads = 4;
+    std::vector<int> results(numThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; t++)
+        threads.emplace_back([&, t]() { results[t] = manager.Preload({ libPath }, setup); });
+    for (auto& thread : threads)
+        thread.join();
+    for (int t = 0; t < numThreads; t++)
+        EXPECT_EQ(results[t], ok);
+
+    EXPECT_EQ(manager.WaitPreload(), ok);
+    std::vector<TPreloadTiming> timings = manager.GetPreloadTimings();
+    ASSERT_EQ(timings.size(), 1u);
+    EXPECT_TRUE(timings[0].isBackground);
+    EXPECT_NE(timings[0].status, notReady);
+    TProblemPtr problem = manager.GetPreloadedProblem(libPath);
+    ASSERT_TRUE(problem);
+    double y = 0.5;
+    EXPECT_DOUBLE_EQ(problem->CalculateFunctionals(&y, 1, nullptr, 0, 0), 5.0);
+}
@@ -0,0 +1,33 @@
+#ifndef __TEST_UTILS_H__
+#define __TEST_UTILS_H__
+
+#include <string>
+
+#include "GlobalOptimizationProblemManager.h"
+#include "test_config.h"
+
+// ------------------------------------------------------------------------------------------------
+/// Путь к собранной библиотеке задачи по имени цели сборки (rastrigin, stronginc3, ...)
+inline std::string GetProblemLibraryPath(const std::string& name)
+{
+  return std::string(TESTDATA_BIN_PATH) + LIB_PREFIX + name + LIB_SUFFIX;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Загружает в manager задачу из библиотеки, задает размерность и инициализирует ее
+
+Задачей владеет manager, при ошибке возвращается nullptr
+*/
+inline IGlobalOptimizationProblem* LoadTestProblem(GlobalOptimizationProblemManager& manager,
+  const std::string& name, int dimension)
+{
+  if (manager.LoadProblemLibrary(GetProblemLibraryPath(name)) != GlobalOptimizationProblemManager::OK_)
+    return nullptr;
+  IGlobalOptimizationProblem* problem = manager.GetProblem();
+  int ok = IGlobalOptimizationProblem::PROBLEM_OK;
+  if (problem->SetDimension(dimension) != ok || problem->Initialize() != ok)
+    return nullptr;
+  return problem;
+}
+
+#endif